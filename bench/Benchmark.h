@@ -126,6 +126,12 @@ public:
 
     virtual void getGpuStats(SkCanvas*, SkTArray<SkString>* keys, SkTArray<double>* values) {}
 
+    /*
+     * Benches that draw a known number of things per loop, like glyphs, can return it here to
+     * have nanobench report how many it draws per second.
+     */
+    virtual int itemsPerLoop() const { return 0; }
+
 protected:
     virtual void setupPaint(SkPaint* paint);
 
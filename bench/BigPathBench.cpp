@@ -6,7 +6,9 @@
  */
 
 #include "Benchmark.h"
+#include "SkBitmap.h"
 #include "SkCanvas.h"
+#include "SkGraphics.h"
 #include "SkPath.h"
 #include "sk_tool_utils.h"
 
@@ -84,3 +86,59 @@ DEF_BENCH( return new BigPathBench(kRight_Align,    false); )
 DEF_BENCH( return new BigPathBench(kLeft_Align,     true); )
 DEF_BENCH( return new BigPathBench(kMiddle_Align,   true); )
 DEF_BENCH( return new BigPathBench(kRight_Align,    true); )
+
+// Fills the same path scaled up to print resolution, split into the given number of bands.
+// Bands run on nanobench's thread pool, so --threads sets how many run at once.
+class BigPathBandsBench : public Benchmark {
+    SkPath              fPath;
+    SkString            fName;
+    SkBitmap            fBitmap;
+    int                 fBands;
+    int                 fPrevBands;
+
+public:
+    BigPathBandsBench(int bands) : fBands(bands), fPrevBands(0) {
+        fName.printf("bigpath_fill_bands_%d", bands);
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        sk_tool_utils::make_big_path(fPath);
+        SkMatrix matrix;
+        matrix.setRectToRect(fPath.getBounds(), SkRect::MakeWH(2048, 2048),
+                             SkMatrix::kFill_ScaleToFit);
+        fPath.transform(matrix);
+
+        fBitmap.allocN32Pixels(2048, 2048);
+    }
+
+    void onPerCanvasPreDraw(SkCanvas*) override {
+        fPrevBands = SkGraphics::SetAAFillBands(fBands);
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        SkGraphics::SetAAFillBands(fPrevBands);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkCanvas canvas(fBitmap);
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        for (int i = 0; i < loops; i++) {
+            canvas.drawPath(fPath, paint);
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new BigPathBandsBench(1); )
+DEF_BENCH( return new BigPathBandsBench(2); )
+DEF_BENCH( return new BigPathBandsBench(4); )
+DEF_BENCH( return new BigPathBandsBench(8); )
+DEF_BENCH( return new BigPathBandsBench(16); )
@@ -437,6 +437,65 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Chart-style gridlines and a data series stroked as dashed hairlines. Each frame draws
+// tens of thousands of short dashes, so the per-dash cost dominates.
+class DashHairlineChartBench : public Benchmark {
+    SkString fName;
+    bool     fDoAA;
+    SkPath   fGrid;
+    SkPath   fSeries;
+
+    sk_sp<SkPathEffect> fPathEffect;
+
+public:
+    DashHairlineChartBench(bool doAA) {
+        fName.printf("dash_hairline_chart%s", doAA ? "_aa" : "_bw");
+        fDoAA = doAA;
+
+        SkScalar vals[] = { 2, 2 };
+        fPathEffect = SkDashPathEffect::Make(vals, 2, 0);
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        for (int i = 0; i <= 40; ++i) {
+            SkScalar d = 10.5f + i * 15;
+            fGrid.moveTo(10.5f, d);
+            fGrid.lineTo(610.5f, d);
+            fGrid.moveTo(d, 10.5f);
+            fGrid.lineTo(d, 610.5f);
+        }
+
+        SkRandom rand;
+        fSeries.moveTo(10, 310);
+        for (int x = 11; x <= 610; ++x) {
+            fSeries.lineTo(SkIntToScalar(x), 310 + rand.nextSScalar1() * 200);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint p;
+        this->setupPaint(&p);
+        p.setColor(SK_ColorBLACK);
+        p.setStyle(SkPaint::kStroke_Style);
+        p.setStrokeWidth(0);
+        p.setPathEffect(fPathEffect);
+        p.setAntiAlias(fDoAA);
+
+        for (int i = 0; i < loops; ++i) {
+            canvas->drawPath(fGrid, p);
+            canvas->drawPath(fSeries, p);
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 static const SkScalar gDots[] = { SK_Scalar1, SK_Scalar1 };
@@ -484,3 +543,6 @@ DEF_BENCH( return new DashGridBench(1, 1, false); )
 DEF_BENCH( return new DashGridBench(3, 1, true); )
 DEF_BENCH( return new DashGridBench(3, 1, false); )
 #endif
+
+DEF_BENCH( return new DashHairlineChartBench(true); )
+DEF_BENCH( return new DashHairlineChartBench(false); )
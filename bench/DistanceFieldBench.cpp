@@ -0,0 +1,101 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkDistanceFieldGen.h"
+#include "SkMask.h"
+#include "SkPaint.h"
+#include "SkString.h"
+#include "SkTArray.h"
+#include "SkTemplates.h"
+
+// Generates the distance fields of a set of large glyphs, either one after another or all at
+// once with SkGenerateDistanceFieldsFromMasks().
+class DistanceFieldBench : public Benchmark {
+public:
+    DistanceFieldBench(bool batch) : fBatch(batch) {
+        fName.printf("distancefield_glyphs%s", batch ? "_batch" : "");
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        // The size large glyphs are rasterized at for distance fields on the GPU.
+        paint.setTextSize(162);
+
+        for (char c = 'A'; c <= 'z'; ++c) {
+            SkRect bounds;
+            paint.measureText(&c, 1, &bounds);
+            SkIRect ibounds = bounds.roundOut();
+            if (ibounds.isEmpty()) {
+                continue;
+            }
+            SkBitmap& bitmap = fBitmaps.push_back();
+            bitmap.allocPixels(SkImageInfo::MakeA8(ibounds.width(), ibounds.height()));
+            bitmap.eraseColor(SK_ColorTRANSPARENT);
+            SkCanvas canvas(bitmap);
+            canvas.drawText(&c, 1, -SkIntToScalar(ibounds.fLeft), -SkIntToScalar(ibounds.fTop),
+                            paint);
+            bitmap.lockPixels();
+
+            SkMask& mask = fMasks.push_back();
+            mask.fImage = (uint8_t*)bitmap.getPixels();
+            mask.fBounds.setXYWH(0, 0, bitmap.width(), bitmap.height());
+            mask.fRowBytes = SkToU32(bitmap.rowBytes());
+            mask.fFormat = SkMask::kA8_Format;
+        }
+
+        size_t fieldBytes = 0;
+        for (const SkMask& mask : fMasks) {
+            fieldBytes += SkComputeDistanceFieldSize(mask.fBounds.width(), mask.fBounds.height());
+        }
+        fFieldStorage.reset(fieldBytes);
+        unsigned char* field = fFieldStorage.get();
+        for (const SkMask& mask : fMasks) {
+            fFields.push_back(field);
+            field += SkComputeDistanceFieldSize(mask.fBounds.width(), mask.fBounds.height());
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            if (fBatch) {
+                SkGenerateDistanceFieldsFromMasks(fFields.begin(), fMasks.begin(),
+                                                  fMasks.count());
+            } else {
+                for (int j = 0; j < fMasks.count(); ++j) {
+                    SkGenerateDistanceFieldFromA8Image(fFields[j], fMasks[j].fImage,
+                                                       fMasks[j].fBounds.width(),
+                                                       fMasks[j].fBounds.height(),
+                                                       fMasks[j].fRowBytes);
+                }
+            }
+        }
+    }
+
+private:
+    bool                         fBatch;
+    SkString                     fName;
+    SkTArray<SkBitmap>           fBitmaps;
+    SkTArray<SkMask>             fMasks;
+    SkAutoTMalloc<unsigned char> fFieldStorage;
+    SkTArray<unsigned char*>     fFields;
+};
+
+DEF_BENCH(return new DistanceFieldBench(false);)
+DEF_BENCH(return new DistanceFieldBench(true);)
@@ -8,8 +8,10 @@
 #include "Benchmark.h"
 #include "SkCanvas.h"
 #include "SkChecksum.h"
+#include "SkGraphics.h"
 #include "SkPaint.h"
 #include "SkString.h"
+#include "SkTDArray.h"
 #include "SkTemplates.h"
 
 #include "gUniqueGlyphIDs.h"
@@ -139,9 +141,61 @@ private:
     typedef Benchmark INHERITED;
 };
 
+/*
+ * Draws a line of positioned text at each step of a pinch zoom, where every frame has a slightly
+ * different scale, optionally letting nearby sizes share strikes.
+ */
+class FontCacheZoomBench : public Benchmark {
+public:
+    FontCacheZoomBench(SkScalar tolerance) : fTolerance(tolerance) {
+        fName.printf("fontcache_zoom_%g", tolerance);
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        fPaint.setAntiAlias(true);
+        fPaint.setSubpixelText(true);
+        fPaint.setTextSize(14);
+        fText.set("ABCDEFGHIJKLMNOPQRSTUVWXYZ abcdefghijklmnopqrstuvwxyz 0123456789");
+        fPos.setCount(SkToInt(fText.size()));
+        for (int i = 0; i < fPos.count(); ++i) {
+            fPos[i].set(8.5f * i, 14);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkScalar prevTolerance = SkGraphics::SetFontCacheSizeTolerance(fTolerance);
+        for (int i = 0; i < loops; ++i) {
+            SkGraphics::PurgeFontCache();
+            for (int frame = 0; frame < 30; ++frame) {
+                canvas->save();
+                canvas->scale(1 + frame * 0.01f, 1 + frame * 0.01f);
+                canvas->drawPosText(fText.c_str(), fText.size(), fPos.begin(), fPaint);
+                canvas->restore();
+            }
+        }
+        SkGraphics::SetFontCacheSizeTolerance(prevTolerance);
+    }
+
+private:
+    SkScalar           fTolerance;
+    SkString           fName;
+    SkPaint            fPaint;
+    SkString           fText;
+    SkTDArray<SkPoint> fPos;
+
+    typedef Benchmark INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new FontCacheBench(); )
+DEF_BENCH( return new FontCacheZoomBench(0); )
+DEF_BENCH( return new FontCacheZoomBench(0.1f); )
 
 // undefine this to run the efficiency test
 //DEF_BENCH( return new FontCacheEfficiency(); )
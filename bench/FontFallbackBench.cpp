@@ -0,0 +1,62 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkFontMgr.h"
+#include "SkFontStyle.h"
+#include "SkString.h"
+#include "SkTypeface.h"
+
+// Looks up fallback fonts for the characters of a page mixing several scripts, as text
+// layout does for every character its font doesn't have.
+class FontFallbackBench : public Benchmark {
+public:
+    FontFallbackBench(bool withLanguages) : fWithLanguages(withLanguages) {
+        fName.printf("fontfallback_mixed_scripts%s", withLanguages ? "_languages" : "");
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        fFontMgr.reset(SkFontMgr::RefDefault());
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        // Latin, Greek, Cyrillic, Hebrew, Arabic, Devanagari, Thai, Hangul, CJK and symbols.
+        static const SkUnichar kScriptStarts[] = {
+            0x0041, 0x0391, 0x0410, 0x05D0, 0x0627, 0x0905, 0x0E01, 0xAC00, 0x4E00, 0x2600,
+        };
+        const char* languages[] = { "en-US", "ja-JP" };
+        const int languageCount = fWithLanguages ? SK_ARRAY_COUNT(languages) : 0;
+
+        for (int i = 0; i < loops; ++i) {
+            for (SkUnichar start : kScriptStarts) {
+                for (SkUnichar c = start; c < start + 32; ++c) {
+                    sk_sp<SkTypeface> typeface(fFontMgr->matchFamilyStyleCharacter(
+                            "sans-serif", SkFontStyle(), languages, languageCount, c));
+                }
+            }
+        }
+    }
+
+private:
+    sk_sp<SkFontMgr> fFontMgr;
+    SkString         fName;
+    bool             fWithLanguages;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new FontFallbackBench(false); )
+DEF_BENCH( return new FontFallbackBench(true); )
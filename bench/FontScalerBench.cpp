@@ -7,10 +7,15 @@
 
 #include "Benchmark.h"
 #include "SkCanvas.h"
+#include "SkFontMgr.h"
 #include "SkGraphics.h"
 #include "SkPaint.h"
 #include "SkRandom.h"
 #include "SkString.h"
+#include "SkSurface.h"
+#include "SkTArray.h"
+#include "SkTaskGroup.h"
+#include "SkTypeface.h"
 
 class FontScalerBench : public Benchmark {
     SkString fName;
@@ -50,3 +55,72 @@ private:
 
 DEF_BENCH(return new FontScalerBench(false);)
 DEF_BENCH(return new FontScalerBench(true);)
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Creates glyphs on several threads at once. With distinct typefaces each thread works on its
+// own face, so the time should drop as threads are added; with a shared typeface the threads
+// contend for the one face and it should not.
+class FontScalerThreadsBench : public Benchmark {
+    static constexpr int kThreads = 8;
+
+    SkString                     fName;
+    SkString                     fText;
+    bool                         fDistinct;
+    SkTArray<sk_sp<SkTypeface>>  fTypefaces;
+public:
+    FontScalerThreadsBench(bool distinct) : fDistinct(distinct) {
+        fName.printf("fontscaler_threads_%s", distinct ? "distinct" : "shared");
+        fText.set("abcdefghijklmnopqrstuvwxyz01234567890");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        sk_sp<SkFontMgr> fm(SkFontMgr::RefDefault());
+        for (int i = 0; i < fm->countFamilies() && fTypefaces.count() < kThreads; ++i) {
+            sk_sp<SkFontStyleSet> set(fm->createStyleSet(i));
+            for (int j = 0; j < set->count() && fTypefaces.count() < kThreads; ++j) {
+                sk_sp<SkTypeface> face(set->createTypeface(j));
+                if (face) {
+                    fTypefaces.push_back(std::move(face));
+                    if (!fDistinct) {
+                        return;
+                    }
+                }
+            }
+        }
+        if (fTypefaces.empty()) {
+            fTypefaces.push_back(SkTypeface::MakeDefault());
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            // As above, time the creation process rather than cache hits.
+            SkGraphics::PurgeFontCache();
+
+            SkTaskGroup().batch(kThreads, [&](int thread) {
+                sk_sp<SkSurface> surface(SkSurface::MakeRasterN32Premul(256, 32));
+                SkPaint paint;
+                paint.setAntiAlias(true);
+                paint.setTypeface(fTypefaces[thread % fTypefaces.count()]);
+                for (int ps = 9; ps <= 24; ps += 2) {
+                    paint.setTextSize(SkIntToScalar(ps));
+                    surface->getCanvas()->drawText(fText.c_str(), fText.size(),
+                                                   0, SkIntToScalar(20), paint);
+                }
+            });
+        }
+    }
+private:
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new FontScalerThreadsBench(false);)
+DEF_BENCH(return new FontScalerThreadsBench(true);)
@@ -175,3 +175,78 @@ DEF_BENCH(return new MeasureBench(false, 1000, 2000);)
 DEF_BENCH(return new MeasureBench(false, 1000, 3000);)
 DEF_BENCH(return new MeasureBench(false, 1000, 4000);)
 DEF_BENCH(return new MeasureBench(false, 1000, 5000);)
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Lays out fPieces positions along a multi-curve path every frame, the way text on a path
+// or an animated dash would, comparing a fresh SkPathMeasure against a cached snapshot.
+class MeasureSnapshotBench : public Benchmark {
+public:
+    enum Mode {
+        kPathMeasure_Mode,
+        kSnapshot_Mode,
+        kSnapshotBatch_Mode,
+    };
+
+    MeasureSnapshotBench(Mode mode, int pieces) : fMode(mode), fPieces(pieces) {
+        static const char* gModeNames[] = { "pathMeasure", "snapshot", "snapshotBatch" };
+        fName.printf("measure_textpath_%s_%d", gModeNames[mode], pieces);
+
+        fPath.moveTo(0, 100);
+        for (int i = 0; i < 8; ++i) {
+            SkScalar x = i * 100.0f;
+            fPath.cubicTo(x + 30, 0, x + 70, 200, x + 100, 100);
+        }
+        fDistances.setCount(pieces);
+        fPositions.setCount(pieces);
+        fTangents.setCount(pieces);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            if (kPathMeasure_Mode == fMode) {
+                SkPathMeasure meas(fPath, false);
+                SkScalar step = meas.getLength() / fPieces;
+                for (int j = 0; j < fPieces; j++) {
+                    (void)meas.getPosTan(j * step, &fPositions[j], &fTangents[j]);
+                }
+                continue;
+            }
+
+            sk_sp<SkPathMeasureSnapshot> snapshot = SkPathMeasureSnapshot::Make(fPath, false);
+            SkScalar step = snapshot->getLength(0) / fPieces;
+            if (kSnapshot_Mode == fMode) {
+                for (int j = 0; j < fPieces; j++) {
+                    snapshot->getPosTan(0, j * step, &fPositions[j], &fTangents[j]);
+                }
+            } else {
+                for (int j = 0; j < fPieces; j++) {
+                    fDistances[j] = j * step;
+                }
+                snapshot->getPosTan(0, fDistances.begin(), fPieces,
+                                    fPositions.begin(), fTangents.begin());
+            }
+        }
+    }
+
+private:
+    SkString            fName;
+    SkPath              fPath;
+    Mode                fMode;
+    int                 fPieces;
+    SkTDArray<SkScalar> fDistances;
+    SkTDArray<SkPoint>  fPositions;
+    SkTDArray<SkVector> fTangents;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new MeasureSnapshotBench(MeasureSnapshotBench::kPathMeasure_Mode, 100);)
+DEF_BENCH(return new MeasureSnapshotBench(MeasureSnapshotBench::kSnapshot_Mode, 100);)
+DEF_BENCH(return new MeasureSnapshotBench(MeasureSnapshotBench::kSnapshotBatch_Mode, 100);)
+DEF_BENCH(return new MeasureSnapshotBench(MeasureSnapshotBench::kPathMeasure_Mode, 1000);)
+DEF_BENCH(return new MeasureSnapshotBench(MeasureSnapshotBench::kSnapshot_Mode, 1000);)
+DEF_BENCH(return new MeasureSnapshotBench(MeasureSnapshotBench::kSnapshotBatch_Mode, 1000);)
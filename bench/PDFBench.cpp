@@ -7,6 +7,7 @@
 
 #include "Benchmark.h"
 #include "Resources.h"
+#include "SkAnnotation.h"
 #include "SkAutoPixmapStorage.h"
 #include "SkData.h"
 #include "SkGradientShader.h"
@@ -15,6 +16,7 @@
 #include "SkPDFDocument.h"
 #include "SkPDFShader.h"
 #include "SkPDFUtils.h"
+#include "SkPaint.h"
 #include "SkPixmap.h"
 #include "SkRandom.h"
 #include "SkStream.h"
@@ -242,6 +244,55 @@ struct WritePDFTextBenchmark : public Benchmark {
     }
 };
 
+// Many pages of small objects (fonts, graphic states, link annotations),
+// to compare classic cross-reference tables against PDF 1.5 object and
+// cross-reference streams.
+static void draw_pdf_document(SkDocument* doc) {
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setTextSize(12);
+    for (int page = 0; page < 20; ++page) {
+        SkCanvas* canvas = doc->beginPage(612, 792);
+        for (int i = 0; i < 50; ++i) {
+            SkScalar y = SkIntToScalar(20 + 15 * i);
+            paint.setAlpha(0xFF - 4 * i);
+            canvas->drawText("HELLO SKIA!", 11, 20, y, paint);
+            SkString url;
+            url.printf("http://skia.org/%d/%d", page, i);
+            sk_sp<SkData> urlData = SkData::MakeWithCString(url.c_str());
+            SkAnnotateRectWithURL(canvas, SkRect::MakeXYWH(20, y - 12, 80, 15), urlData.get());
+        }
+        doc->endPage();
+    }
+    doc->close();
+}
+
+template <bool kObjectStreams>
+struct PDFDocumentBench : public Benchmark {
+    const char* onGetName() override {
+        return kObjectStreams ? "PDFDocument_objectstreams" : "PDFDocument";
+    }
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+    void onDelayedSetup() override {
+        NullWStream nullStream;
+        draw_pdf_document(this->makeDocument(&nullStream).get());
+        SkDebugf("%s: %zu bytes\n", this->getName(), nullStream.bytesWritten());
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            NullWStream nullStream;
+            draw_pdf_document(this->makeDocument(&nullStream).get());
+        }
+    }
+    sk_sp<SkDocument> makeDocument(SkWStream* stream) {
+        SkDocument::PDFMetadata metadata;
+        metadata.fObjectStreams = kObjectStreams;
+        return SkDocument::MakePDF(stream, SK_ScalarDefaultRasterDPI, metadata, nullptr, false);
+    }
+};
+
 }  // namespace
 DEF_BENCH(return new PDFImageBench;)
 DEF_BENCH(return new PDFJpegImageBench;)
@@ -251,3 +302,5 @@ DEF_BENCH(return new PDFColorComponentBench;)
 DEF_BENCH(return new PDFShaderBench;)
 DEF_BENCH(return new WStreamWriteTextBenchmark;)
 DEF_BENCH(return new WritePDFTextBenchmark;)
+DEF_BENCH(return new PDFDocumentBench<false>;)
+DEF_BENCH(return new PDFDocumentBench<true>;)
@@ -61,6 +61,8 @@ protected:
             const SkMatrix m = SkMatrix::MakeScale(SkIntToScalar(10), SkIntToScalar(10));
             path.transform(m);
         }
+        // measure scan conversion rather than the raster backend's mask cache
+        path.setIsVolatile(true);
 
         int count = loops;
         if (fFlags & kBig_Flag) {
@@ -694,6 +696,65 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Draws the same small icon across a grid, as toolbars and chart markers do. Unless the path is
+// volatile, the raster backend keeps the mask of each grid position once it repeats.
+class IconPathBench : public Benchmark {
+    SkString    fName;
+    SkPath      fPath;
+    bool        fStroke;
+    bool        fVolatile;
+
+public:
+    IconPathBench(bool stroke, bool isVolatile) : fStroke(stroke), fVolatile(isVolatile) {
+        fName.printf("path_icon_%s%s", stroke ? "stroke" : "fill", isVolatile ? "_volatile" : "");
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        // a gear: a toothed outline with a round hole
+        const int kTeeth = 8;
+        for (int i = 0; i < kTeeth * 2; ++i) {
+            SkScalar radius = (i & 1) ? 9 : 12;
+            SkScalar start = i * SK_ScalarPI / kTeeth;
+            SkScalar end = (i + 1) * SK_ScalarPI / kTeeth;
+            SkPoint a = { 12 + radius * SkScalarCos(start), 12 + radius * SkScalarSin(start) };
+            SkPoint b = { 12 + radius * SkScalarCos(end), 12 + radius * SkScalarSin(end) };
+            if (0 == i) {
+                fPath.moveTo(a);
+            } else {
+                fPath.lineTo(a);
+            }
+            fPath.lineTo(b);
+        }
+        fPath.close();
+        fPath.addCircle(12, 12, 4, SkPath::kCCW_Direction);
+        fPath.setIsVolatile(fVolatile);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        if (fStroke) {
+            paint.setStyle(SkPaint::kStroke_Style);
+            paint.setStrokeWidth(1.5f);
+        }
+        this->setupPaint(&paint);
+
+        for (int i = 0; i < loops; ++i) {
+            canvas->save();
+            canvas->translate(SkIntToScalar(i % 16 * 30), SkIntToScalar(i / 16 % 16 * 30) + 0.5f);
+            canvas->drawPath(fPath, paint);
+            canvas->restore();
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
 
 // Chrome creates its own round rects with each corner possibly being different.
 // In its "zero radius" incarnation it creates degenerate round rects.
@@ -1115,6 +1176,11 @@ DEF_BENCH( return new SkBench_AddPathTest(SkBench_AddPathTest::kAddMatrix_AddTyp
 DEF_BENCH( return new SkBench_AddPathTest(SkBench_AddPathTest::kReverseAdd_AddType); )
 DEF_BENCH( return new SkBench_AddPathTest(SkBench_AddPathTest::kReversePathTo_AddType); )
 
+DEF_BENCH( return new IconPathBench(false, false); )
+DEF_BENCH( return new IconPathBench(false, true); )
+DEF_BENCH( return new IconPathBench(true, false); )
+DEF_BENCH( return new IconPathBench(true, true); )
+
 DEF_BENCH( return new CirclesBench(FLAGS00); )
 DEF_BENCH( return new CirclesBench(FLAGS01); )
 DEF_BENCH( return new ArbRoundRectBench(false); )
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkPath.h"
+#include "SkPathOps.h"
+#include "SkRandom.h"
+#include "SkString.h"
+
+// Unions many small polygons laid out on a grid. Neighbours within a 4x4 block overlap, so the
+// operands form many independent clusters, as in map tiles or glyph outlines.
+class PathOpsBatchUnionBench : public Benchmark {
+public:
+    enum Mode {
+        kResolve_Mode,
+        kBatch_Mode,
+        kParallelBatch_Mode,
+    };
+
+    PathOpsBatchUnionBench(int count, Mode mode) : fCount(count), fMode(mode) {
+        static const char* kModeNames[] = { "resolve", "batch", "batch_parallel" };
+        fName.printf("pathops_union_%d_%s", count, kModeNames[mode]);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        int columns = SkScalarCeilToInt(SkScalarSqrt(SkIntToScalar(fCount)));
+        fPaths.reset();
+        for (int i = 0; i < fCount; ++i) {
+            int column = i % columns;
+            int row = i / columns;
+            // Cells are 10 units apart; blocks of 4x4 cells are separated by a gap.
+            SkScalar x = SkIntToScalar(column * 10 + column / 4 * 20);
+            SkScalar y = SkIntToScalar(row * 10 + row / 4 * 20);
+            SkPath& path = fPaths.push_back();
+            path.moveTo(x, y);
+            path.lineTo(x + 12 + rand.nextRangeScalar(0, 2), y + rand.nextRangeScalar(0, 2));
+            path.lineTo(x + 12, y + 12 + rand.nextRangeScalar(0, 2));
+            path.lineTo(x + rand.nextRangeScalar(0, 2), y + 11);
+            path.close();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            SkOpBuilder builder;
+            for (const SkPath& path : fPaths) {
+                builder.add(path, kUnion_SkPathOp);
+            }
+            SkPath result;
+            if (kResolve_Mode == fMode) {
+                builder.resolve(&result);
+            } else {
+                builder.resolveBatch(&result, kParallelBatch_Mode == fMode);
+            }
+        }
+    }
+
+private:
+    SkString fName;
+    SkTArray<SkPath> fPaths;
+    int fCount;
+    Mode fMode;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new PathOpsBatchUnionBench(10, PathOpsBatchUnionBench::kResolve_Mode); )
+DEF_BENCH( return new PathOpsBatchUnionBench(100, PathOpsBatchUnionBench::kResolve_Mode); )
+DEF_BENCH( return new PathOpsBatchUnionBench(1000, PathOpsBatchUnionBench::kResolve_Mode); )
+
+DEF_BENCH( return new PathOpsBatchUnionBench(10, PathOpsBatchUnionBench::kBatch_Mode); )
+DEF_BENCH( return new PathOpsBatchUnionBench(100, PathOpsBatchUnionBench::kBatch_Mode); )
+DEF_BENCH( return new PathOpsBatchUnionBench(1000, PathOpsBatchUnionBench::kBatch_Mode); )
+DEF_BENCH( return new PathOpsBatchUnionBench(10000, PathOpsBatchUnionBench::kBatch_Mode); )
+DEF_BENCH( return new PathOpsBatchUnionBench(100000, PathOpsBatchUnionBench::kBatch_Mode); )
+
+DEF_BENCH( return new PathOpsBatchUnionBench(1000,
+                                             PathOpsBatchUnionBench::kParallelBatch_Mode); )
+DEF_BENCH( return new PathOpsBatchUnionBench(10000,
+                                             PathOpsBatchUnionBench::kParallelBatch_Mode); )
+DEF_BENCH( return new PathOpsBatchUnionBench(100000,
+                                             PathOpsBatchUnionBench::kParallelBatch_Mode); )
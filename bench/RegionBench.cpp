@@ -8,6 +8,9 @@
 #include "SkRandom.h"
 #include "SkRegion.h"
 #include "SkString.h"
+#include "SkTArray.h"
+#include "SkTDArray.h"
+#include "SkTemplates.h"
 
 static bool union_proc(SkRegion& a, SkRegion& b) {
     SkRegion result;
@@ -116,6 +119,107 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Builds a region out of many small rects, as damage tracking does, either one union at a
+// time or with a single setRects().
+class RegionBuildBench : public Benchmark {
+public:
+    RegionBuildBench(int count, bool batch) : fBatch(batch) {
+        fName.printf("region_build_%s_%d", batch ? "setrects" : "oploop", count);
+
+        SkRandom rand;
+        fRects.setCount(count);
+        for (SkIRect& r : fRects) {
+            r.setXYWH(rand.nextULessThan(1024), rand.nextULessThan(768),
+                      1 + rand.nextULessThan(32), 1 + rand.nextULessThan(32));
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; ++i) {
+            SkRegion rgn;
+            if (fBatch) {
+                rgn.setRects(fRects.begin(), fRects.count());
+            } else {
+                for (const SkIRect& r : fRects) {
+                    rgn.op(r, SkRegion::kUnion_Op);
+                }
+            }
+        }
+    }
+
+private:
+    bool               fBatch;
+    SkTDArray<SkIRect> fRects;
+    SkString           fName;
+
+    typedef Benchmark INHERITED;
+};
+
+// Combines many complex regions, either pairwise with op() or with a single setRegions(). The
+// unions are of scattered damage regions; the intersections are of clips with holes in them.
+class RegionCombineBench : public Benchmark {
+public:
+    RegionCombineBench(int count, SkRegion::Op op, bool batch) : fOp(op), fBatch(batch) {
+        fName.printf("region_combine_%s_%s_%d", SkRegion::kUnion_Op == op ? "union" : "intersect",
+                     batch ? "setregions" : "oploop", count);
+
+        SkRandom rand;
+        fRegions.reset(count);
+        fRegionPtrs.reset(count);
+        for (int i = 0; i < count; ++i) {
+            if (SkRegion::kIntersect_Op == op) {
+                fRegions[i].setRect(rand.nextULessThan(64), rand.nextULessThan(64),
+                                    960 + rand.nextULessThan(64), 704 + rand.nextULessThan(64));
+            }
+            for (int j = 0; j < 4; ++j) {
+                fRegions[i].op(SkIRect::MakeXYWH(rand.nextULessThan(1024), rand.nextULessThan(768),
+                                                 1 + rand.nextULessThan(40),
+                                                 1 + rand.nextULessThan(40)),
+                               SkRegion::kXOR_Op);
+            }
+            fRegionPtrs[i] = &fRegions[i];
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        const int count = fRegions.count();
+        for (int i = 0; i < loops; ++i) {
+            SkRegion rgn;
+            if (fBatch) {
+                rgn.setRegions(fRegionPtrs.get(), count, fOp);
+            } else {
+                rgn = fRegions[0];
+                for (int j = 1; j < count; ++j) {
+                    rgn.op(fRegions[j], fOp);
+                }
+            }
+        }
+    }
+
+private:
+    SkRegion::Op                    fOp;
+    bool                            fBatch;
+    SkTArray<SkRegion>              fRegions;
+    SkAutoTMalloc<const SkRegion*>  fRegionPtrs;
+    SkString                        fName;
+
+    typedef Benchmark INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #define SMALL   16
@@ -129,3 +233,11 @@ DEF_BENCH(return new RegionBench(SMALL, containsrect_proc, "containsrect");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrgn_proc, "intersectsrgn");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrect_proc, "intersectsrect");)
 DEF_BENCH(return new RegionBench(SMALL, containsxy_proc, "containsxy");)
+
+DEF_BENCH(return new RegionBuildBench(1000, false);)
+DEF_BENCH(return new RegionBuildBench(1000, true);)
+DEF_BENCH(return new RegionBuildBench(50000, true);)
+DEF_BENCH(return new RegionCombineBench(256, SkRegion::kUnion_Op, false);)
+DEF_BENCH(return new RegionCombineBench(256, SkRegion::kUnion_Op, true);)
+DEF_BENCH(return new RegionCombineBench(64, SkRegion::kIntersect_Op, false);)
+DEF_BENCH(return new RegionCombineBench(64, SkRegion::kIntersect_Op, true);)
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+
+#if defined(SK_XML)
+#include "SkCanvas.h"
+#include "SkPaint.h"
+#include "SkPath.h"
+#include "SkRandom.h"
+#include "SkStream.h"
+#include "SkSVGCanvas.h"
+#include "SkXMLWriter.h"
+
+namespace {
+
+struct NullWStream : public SkWStream {
+    NullWStream() : fN(0) {}
+    bool write(const void*, size_t n) override { fN += n; return true; }
+    size_t bytesWritten() const override { return fN; }
+    size_t fN;
+};
+
+static const int kPathCount = 200;
+static const int kSegmentsPerPath = 500;
+static const int kPaintCount = 8;
+static const SkScalar kSize = 1000;
+
+// Exports a map-like scene (many long polylines sharing a handful of paints) through
+// SkSVGCanvas.
+class SVGExportBench : public Benchmark {
+public:
+    SVGExportBench(int precision, uint32_t flags)
+        : fPrecision(precision)
+        , fFlags(flags) {
+        fName.set("svg_export_");
+        if (SkSVGCanvas::kFullPrecision == precision) {
+            fName.append("full");
+        } else {
+            fName.appendf("p%d", precision);
+        }
+        if (flags & SkSVGCanvas::kStyleClasses_Flag) {
+            fName.append("_classes");
+        }
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        for (int i = 0; i < kPathCount; ++i) {
+            SkPoint pt = { rand.nextRangeScalar(0, kSize), rand.nextRangeScalar(0, kSize) };
+            fPaths[i].moveTo(pt);
+            for (int j = 0; j < kSegmentsPerPath; ++j) {
+                pt.offset(rand.nextRangeScalar(-5, 5), rand.nextRangeScalar(-5, 5));
+                fPaths[i].lineTo(pt);
+            }
+        }
+        for (int i = 0; i < kPaintCount; ++i) {
+            fPaints[i].setAntiAlias(true);
+            fPaints[i].setColor(rand.nextU() | 0xFF000000);
+            if (i & 1) {
+                fPaints[i].setStyle(SkPaint::kStroke_Style);
+                fPaints[i].setStrokeWidth(SkIntToScalar(i));
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            NullWStream stream;
+            SkXMLStreamWriter writer(&stream);
+            std::unique_ptr<SkCanvas> canvas =
+                    SkSVGCanvas::Make(SkRect::MakeWH(kSize, kSize), &writer, fPrecision, fFlags);
+            for (int j = 0; j < kPathCount; ++j) {
+                canvas->drawPath(fPaths[j], fPaints[j % kPaintCount]);
+            }
+        }
+    }
+
+private:
+    SkString fName;
+    int      fPrecision;
+    uint32_t fFlags;
+    SkPath   fPaths[kPathCount];
+    SkPaint  fPaints[kPaintCount];
+
+    typedef Benchmark INHERITED;
+};
+
+}  // namespace
+
+DEF_BENCH( return new SVGExportBench(SkSVGCanvas::kFullPrecision, 0); )
+DEF_BENCH( return new SVGExportBench(4, 0); )
+DEF_BENCH( return new SVGExportBench(2, 0); )
+DEF_BENCH( return new SVGExportBench(2, SkSVGCanvas::kStyleClasses_Flag); )
+
+#endif  // SK_XML
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkPaint.h"
+#include "SkShaper.h"
+#include "SkString.h"
+#include "SkTextBlob.h"
+
+static const char kParagraph[] =
+        "The quick brown fox jumps over the lazy dog. Pack my box with five dozen liquor jugs. "
+        "How vexingly quick daft zebras jump! Sphinx of black quartz, judge my vow. "
+        "The five boxing wizards jump quickly. Jackdaws love my big sphinx of quartz.";
+
+// Lays out the same paragraph every loop, as a UI does every frame, either unchanged or with
+// one letter of it edited.
+class ShaperBench : public Benchmark {
+public:
+    ShaperBench(bool edit) : fEdit(edit) {
+        fName.printf("shaper_paragraph%s", edit ? "_edit" : "");
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        fShaper.reset(new SkShaper(nullptr));
+        fPaint.setTextSize(14);
+        fText.set(kParagraph);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            if (fEdit) {
+                char* letter = fText.writable_str() + i % fText.size();
+                if ((*letter | 0x20) >= 'a' && (*letter | 0x20) <= 'z') {
+                    *letter ^= 0x20;  // Flip its case.
+                }
+            }
+            SkTextBlobBuilder builder;
+            fShaper->shape(&builder, fPaint, fText.c_str(), fText.size(), SkPoint::Make(0, 0));
+            sk_sp<SkTextBlob> blob = builder.make();
+        }
+    }
+
+private:
+    std::unique_ptr<SkShaper> fShaper;
+    SkPaint                   fPaint;
+    SkString                  fText;
+    SkString                  fName;
+    bool                      fEdit;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new ShaperBench(false); )
+DEF_BENCH( return new ShaperBench(true); )
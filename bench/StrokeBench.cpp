@@ -94,6 +94,19 @@ static SkPath cubic_path_maker() {
     return path;
 }
 
+// A long GIS-style track: a random walk of short segments.
+static SkPath polyline_path_maker() {
+    SkPath path;
+    SkRandom rand;
+    SkPoint pt = SkPoint::Make(0, 0);
+    path.moveTo(pt);
+    for (int i = 0; i < 100 * N; ++i) {
+        pt += SkVector::Make(rand.nextSScalar1(), rand.nextSScalar1());
+        path.lineTo(pt);
+    }
+    return path;
+}
+
 static SkPaint paint_maker() {
     SkPaint paint;
     paint.setStyle(SkPaint::kStroke_Style);
@@ -108,6 +121,8 @@ DEF_BENCH(return new StrokeBench(quad_path_maker(), paint_maker(), "quad_1", 1);
 DEF_BENCH(return new StrokeBench(conic_path_maker(), paint_maker(), "conic_1", 1);)
 DEF_BENCH(return new StrokeBench(cubic_path_maker(), paint_maker(), "cubic_1", 1);)
 
+DEF_BENCH(return new StrokeBench(polyline_path_maker(), paint_maker(), "polyline_1", 1);)
+
 DEF_BENCH(return new StrokeBench(line_path_maker(), paint_maker(), "line_4", 4);)
 DEF_BENCH(return new StrokeBench(quad_path_maker(), paint_maker(), "quad_4", 4);)
 DEF_BENCH(return new StrokeBench(conic_path_maker(), paint_maker(), "conic_4", 4);)
@@ -117,3 +132,19 @@ DEF_BENCH(return new StrokeBench(line_path_maker(), paint_maker(), "line_.25", .
 DEF_BENCH(return new StrokeBench(quad_path_maker(), paint_maker(), "quad_.25", .25f);)
 DEF_BENCH(return new StrokeBench(conic_path_maker(), paint_maker(), "conic_.25", .25f);)
 DEF_BENCH(return new StrokeBench(cubic_path_maker(), paint_maker(), "cubic_.25", .25f);)
+
+static SkPaint polyline_paint_maker(SkPaint::Join join) {
+    SkPaint paint;
+    paint.setStyle(SkPaint::kStroke_Style);
+    paint.setStrokeWidth(2);
+    paint.setStrokeJoin(join);
+    paint.setStrokeCap(SkPaint::kButt_Cap);
+    return paint;
+}
+
+DEF_BENCH(return new StrokeBench(polyline_path_maker(), polyline_paint_maker(SkPaint::kMiter_Join),
+                                 "polyline", 1);)
+DEF_BENCH(return new StrokeBench(polyline_path_maker(), polyline_paint_maker(SkPaint::kRound_Join),
+                                 "polyline", 1);)
+DEF_BENCH(return new StrokeBench(polyline_path_maker(), polyline_paint_maker(SkPaint::kBevel_Join),
+                                 "polyline", 1);)
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkTypes.h"
+
+// This tests a Gr class, but only its CPU side: no GrContext is needed.
+#if SK_SUPPORT_GPU
+
+#include "Benchmark.h"
+#include "GrTessellator.h"
+#include "SkChunkAlloc.h"
+#include "SkPath.h"
+#include "SkRandom.h"
+#include "SkString.h"
+#include "SkTDArray.h"
+
+/**
+ * Triangulates a set of self-intersecting curved paths, either one after another through
+ * GrTessellator::PathToVertices() or all at once through GrTessellator::PathsToVertices().
+ */
+class TessellatorBench : public Benchmark {
+public:
+    enum Mode {
+        kSingle_Mode,   // a fresh allocator and vertex array for each path
+        kScratch_Mode,  // one allocator and vertex array reused for every path
+        kBatch_Mode,    // PathsToVertices()
+    };
+
+    TessellatorBench(Mode mode) : fMode(mode) {
+        static const char* kModeNames[] = { "single", "scratch", "batch" };
+        fName.printf("tessellator_%s", kModeNames[mode]);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        for (SkPath& path : fPaths) {
+            path.moveTo(rand.nextRangeScalar(0, kSize), rand.nextRangeScalar(0, kSize));
+            for (int i = 0; i < 20; ++i) {
+                path.quadTo(rand.nextRangeScalar(0, kSize), rand.nextRangeScalar(0, kSize),
+                            rand.nextRangeScalar(0, kSize), rand.nextRangeScalar(0, kSize));
+            }
+            path.close();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const SkRect clipBounds = SkRect::MakeWH(kSize, kSize);
+        for (int loop = 0; loop < loops; ++loop) {
+            switch (fMode) {
+                case kSingle_Mode:
+                    for (const SkPath& path : fPaths) {
+                        GrTessellator::WindingVertex* verts = nullptr;
+                        GrTessellator::PathToVertices(path, kTolerance, clipBounds, &verts);
+                        delete[] verts;
+                    }
+                    break;
+                case kScratch_Mode: {
+                    SkChunkAlloc scratch(16 * 1024);
+                    for (const SkPath& path : fPaths) {
+                        GrTessellator::PathToVertices(path, kTolerance, clipBounds, &scratch,
+                                                      &fVerts[0]);
+                    }
+                    break;
+                }
+                case kBatch_Mode:
+                    GrTessellator::PathsToVertices(fPaths, kPathCount, kTolerance, clipBounds,
+                                                   fVerts);
+                    break;
+            }
+        }
+    }
+
+private:
+    static constexpr int      kPathCount = 64;
+    static constexpr SkScalar kSize = 512;
+    static constexpr SkScalar kTolerance = 0.25f;
+
+    Mode                              fMode;
+    SkString                          fName;
+    SkPath                            fPaths[kPathCount];
+    SkTDArray<GrTessellator::WindingVertex> fVerts[kPathCount];
+
+    typedef Benchmark INHERITED;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+DEF_BENCH( return new TessellatorBench(TessellatorBench::kSingle_Mode); )
+DEF_BENCH( return new TessellatorBench(TessellatorBench::kScratch_Mode); )
+DEF_BENCH( return new TessellatorBench(TessellatorBench::kBatch_Mode); )
+
+#endif
@@ -110,6 +110,11 @@ protected:
         return fName.c_str();
     }
 
+    // Glyphs drawn per loop, so that nanobench reports glyphs per second.
+    int itemsPerLoop() const override {
+        return fPaint.textToGlyphs(fText.c_str(), fText.size(), nullptr);
+    }
+
     void onDraw(int loops, SkCanvas* canvas) override {
         const SkIPoint dim = this->getSize();
         SkRandom rand;
@@ -175,3 +180,6 @@ DEF_BENCH( return new TextBench(STR, 16, 0x88FF0000, kBW, true); )
 
 DEF_BENCH( return new TextBench(STR, 16, 0xFF000000, kBW, true, true); )
 DEF_BENCH( return new TextBench(STR, 16, 0xFF000000, kAA, false, true); )
+DEF_BENCH( return new TextBench(STR, 16, 0x88FF0000, kAA, false, true); )
+DEF_BENCH( return new TextBench(STR, 16, 0xFF000000, kLCD, false, true); )
+DEF_BENCH( return new TextBench(STR, 16, 0x88FF0000, kLCD, false, true); )
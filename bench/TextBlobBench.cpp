@@ -8,13 +8,18 @@
 #include "Benchmark.h"
 #include "Resources.h"
 #include "SkCanvas.h"
+#include "SkFontMgr.h"
+#include "SkGraphics.h"
 #include "SkPaint.h"
 #include "SkRandom.h"
+#include "SkReadBuffer.h"
 #include "SkStream.h"
 #include "SkString.h"
+#include "SkTArray.h"
 #include "SkTemplates.h"
 #include "SkTextBlob.h"
 #include "SkTypeface.h"
+#include "SkWriteBuffer.h"
 
 #include "sk_tool_utils.h"
 
@@ -70,3 +75,166 @@ private:
 };
 
 DEF_BENCH( return new TextBlobBench(); )
+
+/*
+ * Times the first frame of a page of text: every glyph has to be created, on the draw thread
+ * or, with prewarm, by SkGraphics::PrewarmTextBlobs() just before the draws.
+ */
+class TextBlobFirstFrameBench : public Benchmark {
+public:
+    TextBlobFirstFrameBench(bool prewarm) : fPrewarm(prewarm) {
+        fName.printf("textblob_first_frame%s", prewarm ? "_prewarm" : "");
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        static const int kTypefaces = 4;
+        SkTArray<sk_sp<SkTypeface>> typefaces;
+        sk_sp<SkFontMgr> fm(SkFontMgr::RefDefault());
+        for (int i = 0; i < fm->countFamilies() && typefaces.count() < kTypefaces; ++i) {
+            sk_sp<SkFontStyleSet> set(fm->createStyleSet(i));
+            if (set->count() > 0) {
+                sk_sp<SkTypeface> face(set->createTypeface(0));
+                if (face) {
+                    typefaces.push_back(std::move(face));
+                }
+            }
+        }
+        if (typefaces.empty()) {
+            typefaces.push_back(sk_tool_utils::create_portable_typeface("serif", SkFontStyle()));
+        }
+
+        const char* text = "The quick brown fox jumps over the lazy dog. 0123456789 "
+                           "PACK MY BOX WITH FIVE DOZEN LIQUOR JUGS!";
+        size_t len = strlen(text);
+        SkScalar y = 0;
+        for (int size = 10; size <= 24; size += 2) {
+            SkTextBlobBuilder builder;
+            for (int line = 0; line < 4; ++line) {
+                SkPaint paint;
+                paint.setAntiAlias(true);
+                paint.setSubpixelText(true);
+                paint.setTextSize(SkIntToScalar(size));
+                paint.setTypeface(typefaces[line % typefaces.count()]);
+
+                int count = paint.textToGlyphs(text, len, nullptr);
+                paint.setTextEncoding(SkPaint::kGlyphID_TextEncoding);
+                const SkTextBlobBuilder::RunBuffer& run = builder.allocRunPosH(paint, count,
+                                                                               y + size);
+                SkPaint utf8(paint);
+                utf8.setTextEncoding(SkPaint::kUTF8_TextEncoding);
+                utf8.textToGlyphs(text, len, run.glyphs);
+
+                SkAutoTArray<SkScalar> widths(count);
+                paint.getTextWidths(run.glyphs, count * sizeof(uint16_t), widths.get());
+                SkScalar x = 0;
+                for (int i = 0; i < count; ++i) {
+                    run.pos[i] = x;
+                    x += widths[i];
+                }
+                y += size * 1.25f;
+            }
+            fBlobs.push_back(builder.make());
+            fOrigins.push_back(SkPoint::Make(10, 0));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkTArray<const SkTextBlob*> blobs;
+        for (const sk_sp<SkTextBlob>& blob : fBlobs) {
+            blobs.push_back(blob.get());
+        }
+        SkPaint paint;
+
+        for (int i = 0; i < loops; i++) {
+            SkGraphics::PurgeFontCache();
+            if (fPrewarm) {
+                SkGraphics::PrewarmTextBlobs(canvas, blobs.begin(), fOrigins.begin(),
+                                             blobs.count(), paint);
+            }
+            for (int j = 0; j < blobs.count(); j++) {
+                canvas->drawTextBlob(blobs[j], fOrigins[j].x(), fOrigins[j].y(), paint);
+            }
+        }
+    }
+
+private:
+    SkString                    fName;
+    bool                        fPrewarm;
+    SkTArray<sk_sp<SkTextBlob>> fBlobs;
+    SkTArray<SkPoint>           fOrigins;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new TextBlobFirstFrameBench(false); )
+DEF_BENCH( return new TextBlobFirstFrameBench(true); )
+
+/*
+ * Writes and reads back a page of shaped text, as recording it into a picture and playing it
+ * back elsewhere would. Positions are on the 1/64 grid shapers lay glyphs out on.
+ */
+class TextBlobSerializeBench : public Benchmark {
+public:
+    TextBlobSerializeBench() {}
+
+protected:
+    const char* onGetName() override {
+        return "textblob_serialize";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        SkPaint paint;
+        paint.setTypeface(sk_tool_utils::create_portable_typeface("serif", SkFontStyle()));
+        paint.setTextSize(14);
+        const char* text = "The quick brown fox jumps over the lazy dog. 0123456789 "
+                           "PACK MY BOX WITH FIVE DOZEN LIQUOR JUGS!";
+        size_t len = strlen(text);
+        SkTDArray<uint16_t> glyphs;
+        glyphs.setCount(paint.textToGlyphs(text, len, nullptr));
+        paint.textToGlyphs(text, len, glyphs.begin());
+        SkAutoTArray<SkScalar> widths(glyphs.count());
+        paint.setTextEncoding(SkPaint::kGlyphID_TextEncoding);
+        paint.getTextWidths(glyphs.begin(), glyphs.count() * sizeof(uint16_t), widths.get());
+
+        SkTextBlobBuilder builder;
+        for (int line = 0; line < 50; ++line) {
+            const SkTextBlobBuilder::RunBuffer& run = builder.allocRunPos(paint, glyphs.count());
+            memcpy(run.glyphs, glyphs.begin(), glyphs.count() * sizeof(uint16_t));
+            SkScalar x = 10;
+            for (int i = 0; i < glyphs.count(); ++i) {
+                run.pos[2 * i] = x;
+                run.pos[2 * i + 1] = 18.0f * (line + 1);
+                x += SkScalarRoundToScalar(widths[i] * 64) / 64;
+            }
+        }
+        fBlob = builder.make();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            SkBinaryWriteBuffer writer;
+            fBlob->flatten(writer);
+            SkAutoMalloc storage(writer.bytesWritten());
+            writer.writeToMemory(storage.get());
+            SkReadBuffer reader(storage.get(), writer.bytesWritten());
+            sk_sp<SkTextBlob> blob = SkTextBlob::MakeFromBuffer(reader);
+            SkASSERT(blob);
+        }
+    }
+
+private:
+    sk_sp<SkTextBlob> fBlob;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new TextBlobSerializeBench(); )
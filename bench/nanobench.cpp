@@ -1287,6 +1287,10 @@ int nanobench_main() {
             target->fillOptions(log.get());
             log->metric("min_ms",    stats.min);
             log->metrics("samples",    samples);
+            const int itemsPerLoop = bench->itemsPerLoop();
+            if (itemsPerLoop > 0) {
+                log->metric("items_per_sec", itemsPerLoop / (stats.median * 1e-3));
+            }
 #if SK_SUPPORT_GPU
             if (gpuStatsDump) {
                 // dump to json, only SKPBench currently returns valid keys / values
@@ -1333,6 +1337,9 @@ int nanobench_main() {
                         , config
                         , bench->getUniqueName()
                         );
+                if (itemsPerLoop > 0) {
+                    SkDebugf("\t\t%.3gM items/s\n", itemsPerLoop / (stats.median * 1e3));
+                }
             }
 
 #if SK_SUPPORT_GPU
@@ -463,23 +463,42 @@
       },
     },
     {
-      'target_name': 'using_skia_and_harfbuzz',
-      'type': 'executable',
-      'sources': [ '../tools/using_skia_and_harfbuzz.cpp', ],
-      'variables': { 'skia_example_use_harfbuzz%': 1, },
+      'target_name': 'skshaper',
+      'type': 'static_library',
+      'sources': [ '../tools/SkShaper.h', ],
+      'include_dirs': [
+        '../include/private',
+        '../src/core',
+      ],
       'conditions': [
-        [ 'skia_example_use_harfbuzz',
+        # We can't yet build ICU on iOS or Windows.
+        [ 'skia_os not in ["ios", "win"]',
           {
             'dependencies': [ 'harfbuzz.gyp:harfbuzz', ],
+            'export_dependent_settings': [ 'harfbuzz.gyp:harfbuzz', ],
             'sources' : [ '../tools/SkShaper_harfbuzz.cpp', ],
           }, {
             'sources' : [ '../tools/SkShaper_primitive.cpp', ],
           },
         ]
       ],
+      'dependencies': [
+        'skia_lib.gyp:skia_lib',
+      ],
+      'direct_dependent_settings': {
+        'include_dirs': [
+          '../tools',
+        ],
+      },
+    },
+    {
+      'target_name': 'using_skia_and_harfbuzz',
+      'type': 'executable',
+      'sources': [ '../tools/using_skia_and_harfbuzz.cpp', ],
       'dependencies': [
         'skia_lib.gyp:skia_lib',
         'pdf.gyp:pdf',
+        'skshaper',
       ],
     },
     {
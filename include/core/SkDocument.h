@@ -82,6 +82,15 @@ public:
          * The date and time the document was most recently modified.
          */
         OptionalTimestamp fModified;
+        /**
+         * If true, write a PDF 1.5 file: small non-stream objects
+         * (fonts, graphic states, annotations, ...) are packed into
+         * compressed object streams and the cross-reference table is
+         * written as a compressed stream.  This produces smaller files
+         * that readers older than PDF 1.5 can not open.  Ignored for
+         * PDF/A documents (see MakePDF()), which may not use either.
+         */
+        bool fObjectStreams = false;
     };
 
     /**
@@ -16,6 +16,7 @@
 #include "SkStrokeRec.h"
 
 class SkBitmap;
+class SkCanvas;
 class SkClipStack;
 class SkBaseDevice;
 class SkBlitter;
@@ -23,6 +24,7 @@ class SkMatrix;
 class SkPath;
 class SkRegion;
 class SkRasterClip;
+class SkTextBlob;
 struct SkDrawProcs;
 struct SkRect;
 class SkRRect;
@@ -119,6 +121,12 @@ public:
     void        drawPosText_asPaths(const char text[], size_t byteLength,
                                     const SkScalar pos[], int scalarsPerPosition,
                                     const SkPoint& offset, const SkPaint&) const;
+    /**
+     *  Fill the glyph cache strikes that drawing the blobs into the canvas would use, one
+     *  SkTaskGroup task per strike. See SkGraphics::PrewarmTextBlobs().
+     */
+    static void PrewarmTextBlobs(SkCanvas*, const SkTextBlob* const blobs[],
+                                 const SkPoint origins[], int count, const SkPaint&);
     static SkScalar ComputeResScaleForStroking(const SkMatrix& );
 private:
     void    drawDevMask(const SkMask& mask, const SkPaint&) const;
@@ -131,6 +139,12 @@ private:
     void drawLine(const SkPoint[2], const SkPaint&) const;
     void drawDevPath(const SkPath& devPath, const SkPaint& paint, bool drawCoverage,
                      SkBlitter* customBlitter, bool doFill) const;
+    // Draws a small path from its cached mask. On a miss, sets captureMask if the same draw
+    // was seen before, so the caller keeps the mask this draw produces.
+    bool drawCachedPathMask(const SkPath&, const SkMatrix&, const SkPaint&,
+                            bool* captureMask) const;
+    bool drawDashedHairline(const SkPath&, const SkPaint&, bool drawCoverage,
+                            SkBlitter* customBlitter) const;
     /**
      *  Return the current clip bounds, in local coordinates, with slop to account
      *  for antialiasing or hairlines (i.e. device-bounds outset by 1, and then
@@ -158,6 +172,14 @@ public:
 #else
     void validate() const {}
 #endif
+
+private:
+    // Used in place of SkGraphics::GetAAFillBands() if not zero, by tests.
+    int             fAAFillBands;
+    // Used in place of SkGraphics::GetFontCacheSizeTolerance() if not null, by tests.
+    const SkScalar* fTextSizeTolerance;
+
+    friend class DrawTestingAccess;
 };
 
 #endif
@@ -8,11 +8,16 @@
 #ifndef SkGraphics_DEFINED
 #define SkGraphics_DEFINED
 
+#include "SkScalar.h"
 #include "SkTypes.h"
 
+class SkCanvas;
 class SkData;
 class SkImageGenerator;
+class SkPaint;
+class SkTextBlob;
 class SkTraceMemoryDump;
+struct SkPoint;
 
 class SK_API SkGraphics {
 public:
@@ -72,6 +77,31 @@ public:
      */
     static int SetFontCacheCountLimit(int count);
 
+    /**
+     *  Return the fraction by which glyph images may be scaled so that text of nearby sizes can
+     *  share a font cache entry. See SetFontCacheSizeTolerance().
+     */
+    static SkScalar GetFontCacheSizeTolerance();
+
+    /**
+     *  Let text whose sizes on the device are within tolerance of each other (e.g. 0.1 for 10%)
+     *  share a font cache entry, instead of creating and rasterizing glyphs for every size, as
+     *  text being zoomed or animated would. The shared glyph images are scaled as they are
+     *  drawn, so they may be a little softer. Sizes already on the shared grid, such as whole
+     *  pixel sizes, are drawn unscaled. The default, 0, gives every size its own entry.
+     *  Returns the previous tolerance.
+     *
+     *  Only applies to anti-aliased, filled, non-LCD text with explicit positions (positioned
+     *  text and text blob runs) drawn into raster canvases without rotation or perspective.
+     */
+    static SkScalar SetFontCacheSizeTolerance(SkScalar tolerance);
+
+    /**
+     *  Return how many font cache entries text has been drawn without, since the process
+     *  started, because it was drawn from an entry of a nearby size instead.
+     */
+    static int GetFontCacheStrikesAvoided();
+
     /**
      *  For debugging purposes, this will attempt to purge the font cache. It
      *  does not change the limit, but will cause subsequent font measures and
@@ -79,6 +109,49 @@ public:
      */
     static void PurgeFontCache();
 
+    /**
+     *  Save the glyphs in the font cache to a file, so that a later process can pass it to
+     *  SetFontCacheFile() instead of creating those glyphs again. Only strikes of fonts that
+     *  can be identified across processes (those with an sfnt 'head' table) are saved. The
+     *  file is replaced, not overwritten, so it is safe to write the file this process is
+     *  using, except on Windows, where a mapped file can't be replaced. Returns false if it
+     *  could not be written.
+     */
+    static bool WriteFontCacheFile(const char path[]);
+
+    /**
+     *  Memory map a file written by WriteFontCacheFile(). Strikes created from now on take
+     *  the metrics, masks and paths of any glyphs the file has from it, rather than from the
+     *  font. Strikes already in the cache are not affected. Pass nullptr to stop using a file.
+     *  Returns false, and uses no file, if path can't be read or holds no saved glyphs.
+     */
+    static bool SetFontCacheFile(const char path[]);
+
+    /**
+     *  Generate ahead of time the glyph metrics, masks and paths that drawing each blob at the
+     *  matching origin with the paint into the canvas, at its current matrix, will look up.
+     *  Each font cache strike involved is filled by its own SkTaskGroup task, so a following
+     *  drawTextBlob() finds its glyphs already cached instead of creating them one at a time.
+     *
+     *  This mirrors how raster canvases draw text; other backends may use different strikes.
+     */
+    static void PrewarmTextBlobs(SkCanvas*, const SkTextBlob* const blobs[],
+                                 const SkPoint origins[], int count, const SkPaint&);
+
+    /**
+     *  Return the most horizontal bands that raster canvases fill a large anti-aliased path in
+     *  at once. See SetAAFillBands().
+     */
+    static int GetAAFillBands();
+
+    /**
+     *  Let raster canvases fill large anti-aliased paths in up to this many horizontal bands,
+     *  each an SkTaskGroup task, so that the bands are filled at once if the process has a
+     *  thread pool (see SkTaskGroup::Enabler). The pixels are the same as filling in one pass.
+     *  The default of 0, like 1, fills in one pass. Returns the previous value.
+     */
+    static int SetAAFillBands(int bands);
+
     /**
      *  Scaling bitmaps with the kHigh_SkFilterQuality setting is
      *  expensive, so the result is saved in the global Scaled Image
@@ -76,6 +76,9 @@ bool    sk_isdir(const char *path);
 // Have we reached the end of the file?
 int sk_feof(FILE *);
 
+// Rename the file at from to to, replacing any file already there. Returns true if successful.
+bool    sk_rename(const char from[], const char to[]);
+
 
 // Create a new directory at this path; returns true if successful.
 // If the directory already existed, this will return true.
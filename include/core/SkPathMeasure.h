@@ -10,6 +10,7 @@
 
 #include "../private/SkTDArray.h"
 #include "SkPath.h"
+#include "SkRefCnt.h"
 
 struct SkConic;
 
@@ -118,6 +119,85 @@ private:
     bool conic_too_curvy(const SkPoint& firstPt, const SkPoint& midTPt,const SkPoint& lastPt);
     bool cheap_dist_exceeds_limit(const SkPoint& pt, SkScalar x, SkScalar y);
     bool cubic_too_curvy(const SkPoint pts[4]);
+
+    friend class SkPathMeasureSnapshot;
+};
+
+/** \class SkPathMeasureSnapshot
+
+    An immutable measurement of every contour of a path. Unlike SkPathMeasure, a snapshot does
+    not refer back to the path, all of its queries are const (so it may be shared across
+    threads), and snapshots of non-volatile paths are cached by the path's generation ID.
+    Use it when the same path is measured over and over, e.g. text on a path or animated dashes.
+*/
+class SK_API SkPathMeasureSnapshot : public SkNVRefCnt<SkPathMeasureSnapshot> {
+public:
+    /** Return the snapshot of path. forceClosed and resScale have the same meaning as for
+        SkPathMeasure. Unless the path is volatile, the result is shared with every other
+        caller measuring the same path (same generation ID) with the same parameters.
+    */
+    static sk_sp<SkPathMeasureSnapshot> Make(const SkPath& path, bool forceClosed,
+                                             SkScalar resScale = 1);
+
+    /** Return the number of contours with a non-zero length. */
+    int contourCount() const { return fContours.count(); }
+
+    /** Return the length of the specified contour. */
+    SkScalar getLength(int contour) const;
+
+    /** Return true if the specified contour is closed. */
+    bool isClosed(int contour) const;
+
+    /** Pins distance to 0 <= distance <= getLength(contour), and then computes the
+        corresponding position and tangent on that contour. Either output may be null.
+    */
+    void getPosTan(int contour, SkScalar distance, SkPoint* position, SkVector* tangent) const;
+
+    /** Batched version of getPosTan(). Computes positions[i] and tangents[i] for each of the
+        count distances; either output array may be null. Runs of increasing distances (the
+        common case when laying out glyphs or dashes) avoid the binary search entirely.
+    */
+    void getPosTan(int contour, const SkScalar distances[], int count,
+                   SkPoint positions[], SkVector tangents[]) const;
+
+    /** Same as SkPathMeasure::getSegment(), for the specified contour. */
+    bool getSegment(int contour, SkScalar startD, SkScalar stopD, SkPath* dst,
+                    bool startWithMoveTo) const;
+
+    size_t approximateBytesUsed() const;
+
+private:
+    SkPathMeasureSnapshot() {}
+
+    struct Contour {
+        int         fFirstSegment;
+        int         fSegmentCount;
+        SkScalar    fLength;
+        bool        fIsClosed;
+    };
+
+    // One piece of the piecewise linear distance -> t table of a line or curve.
+    // The piece ends at fDistances[] of the same index.
+    struct Segment {
+        SkScalar    fStartD;    // distance at the start of this piece
+        SkScalar    fStartT;    // curve t at the start of this piece
+        SkScalar    fTPerD;     // dt / ddistance over this piece
+        SkScalar    fStopT;
+        unsigned    fPtIndex;   // index into fPts
+        unsigned    fType;      // SkSegType
+    };
+
+    const Contour& contour(int index) const {
+        SkASSERT(index >= 0 && index < fContours.count());
+        return fContours[index];
+    }
+    int findSegment(const Contour&, SkScalar distance, int hint) const;
+    void posTan(const Segment&, SkScalar distance, SkPoint* position, SkVector* tangent) const;
+
+    SkTDArray<Contour>  fContours;
+    SkTDArray<SkScalar> fDistances;     // kept apart from fSegments to keep the search compact
+    SkTDArray<Segment>  fSegments;
+    SkTDArray<SkPoint>  fPts;
 };
 
 #endif
@@ -120,9 +120,10 @@ public:
     bool setRect(int32_t left, int32_t top, int32_t right, int32_t bottom);
 
     /**
-     *  Set this region to the union of an array of rects. This is generally
-     *  faster than calling region.op(rect, kUnion_Op) in a loop. If count is
-     *  0, then this region is set to the empty region.
+     *  Set this region to the union of an array of rects, built in a single
+     *  sweep over all of them. This is much faster than calling
+     *  region.op(rect, kUnion_Op) in a loop. If count is 0, then this region
+     *  is set to the empty region.
      *  @return true if the resulting region is non-empty
      */
     bool setRects(const SkIRect rects[], int count);
@@ -250,6 +251,18 @@ public:
 
     static const int kOpCnt = kLastOp + 1;
 
+    /**
+     *  Set this region to the union (kUnion_Op) or intersection (kIntersect_Op)
+     *  of an array of regions, built in a single sweep over all of their
+     *  scanlines rather than with count - 1 successive ops. Any other op is
+     *  applied to the regions one after another, in order. If count is 0, then
+     *  this region is set to the empty region. This region may be one of the
+     *  inputs. The sweep pays off when combining many regions; for a few large,
+     *  heavily overlapping ones, successive op() calls can be quicker.
+     *  @return true if the resulting region is non-empty
+     */
+    bool setRegions(const SkRegion* const regions[], int count, Op op);
+
     /**
      *  Set this region to the result of applying the Op to this region and the
      *  specified rectangle: this = (this op rect).
@@ -87,6 +87,18 @@ public:
       */
     bool resolve(SkPath* result);
 
+    /** Like resolve(), but suited to combining many paths with union, such as map polygons.
+        Operands are grouped into clusters whose bounds overlap; only operands in the same
+        cluster are intersected with each other, and the cluster results are concatenated.
+        If any operator is not union, or any operand is inverse filled, this is the same
+        as resolve().
+
+        @param result The product of the operands.
+        @param inParallel If true, clusters are resolved concurrently.
+        @return True if the operation succeeded.
+      */
+    bool resolveBatch(SkPath* result, bool inParallel = false);
+
 private:
     SkTArray<SkPath> fPathRefs;
     SkTDArray<SkPathOp> fOps;
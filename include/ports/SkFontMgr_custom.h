@@ -15,6 +15,11 @@ class SkFontMgr;
 /** Create a custom font manager which scans a given directory for font files. */
 SK_API SkFontMgr* SkFontMgr_New_Custom_Directory(const char* dir);
 
+/** As above, but saves what scanning the font files finds to the file at scanCachePath, so that
+ *  later font managers for the directory only need to scan files that were added or changed.
+ */
+SK_API SkFontMgr* SkFontMgr_New_Custom_Directory(const char* dir, const char* scanCachePath);
+
 /** Create a custom font manager that contains no built-in fonts. */
 SK_API SkFontMgr* SkFontMgr_New_Custom_Empty();
 
@@ -14,6 +14,21 @@ class SkXMLWriter;
 
 class SK_API SkSVGCanvas {
 public:
+    enum {
+        /**
+         *  Write each distinct set of fill and stroke attributes only once, as a CSS class in a
+         *  <style> element, and refer to it from elements with a class attribute instead of
+         *  repeating the attributes on every element.
+         */
+        kStyleClasses_Flag = 0x01,
+    };
+
+    /**
+     *  Pass as precision to write coordinates and lengths with up to 8 significant digits, as
+     *  Make() without a precision does.
+     */
+    static const int kFullPrecision = -1;
+
     /**
      *  Returns a new canvas that will generate SVG commands from its draw calls, and send
      *  them to the provided xmlwriter. Ownership of the xmlwriter is not transfered to the canvas,
@@ -26,6 +41,14 @@ public:
      *  SVG element).
      */
     static std::unique_ptr<SkCanvas> Make(const SkRect& bounds, SkXMLWriter*);
+
+    /**
+     *  As above, but coordinates and lengths are written with at most 'precision' digits after
+     *  the decimal point (clamped to [0, 9]; trailing zeros are dropped) unless precision is
+     *  kFullPrecision, and 'flags' is a combination of the flags above.
+     */
+    static std::unique_ptr<SkCanvas> Make(const SkRect& bounds, SkXMLWriter*, int precision,
+                                          uint32_t flags);
 };
 
 #endif
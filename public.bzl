@@ -435,8 +435,10 @@ DM_SRCS_ALL = struct(
     exclude = [
         "dm/DMSrcSinkAndroid.cpp",  # Android-only.
         "tests/FontMgrAndroidParserTest.cpp",  # Android-only.
+        "tests/FontMgrCustomTest.cpp",  # SkFontMgr_custom is not built.
         "tests/PathOpsSkpClipTest.cpp",  # Alternate main.
         "tests/skia_test.cpp",  # Old main.
+        "tests/ShaperTest.cpp",  # Needs HarfBuzz.
         "tests/SkpSkGrTest.cpp",  # Alternate main.
         "tests/SVGDeviceTest.cpp",
         "tools/gpu/gl/angle/*",
@@ -202,6 +202,7 @@ void SkBitmapDevice::drawRect(const SkDraw& draw, const SkRect& r, const SkPaint
 void SkBitmapDevice::drawOval(const SkDraw& draw, const SkRect& oval, const SkPaint& paint) {
     SkPath path;
     path.addOval(oval);
+    path.setIsVolatile(true);
     // call the VIRTUAL version, so any subclasses who do handle drawPath aren't
     // required to override drawOval.
     this->drawPath(draw, path, paint, nullptr, true);
@@ -212,6 +213,7 @@ void SkBitmapDevice::drawRRect(const SkDraw& draw, const SkRRect& rrect, const S
     SkPath  path;
 
     path.addRRect(rrect);
+    path.setIsVolatile(true);
     // call the VIRTUAL version, so any subclasses who do handle drawPath aren't
     // required to override drawRRect.
     this->drawPath(draw, path, paint, nullptr, true);
@@ -11,7 +11,12 @@
 #include "SkOpts.h"
 
 SkBlitMask::BlitLCD16RowProc SkBlitMask::BlitLCD16RowFactory(bool isOpaque) {
-    BlitLCD16RowProc proc = PlatformBlitRowProcs16(isOpaque);
+    BlitLCD16RowProc proc = isOpaque ? SkOpts::blit_lcd16_opaque_row : SkOpts::blit_lcd16_row;
+    if (proc) {
+        return proc;
+    }
+
+    proc = PlatformBlitRowProcs16(isOpaque);
     if (proc) {
         return proc;
     }
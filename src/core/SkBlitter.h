@@ -65,6 +65,10 @@ public:
     /// typically used for text.
     virtual void blitMask(const SkMask&, const SkIRect& clip);
 
+    /// Blit count masks, each clipped to the rect at the same index, in order. This draws the
+    /// same as calling blitMask() for each, but lets a blitter set up once for a run of glyphs.
+    virtual void blitMasks(const SkMask masks[], const SkIRect clips[], int count);
+
     /** If the blitter just sets a single value for each pixel, return the
         bitmap it draws into, and assign value. If not, return nullptr and ignore
         the value parameter.
@@ -11,6 +11,7 @@
 #include "SkUtils.h"
 #include "SkXfermodePriv.h"
 #include "SkBlitMask.h"
+#include "SkOpts.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -186,6 +187,48 @@ void SkARGB32_Blitter::blitMask(const SkMask& mask, const SkIRect& clip) {
     }
 }
 
+// A8 and LCD16 masks, which are most glyphs, are blended here with procs looked up once for all
+// of them; other formats go through blitMask().
+void SkARGB32_Blitter::blitMasks(const SkMask masks[], const SkIRect clips[], int count) {
+    if (fSrcA == 0) {
+        return;
+    }
+
+    const bool isOpaque = 0xFF == SkColorGetA(fColor);
+    const SkPMColor opaqueDst = isOpaque ? SkPreMultiplyColor(fColor) : 0;
+    SkBlitMask::BlitLCD16RowProc lcdProc = nullptr;
+    for (int i = 0; i < count; ++i) {
+        const SkMask& mask = masks[i];
+        const SkIRect& clip = clips[i];
+        SkASSERT(mask.fBounds.contains(clip));
+
+        switch (mask.fFormat) {
+            case SkMask::kA8_Format:
+                SkOpts::blit_mask_d32_a8(fDevice.writable_addr32(clip.fLeft, clip.fTop),
+                                         fDevice.rowBytes(),
+                                         mask.getAddr8(clip.fLeft, clip.fTop), mask.fRowBytes,
+                                         fColor, clip.width(), clip.height());
+                break;
+            case SkMask::kLCD16_Format: {
+                if (!lcdProc) {
+                    lcdProc = SkBlitMask::BlitLCD16RowFactory(isOpaque);
+                }
+                SkPMColor* dst = fDevice.writable_addr32(clip.fLeft, clip.fTop);
+                const uint16_t* src = mask.getAddrLCD16(clip.fLeft, clip.fTop);
+                for (int y = clip.fTop; y < clip.fBottom; ++y) {
+                    lcdProc(dst, src, fColor, clip.width(), opaqueDst);
+                    dst = (SkPMColor*)((char*)dst + fDevice.rowBytes());
+                    src = (const uint16_t*)((const char*)src + mask.fRowBytes);
+                }
+                break;
+            }
+            default:
+                this->blitMask(mask, clip);
+                break;
+        }
+    }
+}
+
 void SkARGB32_Opaque_Blitter::blitMask(const SkMask& mask,
                                        const SkIRect& clip) {
     SkASSERT(mask.fBounds.contains(clip));
@@ -6,12 +6,17 @@
  */
 
 #include "SkDistanceFieldGen.h"
+#include "SkMask.h"
+#include "SkNx.h"
 #include "SkPoint.h"
+#include "SkTaskGroup.h"
 
+// Per texel data, kept in planes so that four neighboring texels can be loaded at once.
 struct DFData {
-    float   fAlpha;      // alpha value of source texel
-    float   fDistSq;     // distance squared to nearest (so far) edge texel
-    SkPoint fDistVector; // distance vector to nearest (so far) edge texel
+    float* fAlpha;      // alpha value of source texel
+    float* fDistSq;     // distance squared to nearest (so far) edge texel
+    float* fDistX;      // distance vector to nearest (so far) edge texel
+    float* fDistY;
 };
 
 enum NeighborFlags {
@@ -63,21 +68,51 @@ static bool found_edge(const unsigned char* imagePtr, int width, int neighborFla
     return false;
 }
 
-static void init_glyph_data(DFData* data, unsigned char* edges, const unsigned char* image,
+// Returns which of the 16 pixels from imagePtr on can't be an edge, because they and all
+// their neighbors are 0, or all are >=128. All the neighbors must be inside the image.
+static Sk16b no_edges16(const unsigned char* imagePtr, int width) {
+    const int offsets[9] = {0, -1, 1, -width-1, -width, -width+1, width-1, width, width+1 };
+    Sk16b sum = 0,
+          min = 0xff;
+    for (int offset : offsets) {
+        Sk16b val = Sk16b::Load(imagePtr + offset);
+        sum = sum.saturatedAdd(val);
+        min = Sk16b::Min(min, val);
+    }
+    return (sum < 1).thenElse(0xff, (min < 128).thenElse(0, 0xff));
+}
+
+static void init_glyph_data(const DFData& data, unsigned char* edges, const unsigned char* image,
                             int dataWidth, int dataHeight,
                             int imageWidth, int imageHeight,
                             int pad) {
-    data += pad*dataWidth;
-    data += pad;
-    edges += (pad*dataWidth + pad);
-
     for (int j = 0; j < imageHeight; ++j) {
+        int dataRow = (pad + j)*dataWidth + pad;
         for (int i = 0; i < imageWidth; ++i) {
             if (255 == *image) {
-                data->fAlpha = 1.0f;
+                data.fAlpha[dataRow + i] = 1.0f;
             } else {
-                data->fAlpha = (*image)*0.00392156862f;  // 1/255
+                data.fAlpha[dataRow + i] = (*image)*0.00392156862f;  // 1/255
+            }
+            ++image;
+        }
+        image -= imageWidth;
+
+        for (int i = 0; i < imageWidth; ++i) {
+            // rule out edges sixteen pixels at a time where we can
+            if (j > 0 && j < imageHeight-1 && i > 0 && i + 16 < imageWidth) {
+                uint8_t noEdges[16];
+                no_edges16(image, imageWidth).store(noEdges);
+                for (int k = 0; k < 16; ++k) {
+                    if (!noEdges[k] && found_edge(image + k, imageWidth, kAll_NeighborFlags)) {
+                        edges[dataRow + i + k] = 255;  // using 255 makes for convenient debug rendering
+                    }
+                }
+                image += 16;
+                i += 15;
+                continue;
             }
+
             int checkMask = kAll_NeighborFlags;
             if (i == 0) {
                 checkMask &= ~(kLeft_NeighborFlag|kTopLeft_NeighborFlag|kBottomLeft_NeighborFlag);
@@ -92,14 +127,10 @@ static void init_glyph_data(DFData* data, unsigned char* edges, const unsigned c
                 checkMask &= ~(kBottomLeft_NeighborFlag|kBottom_NeighborFlag|kBottomRight_NeighborFlag);
             }
             if (found_edge(image, imageWidth, checkMask)) {
-                *edges = 255;  // using 255 makes for convenient debug rendering
+                edges[dataRow + i] = 255;  // using 255 makes for convenient debug rendering
             }
-            ++data;
             ++image;
-            ++edges;
         }
-        data += 2*pad;
-        edges += 2*pad;
     }
 }
 
@@ -145,169 +176,231 @@ static float edge_distance(const SkPoint& direction, float alpha) {
     return distance;
 }
 
-static void init_distances(DFData* data, unsigned char* edges, int width, int height) {
-    // skip one pixel border
-    DFData* currData = data;
-    DFData* prevData = data - width;
-    DFData* nextData = data + width;
-
+static void init_distances(const DFData& data, unsigned char* edges, int width, int height) {
+    const float* alpha = data.fAlpha;
     for (int j = 0; j < height; ++j) {
         for (int i = 0; i < width; ++i) {
-            if (*edges) {
+            int curr = j*width + i;
+            if (edges[curr]) {
                 // we should not be in the one-pixel outside band
                 SkASSERT(i > 0 && i < width-1 && j > 0 && j < height-1);
+                int prev = curr - width;
+                int next = curr + width;
                 // gradient will point from low to high
                 // +y is down in this case
                 // i.e., if you're outside, gradient points towards edge
                 // if you're inside, gradient points away from edge
                 SkPoint currGrad;
-                currGrad.fX = (prevData+1)->fAlpha - (prevData-1)->fAlpha
-                             + SK_ScalarSqrt2*(currData+1)->fAlpha
-                             - SK_ScalarSqrt2*(currData-1)->fAlpha
-                             + (nextData+1)->fAlpha - (nextData-1)->fAlpha;
-                currGrad.fY = (nextData-1)->fAlpha - (prevData-1)->fAlpha
-                             + SK_ScalarSqrt2*nextData->fAlpha
-                             - SK_ScalarSqrt2*prevData->fAlpha
-                             + (nextData+1)->fAlpha - (prevData+1)->fAlpha;
+                currGrad.fX = alpha[prev+1] - alpha[prev-1]
+                             + SK_ScalarSqrt2*alpha[curr+1]
+                             - SK_ScalarSqrt2*alpha[curr-1]
+                             + alpha[next+1] - alpha[next-1];
+                currGrad.fY = alpha[next-1] - alpha[prev-1]
+                             + SK_ScalarSqrt2*alpha[next]
+                             - SK_ScalarSqrt2*alpha[prev]
+                             + alpha[next+1] - alpha[prev+1];
                 currGrad.setLengthFast(1.0f);
 
                 // init squared distance to edge and distance vector
-                float dist = edge_distance(currGrad, currData->fAlpha);
-                currGrad.scale(dist, &currData->fDistVector);
-                currData->fDistSq = dist*dist;
+                float dist = edge_distance(currGrad, alpha[curr]);
+                SkPoint distVec;
+                currGrad.scale(dist, &distVec);
+                data.fDistSq[curr] = dist*dist;
+                data.fDistX[curr] = distVec.fX;
+                data.fDistY[curr] = distVec.fY;
             } else {
                 // init distance to "far away"
-                currData->fDistSq = 2000000.f;
-                currData->fDistVector.fX = 1000.f;
-                currData->fDistVector.fY = 1000.f;
+                data.fDistSq[curr] = 2000000.f;
+                data.fDistX[curr] = 1000.f;
+                data.fDistY[curr] = 1000.f;
             }
-            ++currData;
-            ++prevData;
-            ++nextData;
-            ++edges;
         }
     }
 }
 
 // Danielsson's 8SSEDT
 
-// first stage forward pass
+// Each pass below first checks the row it came from, which is already final, and then the
+// neighbor just visited in the same row. The first kind of check doesn't depend on the other
+// pixels of the current row, so those are done for four pixels at a time up front, leaving
+// only the checks along the row to be done one pixel after another.
+
+// If the distance to the nearest edge found through a neighbor is less than the one found so
+// far, take it.
+static inline void check(const DFData& data, int curr, float distSq, float distX, float distY) {
+    if (distSq < data.fDistSq[curr]) {
+        data.fDistSq[curr] = distSq;
+        data.fDistX[curr] = distX;
+        data.fDistY[curr] = distY;
+    }
+}
+
+// check() for four pixels; skips edge pixels
+static inline void check4(const Sk4f& distSq, const Sk4f& distX, const Sk4f& distY,
+                          const Sk4f& isEdge,
+                          Sk4f* currDistSq, Sk4f* currDistX, Sk4f* currDistY) {
+    Sk4f closer = isEdge.thenElse(0.0f, distSq < *currDistSq);
+    *currDistSq = closer.thenElse(distSq, *currDistSq);
+    *currDistX = closer.thenElse(distX, *currDistX);
+    *currDistY = closer.thenElse(distY, *currDistY);
+}
+
+static inline Sk4f is_edge4(const unsigned char* edge) {
+    return SkNx_cast<float>(Sk4b::Load(edge)) != 0.0f;
+}
+
+// first stage forward pass, above neighbors
 // (forward in Y, forward in X)
-static void F1(DFData* curr, int width) {
+static void F1_above(const DFData& data, int curr, int width) {
     // upper left
-    DFData* check = curr - width-1;
-    SkPoint distVec = check->fDistVector;
-    float distSq = check->fDistSq - 2.0f*(distVec.fX + distVec.fY - 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        distVec.fY -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
+    int n = curr - width-1;
+    float x = data.fDistX[n],
+          y = data.fDistY[n];
+    check(data, curr, data.fDistSq[n] - 2.0f*(x + y - 1.0f), x - 1.0f, y - 1.0f);
 
     // up
-    check = curr - width;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq - 2.0f*distVec.fY + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fY -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
+    n = curr - width;
+    x = data.fDistX[n];
+    y = data.fDistY[n];
+    check(data, curr, data.fDistSq[n] - 2.0f*y + 1.0f, x, y - 1.0f);
 
     // upper right
-    check = curr - width+1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq + 2.0f*(distVec.fX - distVec.fY + 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        distVec.fY -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
+    n = curr - width+1;
+    x = data.fDistX[n];
+    y = data.fDistY[n];
+    check(data, curr, data.fDistSq[n] + 2.0f*(x - y + 1.0f), x + 1.0f, y - 1.0f);
+}
+
+// F1_above() for four pixels
+static void F1_above4(const DFData& data, const unsigned char* edges, int curr, int width) {
+    Sk4f distSq = Sk4f::Load(data.fDistSq + curr),
+         distX  = Sk4f::Load(data.fDistX  + curr),
+         distY  = Sk4f::Load(data.fDistY  + curr);
+    Sk4f isEdge = is_edge4(edges + curr);
+
+    // upper left
+    int n = curr - width-1;
+    Sk4f x = Sk4f::Load(data.fDistX + n),
+         y = Sk4f::Load(data.fDistY + n);
+    check4(Sk4f::Load(data.fDistSq + n) - 2.0f*(x + y - 1.0f), x - 1.0f, y - 1.0f,
+           isEdge, &distSq, &distX, &distY);
+
+    // up
+    n = curr - width;
+    x = Sk4f::Load(data.fDistX + n);
+    y = Sk4f::Load(data.fDistY + n);
+    check4(Sk4f::Load(data.fDistSq + n) - 2.0f*y + 1.0f, x, y - 1.0f,
+           isEdge, &distSq, &distX, &distY);
+
+    // upper right
+    n = curr - width+1;
+    x = Sk4f::Load(data.fDistX + n);
+    y = Sk4f::Load(data.fDistY + n);
+    check4(Sk4f::Load(data.fDistSq + n) + 2.0f*(x - y + 1.0f), x + 1.0f, y - 1.0f,
+           isEdge, &distSq, &distX, &distY);
+
+    distSq.store(data.fDistSq + curr);
+    distX.store(data.fDistX + curr);
+    distY.store(data.fDistY + curr);
+}
 
+// first stage forward pass, left neighbor
+// (forward in Y, forward in X)
+static void F1_left(const DFData& data, int curr) {
     // left
-    check = curr - 1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq - 2.0f*distVec.fX + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
+    int n = curr - 1;
+    float x = data.fDistX[n];
+    check(data, curr, data.fDistSq[n] - 2.0f*x + 1.0f, x - 1.0f, data.fDistY[n]);
 }
 
 // second stage forward pass
 // (forward in Y, backward in X)
-static void F2(DFData* curr, int width) {
+static void F2(const DFData& data, int curr) {
     // right
-    DFData* check = curr + 1;
-    SkPoint distVec = check->fDistVector;
-    float distSq = check->fDistSq + 2.0f*distVec.fX + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
+    int n = curr + 1;
+    float x = data.fDistX[n];
+    check(data, curr, data.fDistSq[n] + 2.0f*x + 1.0f, x + 1.0f, data.fDistY[n]);
 }
 
 // first stage backward pass
 // (backward in Y, forward in X)
-static void B1(DFData* curr, int width) {
+static void B1(const DFData& data, int curr) {
     // left
-    DFData* check = curr - 1;
-    SkPoint distVec = check->fDistVector;
-    float distSq = check->fDistSq - 2.0f*distVec.fX + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
+    int n = curr - 1;
+    float x = data.fDistX[n];
+    check(data, curr, data.fDistSq[n] - 2.0f*x + 1.0f, x - 1.0f, data.fDistY[n]);
 }
 
-// second stage backward pass
+// second stage backward pass, below neighbors
 // (backward in Y, backwards in X)
-static void B2(DFData* curr, int width) {
-    // right
-    DFData* check = curr + 1;
-    SkPoint distVec = check->fDistVector;
-    float distSq = check->fDistSq + 2.0f*distVec.fX + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
+static void B2_below(const DFData& data, int curr, int width) {
+    // bottom left
+    int n = curr + width-1;
+    float x = data.fDistX[n],
+          y = data.fDistY[n];
+    check(data, curr, data.fDistSq[n] - 2.0f*(x - y - 1.0f), x - 1.0f, y + 1.0f);
+
+    // bottom
+    n = curr + width;
+    x = data.fDistX[n];
+    y = data.fDistY[n];
+    check(data, curr, data.fDistSq[n] + 2.0f*y + 1.0f, x, y + 1.0f);
+
+    // bottom right
+    n = curr + width+1;
+    x = data.fDistX[n];
+    y = data.fDistY[n];
+    check(data, curr, data.fDistSq[n] + 2.0f*(x + y + 1.0f), x + 1.0f, y + 1.0f);
+}
+
+// B2_below() for four pixels
+static void B2_below4(const DFData& data, const unsigned char* edges, int curr, int width) {
+    Sk4f distSq = Sk4f::Load(data.fDistSq + curr),
+         distX  = Sk4f::Load(data.fDistX  + curr),
+         distY  = Sk4f::Load(data.fDistY  + curr);
+    Sk4f isEdge = is_edge4(edges + curr);
 
     // bottom left
-    check = curr + width-1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq - 2.0f*(distVec.fX - distVec.fY - 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX -= 1.0f;
-        distVec.fY += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
+    int n = curr + width-1;
+    Sk4f x = Sk4f::Load(data.fDistX + n),
+         y = Sk4f::Load(data.fDistY + n);
+    check4(Sk4f::Load(data.fDistSq + n) - 2.0f*(x - y - 1.0f), x - 1.0f, y + 1.0f,
+           isEdge, &distSq, &distX, &distY);
 
     // bottom
-    check = curr + width;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq + 2.0f*distVec.fY + 1.0f;
-    if (distSq < curr->fDistSq) {
-        distVec.fY += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
-    }
+    n = curr + width;
+    x = Sk4f::Load(data.fDistX + n);
+    y = Sk4f::Load(data.fDistY + n);
+    check4(Sk4f::Load(data.fDistSq + n) + 2.0f*y + 1.0f, x, y + 1.0f,
+           isEdge, &distSq, &distX, &distY);
 
     // bottom right
-    check = curr + width+1;
-    distVec = check->fDistVector;
-    distSq = check->fDistSq + 2.0f*(distVec.fX + distVec.fY + 1.0f);
-    if (distSq < curr->fDistSq) {
-        distVec.fX += 1.0f;
-        distVec.fY += 1.0f;
-        curr->fDistSq = distSq;
-        curr->fDistVector = distVec;
+    n = curr + width+1;
+    x = Sk4f::Load(data.fDistX + n);
+    y = Sk4f::Load(data.fDistY + n);
+    check4(Sk4f::Load(data.fDistSq + n) + 2.0f*(x + y + 1.0f), x + 1.0f, y + 1.0f,
+           isEdge, &distSq, &distX, &distY);
+
+    distSq.store(data.fDistSq + curr);
+    distX.store(data.fDistX + curr);
+    distY.store(data.fDistY + curr);
+}
+
+// second stage backward pass, right neighbor
+// (backward in Y, backwards in X)
+// The right neighbor is checked before the ones below, so where it ties with the closest of
+// those it wins, unless that closest one is the pixel's own distance from before
+// B2_below() (prevDistSq).
+static void B2_right(const DFData& data, int curr, float prevDistSq) {
+    // right
+    int n = curr + 1;
+    float x = data.fDistX[n];
+    float distSq = data.fDistSq[n] + 2.0f*x + 1.0f;
+    if (distSq < data.fDistSq[curr] ||
+        (distSq == data.fDistSq[curr] && data.fDistSq[curr] != prevDistSq)) {
+        data.fDistSq[curr] = distSq;
+        data.fDistX[curr] = x + 1.0f;
+        data.fDistY[curr] = data.fDistY[n];
     }
 }
 
@@ -347,92 +440,104 @@ static bool generate_distance_field_from_image(unsigned char* distanceField,
     // set params for distance field data
     int dataWidth = width + 2*pad;
     int dataHeight = height + 2*pad;
-
-    // create zeroed temp DFData+edge storage
-    SkAutoFree storage(sk_calloc_throw(dataWidth*dataHeight*(sizeof(DFData) + 1)));
-    DFData*        dataPtr = (DFData*)storage.get();
-    unsigned char* edgePtr = (unsigned char*)storage.get() + dataWidth*dataHeight*sizeof(DFData);
+    int dataCount = dataWidth*dataHeight;
+
+    // create zeroed temp DFData+edge storage, and a row of distances for B2_right()
+    SkAutoFree storage(sk_calloc_throw((4*dataCount + dataWidth)*sizeof(float) + dataCount));
+    DFData data;
+    data.fAlpha  = (float*)storage.get();
+    data.fDistSq = data.fAlpha  + dataCount;
+    data.fDistX  = data.fDistSq + dataCount;
+    data.fDistY  = data.fDistX  + dataCount;
+    float*         prevDistSq = data.fDistY + dataCount;
+    unsigned char* edges = (unsigned char*)(prevDistSq + dataWidth);
 
     // copy glyph into distance field storage
-    init_glyph_data(dataPtr, edgePtr, copyPtr,
+    init_glyph_data(data, edges, copyPtr,
                     dataWidth, dataHeight,
                     width+2, height+2, SK_DistanceFieldPad);
 
     // create initial distance data, particularly at edges
-    init_distances(dataPtr, edgePtr, dataWidth, dataHeight);
+    init_distances(data, edges, dataWidth, dataHeight);
 
     // now perform Euclidean distance transform to propagate distances
 
+    // each scan covers this many pixels
+    const int count = dataWidth-2;
+
     // forwards in y
-    DFData* currData = dataPtr+dataWidth+1; // skip outer buffer
-    unsigned char* currEdge = edgePtr+dataWidth+1;
     for (int j = 1; j < dataHeight-1; ++j) {
-        // forwards in x
-        for (int i = 1; i < dataWidth-1; ++i) {
+        int row = j*dataWidth + 1; // skip outer buffer
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            F1_above4(data, edges, row + i, dataWidth);
+        }
+        for (; i < count; ++i) {
             // don't need to calculate distance for edge pixels
-            if (!*currEdge) {
-                F1(currData, dataWidth);
+            if (!edges[row + i]) {
+                F1_above(data, row + i, dataWidth);
             }
-            ++currData;
-            ++currEdge;
         }
 
-        // backwards in x
-        --currData; // reset to end
-        --currEdge;
-        for (int i = 1; i < dataWidth-1; ++i) {
-            // don't need to calculate distance for edge pixels
-            if (!*currEdge) {
-                F2(currData, dataWidth);
+        // forwards in x
+        for (i = 0; i < count; ++i) {
+            if (!edges[row + i]) {
+                F1_left(data, row + i);
             }
-            --currData;
-            --currEdge;
         }
 
-        currData += dataWidth+1;
-        currEdge += dataWidth+1;
+        // backwards in x
+        for (i = count-1; i >= 0; --i) {
+            if (!edges[row + i]) {
+                F2(data, row + i);
+            }
+        }
     }
 
     // backwards in y
-    currData = dataPtr+dataWidth*(dataHeight-2) - 1; // skip outer buffer
-    currEdge = edgePtr+dataWidth*(dataHeight-2) - 1;
-    for (int j = 1; j < dataHeight-1; ++j) {
+    // Each of these scans starts on the last pixel of the row above (and so stops two short of
+    // the end of its row); fields have always been generated this way.
+    for (int j = dataHeight-2; j > 0; --j) {
+        int row = j*dataWidth - 1;
         // forwards in x
-        for (int i = 1; i < dataWidth-1; ++i) {
+        int i;
+        for (i = 0; i < count; ++i) {
             // don't need to calculate distance for edge pixels
-            if (!*currEdge) {
-                B1(currData, dataWidth);
+            if (!edges[row + i]) {
+                B1(data, row + i);
             }
-            ++currData;
-            ++currEdge;
         }
 
-        // backwards in x
-        --currData; // reset to end
-        --currEdge;
-        for (int i = 1; i < dataWidth-1; ++i) {
-            // don't need to calculate distance for edge pixels
-            if (!*currEdge) {
-                B2(currData, dataWidth);
+        memcpy(prevDistSq, data.fDistSq + row, count*sizeof(float));
+        for (i = 0; i + 4 <= count; i += 4) {
+            B2_below4(data, edges, row + i, dataWidth);
+        }
+        for (; i < count; ++i) {
+            if (!edges[row + i]) {
+                B2_below(data, row + i, dataWidth);
             }
-            --currData;
-            --currEdge;
         }
 
-        currData -= dataWidth-1;
-        currEdge -= dataWidth-1;
+        // backwards in x
+        for (i = count-1; i >= 0; --i) {
+            if (!edges[row + i]) {
+                B2_right(data, row + i, prevDistSq[i]);
+            }
+        }
     }
 
     // copy results to final distance field data
-    currData = dataPtr + dataWidth+1;
-    currEdge = edgePtr + dataWidth+1;
+    // This stays scalar: vector square roots and divides are estimates on some CPUs (ARMv7 NEON),
+    // and the field must not depend on which one it was generated on.
     unsigned char *dfPtr = distanceField;
     for (int j = 1; j < dataHeight-1; ++j) {
-        for (int i = 1; i < dataWidth-1; ++i) {
+        int row = j*dataWidth + 1;
+        for (int i = 0; i < count; ++i) {
+            int curr = row + i;
 #if DUMP_EDGE
-            float alpha = currData->fAlpha;
+            float alpha = data.fAlpha[curr];
             float edge = 0.0f;
-            if (*currEdge) {
+            if (edges[curr]) {
                 edge = 0.25f;
             }
             // blend with original image
@@ -441,18 +546,14 @@ static bool generate_distance_field_from_image(unsigned char* distanceField,
             *dfPtr++ = val;
 #else
             float dist;
-            if (currData->fAlpha > 0.5f) {
-                dist = -SkScalarSqrt(currData->fDistSq);
+            if (data.fAlpha[curr] > 0.5f) {
+                dist = -SkScalarSqrt(data.fDistSq[curr]);
             } else {
-                dist = SkScalarSqrt(currData->fDistSq);
+                dist = SkScalarSqrt(data.fDistSq[curr]);
             }
             *dfPtr++ = pack_distance_field_val<SK_DistanceFieldMagnitude>(dist);
 #endif
-            ++currData;
-            ++currEdge;
         }
-        currData += 2;
-        currEdge += 2;
     }
 
     return true;
@@ -519,3 +620,26 @@ bool SkGenerateDistanceFieldFromBWImage(unsigned char* distanceField,
 
     return generate_distance_field_from_image(distanceField, copyPtr, width, height);
 }
+
+bool SkGenerateDistanceFieldsFromMasks(unsigned char* const distanceFields[],
+                                       const SkMask masks[], int count) {
+    for (int i = 0; i < count; ++i) {
+        if (SkMask::kA8_Format != masks[i].fFormat && SkMask::kBW_Format != masks[i].fFormat) {
+            return false;
+        }
+    }
+
+    SkTaskGroup().batch(count, [&](int i) {
+        const SkMask& mask = masks[i];
+        if (SkMask::kA8_Format == mask.fFormat) {
+            SkGenerateDistanceFieldFromA8Image(distanceFields[i], mask.fImage,
+                                               mask.fBounds.width(), mask.fBounds.height(),
+                                               mask.fRowBytes);
+        } else {
+            SkGenerateDistanceFieldFromBWImage(distanceFields[i], mask.fImage,
+                                               mask.fBounds.width(), mask.fBounds.height(),
+                                               mask.fRowBytes);
+        }
+    });
+    return true;
+}
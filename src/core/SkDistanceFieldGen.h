@@ -9,6 +9,8 @@
 
 #include "SkTypes.h"
 
+struct SkMask;
+
 // the max magnitude for the distance field
 // distance values are limited to the range (-SK_DistanceFieldMagnitude, SK_DistanceFieldMagnitude]
 #define SK_DistanceFieldMagnitude   4
@@ -51,6 +53,18 @@ bool SkGenerateDistanceFieldFromBWImage(unsigned char* distanceField,
                                         const unsigned char* image,
                                         int w, int h, size_t rowBytes);
 
+/** Generate the distance fields of many A8 or BW masks, spread across SkTaskGroup threads.
+ *  Each field is the same as the single image functions above generate.
+
+ *  @param distanceFields    The distance fields to be generated, one per mask. Each should
+ *                           already be allocated by the client with the padding above.
+ *  @param masks             A8 or BW masks we're using to generate the distance fields.
+ *  @param count             Number of masks.
+ *  @return                  false, with no fields generated, if a mask is in another format.
+ */
+bool SkGenerateDistanceFieldsFromMasks(unsigned char* const distanceFields[],
+                                       const SkMask masks[], int count);
+
 /** Given width and height of original image, return size (in bytes) of distance field
  *  @param w                 Width of the original image.
  *  @param h                 Height of the original image.
@@ -11,10 +11,12 @@
 #include "SkBlitter.h"
 #include "SkCanvas.h"
 #include "SkColorPriv.h"
+#include "SkDashPathPriv.h"
 #include "SkDevice.h"
 #include "SkDeviceLooper.h"
 #include "SkFindAndPlaceGlyph.h"
 #include "SkFixed.h"
+#include "SkMaskCache.h"
 #include "SkMaskFilter.h"
 #include "SkMatrix.h"
 #include "SkPaint.h"
@@ -28,7 +30,10 @@
 #include "SkString.h"
 #include "SkStroke.h"
 #include "SkStrokeRec.h"
+#include "SkTArray.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
+#include "SkTextBlobRunIterator.h"
 #include "SkTextMapStateProc.h"
 #include "SkTLazy.h"
 #include "SkUtils.h"
@@ -996,6 +1001,7 @@ DRAW_PATH:
     // Now fall back to the default case of using a path.
     SkPath path;
     path.addRRect(rrect);
+    path.setIsVolatile(true);
     this->drawPath(path, paint, nullptr, true);
 }
 
@@ -1013,6 +1019,55 @@ SkScalar SkDraw::ComputeResScaleForStroking(const SkMatrix& matrix) {
     return 1;
 }
 
+static bool anti_fill_path_in_bands(const SkPath& devPath, const SkRasterClip& rc,
+                                    const SkPixmap& dst, const SkMatrix& matrix,
+                                    const SkPaint& paint, bool drawCoverage, int maxBandCount) {
+    int bandCount = SkScan::CountAntiFillBands(devPath, rc, maxBandCount);
+    if (bandCount <= 1) {
+        return false;
+    }
+    // Blitters are chosen up front since choosing may touch shared caches. Each band only
+    // writes its own destination rows, so the bands never overlap.
+    SkAutoTArray<SkAutoBlitterChoose> blitterStorage(bandCount);
+    SkAutoTArray<SkBlitter*> blitters(bandCount);
+    for (int index = 0; index < bandCount; ++index) {
+        blitterStorage[index].choose(dst, matrix, paint, drawCoverage);
+        blitters[index] = blitterStorage[index].get();
+    }
+    SkScan::AntiFillPathInBands(devPath, rc, blitters.get(), bandCount);
+    return true;
+}
+
+typedef void (*ScanPathProc)(const SkPath&, const SkRasterClip&, SkBlitter*);
+
+static ScanPathProc choose_hair_path_proc(const SkPaint& paint) {
+    if (paint.isAntiAlias()) {
+        switch (paint.getStrokeCap()) {
+            case SkPaint::kButt_Cap:
+                return SkScan::AntiHairPath;
+            case SkPaint::kSquare_Cap:
+                return SkScan::AntiHairSquarePath;
+            case SkPaint::kRound_Cap:
+                return SkScan::AntiHairRoundPath;
+            default:
+                SkDEBUGFAIL("unknown paint cap type");
+                return SkScan::AntiHairPath;
+        }
+    } else {
+        switch (paint.getStrokeCap()) {
+            case SkPaint::kButt_Cap:
+                return SkScan::HairPath;
+            case SkPaint::kSquare_Cap:
+                return SkScan::HairSquarePath;
+            case SkPaint::kRound_Cap:
+                return SkScan::HairRoundPath;
+            default:
+                SkDEBUGFAIL("unknown paint cap type");
+                return SkScan::HairPath;
+        }
+    }
+}
+
 void SkDraw::drawDevPath(const SkPath& devPath, const SkPaint& paint, bool drawCoverage,
                          SkBlitter* customBlitter, bool doFill) const {
     // Do a conservative quick-reject test, since a looper or other modifier may have moved us
@@ -1036,6 +1091,13 @@ void SkDraw::drawDevPath(const SkPath& devPath, const SkPaint& paint, bool drawC
         }
     }
 
+    if (doFill && paint.isAntiAlias() && !paint.getMaskFilter() && !customBlitter &&
+            !devPath.isInverseFillType() &&
+            anti_fill_path_in_bands(devPath, *fRC, fDst, *fMatrix, paint, drawCoverage,
+                                    fAAFillBands ? fAAFillBands : gSkAAFillBands.load())) {
+        return;
+    }
+
     SkBlitter* blitter = nullptr;
     SkAutoBlitterChoose blitterStorage;
     if (nullptr == customBlitter) {
@@ -1053,7 +1115,7 @@ void SkDraw::drawDevPath(const SkPath& devPath, const SkPaint& paint, bool drawC
         }
     }
 
-    void (*proc)(const SkPath&, const SkRasterClip&, SkBlitter*);
+    ScanPathProc proc;
     if (doFill) {
         if (paint.isAntiAlias()) {
             proc = SkScan::AntiFillPath;
@@ -1061,41 +1123,216 @@ void SkDraw::drawDevPath(const SkPath& devPath, const SkPaint& paint, bool drawC
             proc = SkScan::FillPath;
         }
     } else {    // hairline
-        if (paint.isAntiAlias()) {
-            switch (paint.getStrokeCap()) {
-                case SkPaint::kButt_Cap:
-                    proc = SkScan::AntiHairPath;
-                    break;
-                case SkPaint::kSquare_Cap:
-                    proc = SkScan::AntiHairSquarePath;
-                    break;
-                case SkPaint::kRound_Cap:
-                    proc = SkScan::AntiHairRoundPath;
-                    break;
-                default:
-                    proc SK_INIT_TO_AVOID_WARNING;
-                    SkDEBUGFAIL("unknown paint cap type");
-            }
-        } else {
-            switch (paint.getStrokeCap()) {
-                case SkPaint::kButt_Cap:
-                    proc = SkScan::HairPath;
-                    break;
-                case SkPaint::kSquare_Cap:
-                    proc = SkScan::HairSquarePath;
-                    break;
-                case SkPaint::kRound_Cap:
-                    proc = SkScan::HairRoundPath;
-                    break;
-                default:
-                    proc SK_INIT_TO_AVOID_WARNING;
-                    SkDEBUGFAIL("unknown paint cap type");
-            }
-        }
+        proc = choose_hair_path_proc(paint);
     }
     proc(devPath, *fRC, blitter);
 }
 
+struct DashedHairlineRec {
+    const SkMatrix*     fMatrix;
+    const SkRasterClip* fRC;
+    SkBlitter*          fBlitter;
+    ScanPathProc        fProc;
+};
+
+static void draw_hairline_dashes(SkPath* dashes, void* ctx) {
+    const DashedHairlineRec* rec = static_cast<const DashedHairlineRec*>(ctx);
+    dashes->transform(*rec->fMatrix);
+    rec->fProc(*dashes, *rec->fRC, rec->fBlitter);
+}
+
+bool SkDraw::drawDashedHairline(const SkPath& path, const SkPaint& paint, bool drawCoverage,
+                                SkBlitter* customBlitter) const {
+    SkPathEffect* pathEffect = paint.getPathEffect();
+    if (!pathEffect || SkPaint::kStroke_Style != paint.getStyle() || paint.getStrokeWidth() ||
+            paint.getMaskFilter() || paint.getRasterizer() || path.isInverseFillType() ||
+            fMatrix->hasPerspective()) {
+        return false;
+    }
+    SkPathEffect::DashInfo info;
+    if (SkPathEffect::kDash_DashType != pathEffect->asADash(&info)) {
+        return false;
+    }
+    SkAutoSTMalloc<8, SkScalar> intervals(info.fCount);
+    info.fIntervals = intervals.get();
+    pathEffect->asADash(&info);
+
+    SkRect cullRect;
+    const SkRect* cullRectPtr = nullptr;
+    if (this->computeConservativeLocalClipBounds(&cullRect)) {
+        cullRectPtr = &cullRect;
+    }
+    SkStrokeRec rec(paint, ComputeResScaleForStroking(*fMatrix));
+
+    SkAutoBlitterChoose blitterStorage;
+    DashedHairlineRec dashRec;
+    dashRec.fMatrix = fMatrix;
+    dashRec.fRC = fRC;
+    dashRec.fProc = choose_hair_path_proc(paint);
+    if (customBlitter) {
+        dashRec.fBlitter = customBlitter;
+    } else {
+        blitterStorage.choose(fDst, *fMatrix, paint, drawCoverage);
+        dashRec.fBlitter = blitterStorage.get();
+    }
+    return SkDashPath::VisitHairlineDashes(path, rec, cullRectPtr, info, draw_hairline_dashes,
+                                           &dashRec);
+}
+
+namespace {
+// Passes every call through to the device blitter. Small paths reach the device as a single A8
+// mask covering their bounds; that mask is copied so a repeat of the draw can blit it again
+// without scan converting. Any other call means the draw can't be replayed from a mask.
+class SkMaskCaptureBlitter : public SkBlitter {
+public:
+    SkMaskCaptureBlitter(SkBlitter* blitter) : fBlitter(blitter), fData(nullptr), fFailed(false) {}
+    ~SkMaskCaptureBlitter() override {
+        if (fData) {
+            fData->unref();
+        }
+    }
+
+    void blitH(int x, int y, int width) override {
+        this->fail();
+        fBlitter->blitH(x, y, width);
+    }
+    void blitAntiH(int x, int y, const SkAlpha antialias[], const int16_t runs[]) override {
+        this->fail();
+        fBlitter->blitAntiH(x, y, antialias, runs);
+    }
+    void blitV(int x, int y, int height, SkAlpha alpha) override {
+        this->fail();
+        fBlitter->blitV(x, y, height, alpha);
+    }
+    void blitRect(int x, int y, int width, int height) override {
+        this->fail();
+        fBlitter->blitRect(x, y, width, height);
+    }
+    void blitAntiRect(int x, int y, int width, int height,
+                      SkAlpha leftAlpha, SkAlpha rightAlpha) override {
+        this->fail();
+        fBlitter->blitAntiRect(x, y, width, height, leftAlpha, rightAlpha);
+    }
+    void blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) override {
+        this->fail();
+        fBlitter->blitAntiH2(x, y, a0, a1);
+    }
+    void blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) override {
+        this->fail();
+        fBlitter->blitAntiV2(x, y, a0, a1);
+    }
+    void blitMasks(const SkMask masks[], const SkIRect clips[], int count) override {
+        this->fail();
+        fBlitter->blitMasks(masks, clips, count);
+    }
+    void blitMask(const SkMask& mask, const SkIRect& clip) override {
+        fBlitter->blitMask(mask, clip);
+        if (fData || fFailed || SkMask::kA8_Format != mask.fFormat || clip != mask.fBounds) {
+            this->fail();
+            return;
+        }
+        fMask = mask;
+        fMask.fRowBytes = mask.fBounds.width();
+        fData = SkResourceCache::NewCachedData(fMask.computeImageSize());
+        if (!fData) {
+            fFailed = true;
+            return;
+        }
+        fMask.fImage = (uint8_t*)fData->writable_data();
+        for (int y = 0; y < mask.fBounds.height(); ++y) {
+            memcpy(fMask.fImage + y * fMask.fRowBytes, mask.fImage + y * mask.fRowBytes,
+                   fMask.fRowBytes);
+        }
+    }
+    const SkPixmap* justAnOpaqueColor(uint32_t* value) override {
+        return fBlitter->justAnOpaqueColor(value);
+    }
+    int requestRowsPreserved() const override {
+        return fBlitter->requestRowsPreserved();
+    }
+    void* allocBlitMemory(size_t sz) override {
+        return fBlitter->allocBlitMemory(sz);
+    }
+
+    // Returns the captured mask's data, owned by the caller, or null.
+    SkCachedData* detachMask(SkMask* mask) {
+        SkCachedData* data = fData;
+        fData = nullptr;
+        *mask = fMask;
+        return data;
+    }
+
+private:
+    void fail() {
+        fFailed = true;
+        if (fData) {
+            fData->unref();
+            fData = nullptr;
+        }
+    }
+
+    SkBlitter*      fBlitter;
+    SkMask          fMask;
+    SkCachedData*   fData;
+    bool            fFailed;
+};
+}
+
+// Small paths are the ones the scan converter hands over as a mask; see MaskSuperBlitter.
+static bool fits_path_mask(const SkIRect& bounds) {
+    return bounds.width() <= 32 && (int64_t)SkAlign4(bounds.width()) * bounds.height() <= 1024;
+}
+
+// Cached path masks are relative to the whole pixel part of the translate, so one mask serves a
+// path drawn anywhere at the same subpixel offset.
+static SkIPoint path_mask_origin(const SkMatrix& matrix) {
+    return SkIPoint::Make(SkScalarFloorToInt(matrix.getTranslateX()),
+                          SkScalarFloorToInt(matrix.getTranslateY()));
+}
+
+bool SkDraw::drawCachedPathMask(const SkPath& path, const SkMatrix& matrix,
+                                const SkPaint& paint, bool* captureMask) const {
+    *captureMask = false;
+    if (!paint.isAntiAlias() || paint.getMaskFilter() || paint.getPathEffect() ||
+            paint.getRasterizer() || !paint.canComputeFastBounds() || path.isVolatile() ||
+            path.isInverseFillType() || matrix.hasPerspective()) {
+        return false;
+    }
+    // Hairlines blend overlapping segments separately, which a single mask can't reproduce.
+    if (SkPaint::kFill_Style != paint.getStyle() && 0 == paint.getStrokeWidth()) {
+        return false;
+    }
+    // A mask replays the draw exactly only if the clip didn't change how it was scan converted.
+    if (!fRC->isBW() || !fRC->isRect()) {
+        return false;
+    }
+    SkRect storage, devBounds;
+    matrix.mapRect(&devBounds, paint.computeFastBounds(path.getBounds(), &storage));
+    if (!devBounds.isFinite() || !fRC->getBounds().contains(devBounds.roundOut()) ||
+            !fits_path_mask(devBounds.roundOut())) {
+        return false;
+    }
+    // Past this, the translate has no fractional part to key on, and its floor may not fit.
+    static const SkScalar kMaxTranslate = 1 << 22;
+    if (SkScalarAbs(matrix.getTranslateX()) > kMaxTranslate ||
+            SkScalarAbs(matrix.getTranslateY()) > kMaxTranslate) {
+        return false;
+    }
+
+    SkMask mask;
+    SkCachedData* data = SkMaskCache::FindAndRef(path, matrix, paint, &mask);
+    if (!data) {
+        *captureMask = SkMaskCache::NotePathDraw(path, matrix, paint);
+        return false;
+    }
+    SkIPoint origin = path_mask_origin(matrix);
+    mask.fBounds.offset(origin.fX, origin.fY);
+    SkAutoBlitterChoose blitter(fDst, *fMatrix, paint);
+    blitter->blitMask(mask, mask.fBounds);
+    data->unref();
+    return true;
+}
+
 void SkDraw::drawPath(const SkPath& origSrcPath, const SkPaint& origPaint,
                       const SkMatrix* prePathMatrix, bool pathIsMutable,
                       bool drawCoverage, SkBlitter* customBlitter) const {
@@ -1158,6 +1395,16 @@ void SkDraw::drawPath(const SkPath& origSrcPath, const SkPaint& origPaint,
         }
     }
 
+    bool captureMask = false;
+    if (!drawCoverage && !customBlitter &&
+            this->drawCachedPathMask(*pathPtr, *matrix, *paint, &captureMask)) {
+        return;
+    }
+
+    if (this->drawDashedHairline(*pathPtr, *paint, drawCoverage, customBlitter)) {
+        return;
+    }
+
     if (paint->getPathEffect() || paint->getStyle() != SkPaint::kFill_Style) {
         SkRect cullRect;
         const SkRect* cullRectPtr = nullptr;
@@ -1180,12 +1427,27 @@ void SkDraw::drawPath(const SkPath& origSrcPath, const SkPaint& origPaint,
         return;
     }
 
-    // avoid possibly allocating a new path in transform if we can
-    SkPath* devPathPtr = pathIsMutable ? pathPtr : &tmpPath;
+    // avoid possibly allocating a new path in transform if we can, unless the source path
+    // is still needed to key a captured mask
+    SkPath* devPathPtr = pathIsMutable && !captureMask ? pathPtr : &tmpPath;
 
     // transform the path into device space
     pathPtr->transform(*matrix, devPathPtr);
 
+    if (captureMask) {
+        SkAutoBlitterChoose blitterStorage(fDst, *fMatrix, *paint);
+        SkMaskCaptureBlitter capture(blitterStorage.get());
+        this->drawDevPath(*devPathPtr, *paint, false, &capture, doFill);
+        SkMask mask;
+        if (SkCachedData* data = capture.detachMask(&mask)) {
+            SkIPoint origin = path_mask_origin(*matrix);
+            mask.fBounds.offset(-origin.fX, -origin.fY);
+            SkMaskCache::Add(origSrcPath, *matrix, *paint, mask, data);
+            data->unref();
+        }
+        return;
+    }
+
     this->drawDevPath(*devPathPtr, *paint, drawCoverage, customBlitter, doFill);
 }
 
@@ -1467,18 +1729,80 @@ void SkDraw::drawText_asPaths(const char text[], size_t byteLength,
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Bilinearly resample a glyph image, scaled by scale about origin, into dst, which covers bounds
+// and has bytesPerPixel channels per pixel. Unscaled, the image's top left would be at
+// origin + (glyph.fLeft, glyph.fTop). storage is scratch space.
+static void scale_glyph_image(const SkGlyph& glyph, const uint8_t* src, int bytesPerPixel,
+                              SkPoint origin, SkScalar scale, const SkIRect& bounds,
+                              uint8_t* dst, SkAutoSMalloc<1024>* storage) {
+    // Copy the image with a border of transparent pixels, so that every sample is in it: bounds
+    // reaches at most a pixel past the scaled image, which is less than two unscaled.
+    const int kBorder = 2;
+    const int paddedWidth = glyph.fWidth + 2 * kBorder;
+    const int paddedHeight = glyph.fHeight + 2 * kBorder;
+    const size_t paddedRowBytes = paddedWidth * bytesPerPixel;
+    const int dstWidth = bounds.width();
+    uint8_t* padded = (uint8_t*)storage->reset(paddedRowBytes * paddedHeight +
+                                               dstWidth * (sizeof(int) + sizeof(unsigned)));
+    memset(padded, 0, paddedRowBytes * paddedHeight);
+    for (int y = 0; y < glyph.fHeight; ++y) {
+        memcpy(padded + (y + kBorder) * paddedRowBytes + kBorder * bytesPerPixel,
+               src + y * glyph.rowBytes(), glyph.fWidth * bytesPerPixel);
+    }
+
+    // Find the pair of columns each destination column samples, and the weight of the second
+    // as 8 bit fixed point.
+    int* columns = (int*)(padded + paddedRowBytes * paddedHeight);
+    unsigned* columnWeights = (unsigned*)(columns + dstWidth);
+    const SkScalar invScale = SkScalarInvert(scale);
+    auto sample = [invScale](int x, SkScalar origin, int offset, int size, unsigned* weight) {
+        SkScalar u = (x + 0.5f - origin) * invScale - offset - 0.5f + kBorder;
+        int i = SkTPin(SkScalarFloorToInt(u), 0, size - 2);
+        *weight = SkTPin(SkScalarRoundToInt((u - i) * 256), 0, 256);
+        return i;
+    };
+    for (int x = 0; x < dstWidth; ++x) {
+        columns[x] = sample(bounds.fLeft + x, origin.fX, glyph.fLeft, paddedWidth,
+                            &columnWeights[x]) * bytesPerPixel;
+    }
+
+    for (int y = bounds.fTop; y < bounds.fBottom; ++y) {
+        unsigned wy;
+        int j = sample(y, origin.fY, glyph.fTop, paddedHeight, &wy);
+        const uint8_t* above = padded + j * paddedRowBytes;
+        const uint8_t* below = above + paddedRowBytes;
+        for (int x = 0; x < dstWidth; ++x) {
+            const unsigned wx = columnWeights[x];
+            const uint8_t* a = above + columns[x];
+            const uint8_t* b = below + columns[x];
+            for (int c = 0; c < bytesPerPixel; ++c) {
+                unsigned top    = a[c] * (256 - wx) + a[c + bytesPerPixel] * wx;
+                unsigned bottom = b[c] * (256 - wx) + b[c + bytesPerPixel] * wx;
+                *dst++ = (uint8_t)((top * (256 - wy) + bottom * wy + (1 << 15)) >> 16);
+            }
+        }
+    }
+}
+
 class DrawOneGlyph {
 public:
-    DrawOneGlyph(const SkDraw& draw, const SkPaint& paint, SkGlyphCache* cache, SkBlitter* blitter)
+    // Glyph images are scaled by glyphScale when the glyphs come from a strike shared with other
+    // text sizes; see SkGlyphCache::ShouldShareStrike().
+    DrawOneGlyph(const SkDraw& draw, const SkPaint& paint, SkGlyphCache* cache, SkBlitter* blitter,
+                 SkScalar glyphScale = 1)
         : fUseRegionToDraw(UsingRegionToDraw(draw.fRC))
         , fGlyphCache(cache)
         , fBlitter(blitter)
         , fClip(fUseRegionToDraw ? &draw.fRC->bwRgn() : nullptr)
         , fDraw(draw)
         , fPaint(paint)
-        , fClipBounds(PickClipBounds(draw)) { }
+        , fClipBounds(PickClipBounds(draw))
+        , fGlyphScale(glyphScale) { }
+
+    ~DrawOneGlyph() { SkASSERT(fMasks.empty()); }
 
     void operator()(const SkGlyph& glyph, SkPoint position, SkPoint rounding) {
+        const SkPoint pen = position;
         position += rounding;
         // Prevent glyphs from being drawn outside of or straddling the edge of device space.
         // Comparisons written a little weirdly so that NaN coordinates are treated safely.
@@ -1495,14 +1819,26 @@ public:
         int top  = SkScalarFloorToInt(position.fY);
         SkASSERT(glyph.fWidth > 0 && glyph.fHeight > 0);
 
-        left += glyph.fLeft;
-        top  += glyph.fTop;
+        SkMask mask;
+        if (1 == fGlyphScale) {
+            left += glyph.fLeft;
+            top  += glyph.fTop;
 
-        int right   = left + glyph.fWidth;
-        int bottom  = top  + glyph.fHeight;
+            int right   = left + glyph.fWidth;
+            int bottom  = top  + glyph.fHeight;
 
-        SkMask mask;
-        mask.fBounds.set(left, top, right, bottom);
+            mask.fBounds.set(left, top, right, bottom);
+        } else {
+            // The image was made for the pen at (left, top), give or take its subpixel phase.
+            // Scale it about the pen, so that the phase is kept.
+            fScaledOrigin.set(left + (pen.fX - left) * (1 - fGlyphScale),
+                              top  + (pen.fY - top)  * (1 - fGlyphScale));
+            SkRect scaled = SkRect::MakeXYWH(fScaledOrigin.fX + glyph.fLeft * fGlyphScale,
+                                             fScaledOrigin.fY + glyph.fTop  * fGlyphScale,
+                                             glyph.fWidth  * fGlyphScale,
+                                             glyph.fHeight * fGlyphScale);
+            scaled.roundOut(&mask.fBounds);
+        }
         SkASSERT(!mask.fBounds.isEmpty());
 
         if (fUseRegionToDraw) {
@@ -1528,11 +1864,27 @@ public:
             }
 
             if (this->getImageData(glyph, &mask)) {
-                this->blitMask(mask, *bounds);
+                // Unscaled images stay put in the cache while we draw, so their masks can be
+                // batched up and blitted with one call.
+                if (1 == fGlyphScale && SkMask::kARGB32_Format != mask.fFormat) {
+                    fMasks.push_back(mask);
+                    fClips.push_back(*bounds);
+                } else {
+                    this->blitMask(mask, *bounds);
+                }
             }
         }
     }
 
+    // Blit the batched masks. Call this after the last glyph.
+    void flush() {
+        if (!fMasks.empty()) {
+            fBlitter->blitMasks(fMasks.begin(), fClips.begin(), fMasks.count());
+            fMasks.reset();
+            fClips.reset();
+        }
+    }
+
 private:
     static bool UsingRegionToDraw(const SkRasterClip* rClip) {
         return rClip->isBW() && !rClip->isRect();
@@ -1556,10 +1908,32 @@ private:
         mask->fImage    = bits;
         mask->fRowBytes = glyph.rowBytes();
         mask->fFormat   = static_cast<SkMask::Format>(glyph.fMaskFormat);
+        if (1 != fGlyphScale) {
+            return this->scaleImageData(glyph, mask);
+        }
         return true;
     }
 
-    void blitMask(const SkMask& mask, const SkIRect& clip) const {
+    bool scaleImageData(const SkGlyph& glyph, SkMask* mask) {
+        int bytesPerPixel;
+        switch (mask->fFormat) {
+            case SkMask::kA8_Format:     bytesPerPixel = 1; break;
+            case SkMask::kARGB32_Format: bytesPerPixel = 4; break;
+            default:
+                SkDEBUGFAIL("ShouldShareStrike() should only allow A8 and color glyphs.");
+                return false;
+        }
+        mask->fRowBytes = mask->fBounds.width() * bytesPerPixel;
+        uint8_t* scaled = (uint8_t*)fScaledImage.reset(mask->computeImageSize());
+        scale_glyph_image(glyph, mask->fImage, bytesPerPixel, fScaledOrigin, fGlyphScale,
+                          mask->fBounds, scaled, &fScratch);
+        mask->fImage = scaled;
+        return true;
+    }
+
+    void blitMask(const SkMask& mask, const SkIRect& clip) {
+        // Keep glyphs in order.
+        this->flush();
         if (SkMask::kARGB32_Format == mask.fFormat) {
             SkBitmap bm;
             bm.installPixels(
@@ -1579,6 +1953,12 @@ private:
     const SkDraw&         fDraw;
     const SkPaint&        fPaint;
     const SkIRect         fClipBounds;
+    const SkScalar        fGlyphScale;
+    SkPoint               fScaledOrigin;
+    SkAutoSMalloc<1024>   fScaledImage;
+    SkAutoSMalloc<1024>   fScratch;
+    SkSTArray<64, SkMask, true>  fMasks;
+    SkSTArray<64, SkIRect, true> fClips;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1619,6 +1999,7 @@ void SkDraw::drawText(const char text[], size_t byteLength,
     SkFindAndPlaceGlyph::ProcessText(
         paint.getTextEncoding(), text, byteLength,
         {x, y}, *fMatrix, paint.getTextAlign(), cache.get(), drawOneGlyph);
+    drawOneGlyph.flush();
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -1691,17 +2072,195 @@ void SkDraw::drawPosText(const char text[], size_t byteLength,
         return;
     }
 
-    SkAutoGlyphCache cache(paint, &fDevice->surfaceProps(), this->scalerContextFlags(), fMatrix);
+    SkPaint  sharedPaint;
+    SkScalar glyphScale = 1;
+    SkScalar tolerance = fTextSizeTolerance ? *fTextSizeTolerance
+                                            : SkGlyphCache::SizeTolerance();
+    bool     shared = SkGlyphCache::ShouldShareStrike(paint, *fMatrix, tolerance, &sharedPaint,
+                                                      &glyphScale);
+    SkAutoGlyphCache cache(shared ? sharedPaint : paint, &fDevice->surfaceProps(),
+                           this->scalerContextFlags(), shared ? &SkMatrix::I() : fMatrix);
+    if (1 != glyphScale) {
+        cache->noteStrikeAvoided(glyphScale);
+    }
 
     // The Blitter Choose needs to be live while using the blitter below.
     SkAutoBlitterChoose    blitterChooser(fDst, *fMatrix, paint);
     SkAAClipBlitterWrapper wrapper(*fRC, blitterChooser.get());
-    DrawOneGlyph           drawOneGlyph(*this, paint, cache.get(), wrapper.getBlitter());
+    DrawOneGlyph           drawOneGlyph(*this, paint, cache.get(), wrapper.getBlitter(),
+                                        glyphScale);
     SkPaint::Align         textAlignment = paint.getTextAlign();
 
     SkFindAndPlaceGlyph::ProcessPosText(
         paint.getTextEncoding(), text, byteLength,
         offset, *fMatrix, pos, scalarsPerPosition, textAlignment, cache.get(), drawOneGlyph);
+    drawOneGlyph.flush();
+}
+
+namespace {
+// One text blob run, with the paint and position SkBaseDevice::drawTextBlob() gives SkDraw.
+struct PrewarmRun {
+    SkPaint         fPaint;
+    const char*     fText;
+    size_t          fByteLength;
+    const SkScalar* fPos;    // nullptr for default positioning
+    int             fScalarsPerPosition;
+    SkPoint         fOffset;
+};
+
+// The runs that use one strike. A strike is only ever used by one thread at a time, so all of
+// them are warmed by the same task. Default positioned runs drawn as paths go through
+// SkTextToPathIter, which finds its own strike; they are kept apart in fPathIterRuns.
+struct PrewarmStrike {
+    std::unique_ptr<SkDescriptor> fDesc;
+    bool                          fAsPaths;
+    bool                          fShared;  // made with no scale; see
+                                            // SkGlyphCache::ShouldShareStrike()
+    SkTArray<PrewarmRun>          fRuns;
+    SkTArray<PrewarmRun>          fPathIterRuns;
+};
+
+PrewarmStrike* find_prewarm_strike(SkTArray<PrewarmStrike>* strikes, const SkDescriptor& desc) {
+    for (PrewarmStrike& strike : *strikes) {
+        if (*strike.fDesc == desc) {
+            return &strike;
+        }
+    }
+    PrewarmStrike* strike = &strikes->push_back();
+    strike->fDesc = desc.copy();
+    return strike;
+}
+}  // namespace
+
+void SkDraw::PrewarmTextBlobs(SkCanvas* canvas, const SkTextBlob* const blobs[],
+                              const SkPoint origins[], int count, const SkPaint& paint) {
+    const SkMatrix& matrix = canvas->getTotalMatrix();
+    SkSurfaceProps props(0, kUnknown_SkPixelGeometry);
+    canvas->getProps(&props);
+    // Match scalerContextFlags().
+    uint32_t flags = SkPaint::kBoostContrast_ScalerContextFlag;
+    if (!canvas->imageInfo().colorSpace()) {
+        flags |= SkPaint::kFakeGamma_ScalerContextFlag;
+    }
+    SkScalar tolerance = SkGlyphCache::SizeTolerance();
+
+    SkTArray<PrewarmStrike> strikes;
+
+    for (int i = 0; i < count; ++i) {
+        SkPaint runPaint = paint;
+        for (SkTextBlobRunIterator it(blobs[i]); !it.done(); it.next()) {
+            it.applyFontToPaint(&runPaint);
+            // Match SkBaseDevice::filterTextFlags().
+            if (runPaint.isLCDRenderText() && runPaint.isAntiAlias() &&
+                kUnknown_SkPixelGeometry == props.pixelGeometry()) {
+                runPaint.setFlags((runPaint.getFlags() & ~SkPaint::kLCDRenderText_Flag) |
+                                  SkPaint::kGenA8FromLCD_Flag);
+            }
+
+            PrewarmRun run;
+            run.fPaint = runPaint;
+            run.fText = reinterpret_cast<const char*>(it.glyphs());
+            run.fByteLength = it.glyphCount() * sizeof(uint16_t);
+            run.fPos = it.pos();
+            run.fOffset = origins[i];
+            switch (it.positioning()) {
+                case SkTextBlob::kDefault_Positioning:
+                    run.fPos = nullptr;
+                    run.fScalarsPerPosition = 0;
+                    run.fOffset += it.offset();
+                    break;
+                case SkTextBlob::kHorizontal_Positioning:
+                    run.fScalarsPerPosition = 1;
+                    run.fOffset.fY += it.offset().y();
+                    break;
+                case SkTextBlob::kFull_Positioning:
+                    run.fScalarsPerPosition = 2;
+                    break;
+            }
+
+            bool asPaths = ShouldDrawTextAsPaths(run.fPaint, matrix);
+            if (asPaths && !run.fPos) {
+                // Match the strike SkTextToPathIter detaches.
+                SkPaint cachePaint(run.fPaint);
+                bool applyStrokeAndPathEffects = true;
+                SkTextBaseIter::SetupCachePaint(&cachePaint, &applyStrokeAndPathEffects);
+                std::unique_ptr<SkDescriptor> desc;
+                cachePaint.descriptorProc(
+                        nullptr, SkPaint::kFakeGammaAndBoostContrast_ScalerContextFlags, nullptr,
+                        [](SkTypeface*, const SkScalerContextEffects&, const SkDescriptor* d,
+                           void* context) {
+                            *static_cast<std::unique_ptr<SkDescriptor>*>(context) = d->copy();
+                        }, &desc);
+                find_prewarm_strike(&strikes, *desc)->fPathIterRuns.push_back(run);
+                continue;
+            }
+            if (asPaths) {
+                // Match drawPosText_asPaths().
+                run.fPaint.setupForAsPaths();
+                run.fPaint.setStyle(SkPaint::kFill_Style);
+                run.fPaint.setPathEffect(nullptr);
+            }
+            // Match drawPosText(). The glyphs are placed with the unshared paint, which only
+            // differs in text size, so it's fine to keep just the shared one.
+            SkScalar glyphScale;
+            bool shared = !asPaths && run.fPos &&
+                          SkGlyphCache::ShouldShareStrike(runPaint, matrix, tolerance,
+                                                          &run.fPaint, &glyphScale);
+
+            SkScalerContextEffects effects;
+            SkAutoDescriptor ad;
+            run.fPaint.getScalerContextDescriptor(&effects, &ad, props, flags,
+                                                  asPaths ? nullptr
+                                                          : shared ? &SkMatrix::I() : &matrix);
+            PrewarmStrike* strike = find_prewarm_strike(&strikes, *ad.getDesc());
+            if (strike->fRuns.empty()) {
+                strike->fAsPaths = asPaths;
+                strike->fShared = shared;
+            }
+            strike->fRuns.push_back(run);
+        }
+    }
+
+    SkTaskGroup().batch(strikes.count(), [&](int index) {
+        const PrewarmStrike& strike = strikes[index];
+        // Each SkTextToPathIter detaches the strike itself, so these go before we hold it below.
+        for (const PrewarmRun& run : strike.fPathIterRuns) {
+            SkTextToPathIter iter(run.fText, run.fByteLength, run.fPaint, true);
+            const SkPath* path;
+            SkScalar xpos;
+            while (iter.next(&path, &xpos)) {}
+        }
+        if (strike.fRuns.empty()) {
+            return;
+        }
+
+        SkAutoGlyphCache cache(strike.fRuns[0].fPaint, &props, flags,
+                               strike.fAsPaths ? nullptr
+                                               : strike.fShared ? &SkMatrix::I() : &matrix);
+        auto warmImage = [&cache](const SkGlyph& glyph, SkPoint, SkPoint) {
+            cache->findImage(glyph);
+        };
+        for (const PrewarmRun& run : strike.fRuns) {
+            if (strike.fAsPaths) {
+                auto glyphs = reinterpret_cast<const SkGlyphID*>(run.fText);
+                for (size_t i = 0; i < run.fByteLength / sizeof(SkGlyphID); ++i) {
+                    const SkGlyph& glyph = cache->getGlyphIDMetrics(glyphs[i]);
+                    if (glyph.fWidth) {
+                        cache->findPath(glyph);
+                    }
+                }
+            } else if (run.fPos) {
+                SkFindAndPlaceGlyph::ProcessPosText(
+                    SkPaint::kGlyphID_TextEncoding, run.fText, run.fByteLength, run.fOffset,
+                    matrix, run.fPos, run.fScalarsPerPosition, run.fPaint.getTextAlign(),
+                    cache.get(), warmImage);
+            } else {
+                SkFindAndPlaceGlyph::ProcessText(
+                    SkPaint::kGlyphID_TextEncoding, run.fText, run.fByteLength, run.fOffset,
+                    matrix, run.fPaint.getTextAlign(), cache.get(), warmImage);
+            }
+        }
+    });
 }
 
 #if defined _WIN32
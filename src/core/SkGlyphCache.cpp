@@ -7,14 +7,20 @@
 
 #include "SkGlyphCache.h"
 #include "SkGlyphCache_Globals.h"
+#include "SkChecksum.h"
+#include "SkDraw.h"
 #include "SkGraphics.h"
+#include "SkOSFile.h"
 #include "SkOnce.h"
 #include "SkPath.h"
+#include "SkStream.h"
+#include "SkString.h"
 #include "SkTemplates.h"
 #include "SkTraceMemoryDump.h"
 #include "SkTypeface.h"
 
 #include <cctype>
+#include <cstdio>
 
 //#define SPEW_PURGE_STATUS
 
@@ -38,16 +44,24 @@ static SkGlyphCache_Globals& get_globals() {
 #define kMinGlyphImageSize  (16*2)
 #define kMinAllocAmount     ((sizeof(SkGlyph) + kMinGlyphImageSize) * kMinGlyphCount)
 
-SkGlyphCache::SkGlyphCache(const SkDescriptor* desc, std::unique_ptr<SkScalerContext> ctx)
+SkGlyphCache::SkGlyphCache(const SkDescriptor* desc, std::unique_ptr<SkScalerContext> ctx,
+                           sk_sp<SkGlyphStore> store, const SkGlyphStore::Strike* storedStrike)
     : fDesc(desc->copy())
     , fScalerContext(std::move(ctx))
-    , fGlyphAlloc(kMinAllocAmount) {
+    , fGlyphAlloc(kMinAllocAmount)
+    , fStore(std::move(store))
+    , fStoredStrike(storedStrike) {
     SkASSERT(desc);
     SkASSERT(fScalerContext);
+    SkASSERT(!fStoredStrike || fStore);
 
     fPrev = fNext = nullptr;
 
-    fScalerContext->getFontMetrics(&fFontMetrics);
+    if (fStoredStrike) {
+        fFontMetrics = fStoredStrike->getFontMetrics();
+    } else {
+        fScalerContext->getFontMetrics(&fFontMetrics);
+    }
 
     fMemoryUsed = sizeof(*this);
 }
@@ -175,7 +189,10 @@ SkGlyph* SkGlyphCache::allocateNewGlyph(SkPackedGlyphID packedGlyphID, MetricsTy
         glyphPtr = fGlyphMap.set(glyph);
     }
 
-    if (kJustAdvance_MetricsType == mtype) {
+    if (fStoredStrike && fStoredStrike->initGlyph(glyphPtr) &&
+        (kJustAdvance_MetricsType == mtype || glyphPtr->isFullMetrics())) {
+        // The stored glyph has all that was asked for.
+    } else if (kJustAdvance_MetricsType == mtype) {
         fScalerContext->getAdvance(glyphPtr);
     } else {
         SkASSERT(kFull_MetricsType == mtype);
@@ -214,7 +231,9 @@ const SkPath* SkGlyphCache::findPath(const SkGlyph& glyph) {
             const_cast<SkGlyph&>(glyph).fPathData = pathData;
             pathData->fIntercept = nullptr;
             SkPath* path = pathData->fPath = new SkPath;
-            fScalerContext->getPath(glyph.getPackedID(), path);
+            if (!fStoredStrike || !fStoredStrike->readPath(glyph.getPackedID(), path)) {
+                fScalerContext->getPath(glyph.getPackedID(), path);
+            }
             fMemoryUsed += sizeof(SkPath) + path->countPoints() * sizeof(SkPoint);
         }
     }
@@ -463,6 +482,25 @@ void SkGlyphCache_Globals::purgeAll() {
     this->internalPurge(fTotalMemoryUsed);
 }
 
+SkScalar SkGlyphCache_Globals::getSizeTolerance() const {
+    return fSizeTolerance.load(std::memory_order_relaxed);
+}
+
+SkScalar SkGlyphCache_Globals::setSizeTolerance(SkScalar tolerance) {
+    // Beyond this, glyphs would be scaled by more than text hinted for one size can take.
+    static const SkScalar kMaxTolerance = 0.5f;
+    tolerance = SkTPin(tolerance, 0.0f, kMaxTolerance);
+    return fSizeTolerance.exchange(tolerance, std::memory_order_relaxed);
+}
+
+void SkGlyphCache_Globals::noteStrikeAvoided() {
+    fStrikesAvoided.fetch_add(1, std::memory_order_relaxed);
+}
+
+int SkGlyphCache_Globals::getStrikesAvoided() const {
+    return fStrikesAvoided.load(std::memory_order_relaxed);
+}
+
 /*  This guy calls the visitor from within the mutext lock, so the visitor
     cannot:
     - take too much time
@@ -491,6 +529,7 @@ SkGlyphCache* SkGlyphCache::VisitCache(SkTypeface* typeface,
 
     SkGlyphCache_Globals& globals = get_globals();
     SkGlyphCache*         cache;
+    sk_sp<SkGlyphStore>   store;
 
     {
         SkAutoExclusive ac(globals.fLock);
@@ -507,6 +546,7 @@ SkGlyphCache* SkGlyphCache::VisitCache(SkTypeface* typeface,
                 return cache;
             }
         }
+        store = globals.internalGetStore();
     }
 
     // Check if we can create a scaler-context before creating the glyphcache.
@@ -521,7 +561,15 @@ SkGlyphCache* SkGlyphCache::VisitCache(SkTypeface* typeface,
             ctx = typeface->createScalerContext(effects, desc, false);
             SkASSERT(ctx);
         }
-        cache = new SkGlyphCache(desc, std::move(ctx));
+        const SkGlyphStore::Strike* storedStrike = nullptr;
+        if (store) {
+            std::unique_ptr<SkDescriptor> key = SkGlyphStore::MakeKey(typeface, *desc);
+            storedStrike = key ? store->findStrike(*key) : nullptr;
+        }
+        if (!storedStrike) {
+            store = nullptr;
+        }
+        cache = new SkGlyphCache(desc, std::move(ctx), std::move(store), storedStrike);
     }
 
     AutoValidate av(cache);
@@ -616,8 +664,65 @@ void SkGlyphCache::VisitAll(Visitor visitor, void* context) {
     }
 }
 
+bool SkGlyphCache::WriteStore(SkWStream* stream) {
+    SkGlyphCache_Globals& globals = get_globals();
+
+    // Making a key reads the font, so the keys are made without holding the lock, from copies
+    // of the strikes' descriptors and typefaces.
+    struct StrikeKey {
+        std::unique_ptr<SkDescriptor> fDesc;
+        sk_sp<SkTypeface>             fTypeface;
+        std::unique_ptr<SkDescriptor> fKey;
+    };
+    SkTArray<StrikeKey> keys;
+    {
+        SkAutoExclusive ac(globals.fLock);
+        for (SkGlyphCache* cache = globals.internalGetHead(); cache; cache = cache->fNext) {
+            keys.push_back(StrikeKey{cache->fDesc->copy(),
+                                     sk_ref_sp(cache->fScalerContext->getTypeface()), nullptr});
+        }
+    }
+    SkTHashMap<uint32_t, int> keyIndex;
+    for (int i = 0; i < keys.count(); ++i) {
+        keys[i].fKey = SkGlyphStore::MakeKey(keys[i].fTypeface.get(), *keys[i].fDesc);
+        if (keys[i].fKey) {
+            keyIndex.set(keys[i].fDesc->getChecksum(), i);
+        }
+    }
+
+    // Strikes purged in the meantime are left out, as are ones made since.
+    SkGlyphStore::Writer writer;
+    {
+        SkAutoExclusive ac(globals.fLock);
+
+        globals.validate();
+
+        SkTDArray<const SkGlyph*> glyphs;
+        for (SkGlyphCache* cache = globals.internalGetHead(); cache; cache = cache->fNext) {
+            const int* index = keyIndex.find(cache->fDesc->getChecksum());
+            if (!index || *keys[*index].fDesc != *cache->fDesc) {
+                continue;
+            }
+            glyphs.rewind();
+            cache->fGlyphMap.foreach([&glyphs](SkGlyph* glyph) { *glyphs.append() = glyph; });
+            writer.addStrike(*keys[*index].fKey, cache->fFontMetrics, glyphs.begin(),
+                             glyphs.count());
+        }
+    }
+    return writer.write(stream);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
+sk_sp<SkGlyphStore> SkGlyphCache_Globals::internalGetStore() const {
+    return fStore;
+}
+
+void SkGlyphCache_Globals::setStore(sk_sp<SkGlyphStore> store) {
+    SkAutoExclusive ac(fLock);
+    fStore = std::move(store);
+}
+
 void SkGlyphCache_Globals::attachCacheToHead(SkGlyphCache* cache) {
     SkAutoExclusive ac(fLock);
 
@@ -785,11 +890,119 @@ int SkGraphics::GetFontCacheCountUsed() {
     return get_globals().getCacheCountUsed();
 }
 
+SkScalar SkGraphics::GetFontCacheSizeTolerance() {
+    return get_globals().getSizeTolerance();
+}
+
+SkScalar SkGraphics::SetFontCacheSizeTolerance(SkScalar tolerance) {
+    return get_globals().setSizeTolerance(tolerance);
+}
+
+int SkGraphics::GetFontCacheStrikesAvoided() {
+    return get_globals().getStrikesAvoided();
+}
+
+SkScalar SkGlyphCache::SizeTolerance() {
+    return get_globals().getSizeTolerance();
+}
+
+bool SkGlyphCache::ShouldShareStrike(const SkPaint& paint, const SkMatrix& ctm, SkScalar tolerance,
+                                     SkPaint* sharedPaint, SkScalar* glyphScale) {
+    if (0 == tolerance) {
+        return false;
+    }
+
+    // Glyph images are scaled uniformly, about each glyph's origin.
+    if (ctm.getType() & ~(SkMatrix::kScale_Mask | SkMatrix::kTranslate_Mask)) {
+        return false;
+    }
+    SkScalar scale = ctm.getScaleX();
+    if (!(scale > 0) || scale != ctm.getScaleY()) {
+        return false;
+    }
+
+    // Only A8 and color glyph images are scaled, and strokes and mask effects don't grow with
+    // the text size. Alignment would need the advances of the unshared size.
+    if (!paint.isAntiAlias() || paint.isLCDRenderText() ||
+        SkPaint::kFill_Style != paint.getStyle() || paint.getMaskFilter() ||
+        paint.getPathEffect() || paint.getRasterizer() ||
+        SkPaint::kLeft_Align != paint.getTextAlign()) {
+        return false;
+    }
+
+    // Sizes are shared on a grid whose step is the largest power of two no more than tolerance
+    // of the size, so the glyphs are scaled by at most half the tolerance, and whole and half
+    // pixel sizes are usually on the grid already.
+    SkScalar size = paint.getTextSize() * scale;
+    int exponent;
+    frexpf(size * tolerance, &exponent);
+    SkScalar step = ldexpf(1, exponent - 1);
+    SkScalar sharedSize = SkScalarRoundToScalar(size / step) * step;
+    if (!SkScalarIsFinite(sharedSize) || !(sharedSize > 0)) {
+        return false;
+    }
+
+    *sharedPaint = paint;
+    sharedPaint->setTextSize(sharedSize);
+    *glyphScale = size / sharedSize;
+    return true;
+}
+
+void SkGlyphCache::noteStrikeAvoided(SkScalar glyphScale) {
+    // Text zoomed smoothly is drawn at a new scale every frame; past this many, scales may be
+    // counted again.
+    static const int kMaxAvoidedScales = 256;
+
+    uint32_t scale = SkFloat2Bits(glyphScale);
+    if (fAvoidedScales.contains(scale)) {
+        return;
+    }
+    if (fAvoidedScales.count() >= kMaxAvoidedScales) {
+        fAvoidedScales.reset();
+    }
+    fAvoidedScales.add(scale);
+    get_globals().noteStrikeAvoided();
+}
+
 void SkGraphics::PurgeFontCache() {
     get_globals().purgeAll();
     SkTypefaceCache::PurgeAll();
 }
 
+void SkGraphics::PrewarmTextBlobs(SkCanvas* canvas, const SkTextBlob* const blobs[],
+                                  const SkPoint origins[], int count, const SkPaint& paint) {
+    SkDraw::PrewarmTextBlobs(canvas, blobs, origins, count, paint);
+}
+
+bool SkGraphics::SetFontCacheFile(const char path[]) {
+    sk_sp<SkGlyphStore> store;
+    if (path) {
+        store = SkGlyphStore::Make(SkData::MakeFromFileName(path));
+        if (!store) {
+            get_globals().setStore(nullptr);
+            return false;
+        }
+    }
+    get_globals().setStore(std::move(store));
+    return true;
+}
+
+bool SkGraphics::WriteFontCacheFile(const char path[]) {
+    SkString tmpPath(path);
+    tmpPath.append(".tmp");
+    bool written;
+    {
+        SkFILEWStream file(tmpPath.c_str());
+        written = file.isValid() && SkGlyphCache::WriteStore(&file);
+    }
+    // Replace rather than overwrite the file, as it may be mapped by SetFontCacheFile().
+    if (!written || !sk_rename(tmpPath.c_str(), path)) {
+        remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
 // TODO(herb): clean up TLS apis.
 size_t SkGraphics::GetTLSFontCacheLimit() { return 0; }
 void SkGraphics::SetTLSFontCacheLimit(size_t bytes) { }
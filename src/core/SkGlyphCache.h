@@ -11,6 +11,7 @@
 #include "SkChunkAlloc.h"
 #include "SkDescriptor.h"
 #include "SkGlyph.h"
+#include "SkGlyphStore.h"
 #include "SkPaint.h"
 #include "SkTHash.h"
 #include "SkScalerContext.h"
@@ -148,6 +149,30 @@ public:
     typedef void (*Visitor)(const SkGlyphCache&, void* context);
     static void VisitAll(Visitor, void* context);
 
+    /** Write the glyphs of every strike in the global cache whose font can be identified across
+        processes, for SkGlyphStore. Strikes that are detached are skipped.
+    */
+    static bool WriteStore(SkWStream*);
+
+    /** Return how far apart text sizes may be and still share a strike; see
+        SkGraphics::SetFontCacheSizeTolerance().
+    */
+    static SkScalar SizeTolerance();
+
+    /** If positioned text drawn with the paint and matrix should come from a strike shared with
+        sizes within tolerance, set sharedPaint to the paint that strike is made for, with no
+        scale in its matrix, and glyphScale to how much its glyph images are scaled by when
+        drawn, and return true.
+    */
+    static bool ShouldShareStrike(const SkPaint&, const SkMatrix&, SkScalar tolerance,
+                                  SkPaint* sharedPaint, SkScalar* glyphScale);
+
+    /** Count text that was drawn from this shared strike, with its glyph images scaled by
+        glyphScale, instead of from a strike of its own. Only the first draw at each scale is
+        counted, as the lookup of that strike of its own would have missed.
+    */
+    void noteStrikeAvoided(SkScalar glyphScale);
+
 #ifdef SK_DEBUG
     void validate() const;
 #else
@@ -192,7 +217,8 @@ private:
         SkPackedGlyphID fPackedGlyphID;
     };
 
-    SkGlyphCache(const SkDescriptor*, std::unique_ptr<SkScalerContext>);
+    SkGlyphCache(const SkDescriptor*, std::unique_ptr<SkScalerContext>,
+                 sk_sp<SkGlyphStore> = nullptr, const SkGlyphStore::Strike* = nullptr);
     ~SkGlyphCache();
 
     // Return the SkGlyph* associated with MakeID. The id parameter is the
@@ -239,8 +265,15 @@ private:
 
     std::unique_ptr<CharGlyphRec[]> fPackedUnicharIDToPackedGlyphID;
 
+    // If set, glyphs are taken from here before asking fScalerContext for them.
+    const sk_sp<SkGlyphStore>           fStore;
+    const SkGlyphStore::Strike* const   fStoredStrike;
+
     // used to track (approx) how much ram is tied-up in this cache
     size_t                 fMemoryUsed;
+
+    // The glyph scales text has been drawn from this strike at; see noteStrikeAvoided().
+    SkTHashSet<uint32_t>   fAvoidedScales;
 };
 
 class SkAutoGlyphCache : public std::unique_ptr<SkGlyphCache, SkGlyphCache::AttachCacheFunctor> {
@@ -11,8 +11,11 @@
 #include "SkGlyphCache.h"
 #include "SkMutex.h"
 #include "SkSpinlock.h"
+#include "SkTHash.h"
 #include "SkTLS.h"
 
+#include <atomic>
+
 #ifndef SK_DEFAULT_FONT_CACHE_COUNT_LIMIT
     #define SK_DEFAULT_FONT_CACHE_COUNT_LIMIT   2048
 #endif
@@ -31,6 +34,8 @@ public:
         fCacheSizeLimit = SK_DEFAULT_FONT_CACHE_LIMIT;
         fCacheCount = 0;
         fCacheCountLimit = SK_DEFAULT_FONT_CACHE_COUNT_LIMIT;
+        fSizeTolerance = 0;
+        fStrikesAvoided = 0;
     }
 
     ~SkGlyphCache_Globals() {
@@ -64,12 +69,22 @@ public:
 
     void purgeAll(); // does not change budget
 
+    // The store new strikes take their glyphs from; see SkGraphics::SetFontCacheFile().
+    void setStore(sk_sp<SkGlyphStore>);
+
+    // See SkGraphics::SetFontCacheSizeTolerance().
+    SkScalar getSizeTolerance() const;
+    SkScalar setSizeTolerance(SkScalar tolerance);
+    void noteStrikeAvoided();
+    int getStrikesAvoided() const;
+
     // call when a glyphcache is available for caching (i.e. not in use)
     void attachCacheToHead(SkGlyphCache*);
 
     // can only be called when the mutex is already held
     void internalDetachCache(SkGlyphCache*);
     void internalAttachCacheToHead(SkGlyphCache*);
+    sk_sp<SkGlyphStore> internalGetStore() const;
 
 private:
     SkGlyphCache* fHead;
@@ -77,6 +92,10 @@ private:
     size_t  fCacheSizeLimit;
     int32_t fCacheCountLimit;
     int32_t fCacheCount;
+    sk_sp<SkGlyphStore> fStore;
+    // Read by every positioned text draw, so these don't take fLock.
+    std::atomic<float> fSizeTolerance;
+    std::atomic<int32_t> fStrikesAvoided;
 
     // Checkout budgets, modulated by the specified min-bytes-needed-to-purge,
     // and attempt to purge caches to match.
@@ -0,0 +1,343 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkGlyphStore.h"
+#include "SkFontDescriptor.h"
+#include "SkFontStyle.h"
+#include "SkOpts.h"
+#include "SkPath.h"
+#include "SkScalerContext.h"
+#include "SkStreamPriv.h"
+#include "SkString.h"
+#include "SkTSort.h"
+#include "SkTypeface.h"
+
+/*
+ *  The file is a header followed by the strikes. Everything is 4 byte aligned and in the
+ *  writer's byte order; a reader with the other byte order sees a bad magic number.
+ *
+ *      uint32_t    magic, version, strike count
+ *      strikes:
+ *          uint32_t        size of the strike, including this field
+ *          SkDescriptor    key, padded to 4 bytes
+ *          FontMetrics
+ *          uint32_t        glyph count
+ *          Glyph           glyphs[glyph count], sorted by fID
+ *          images and paths, each padded to 4 bytes
+ */
+static const uint32_t kMagic = SkSetFourByteTag('s', 'k', 'g', 's');
+static const uint32_t kVersion = 1;
+
+struct SkGlyphStore::Strike::Glyph {
+    uint32_t fID;
+    float    fAdvanceX, fAdvanceY;
+    uint16_t fWidth, fHeight;
+    int16_t  fTop, fLeft;
+    uint8_t  fMaskFormat;
+    int8_t   fRsbDelta, fLsbDelta;
+    int8_t   fForceBW;
+    // Offsets are from the start of the strike; 0 means there is none.
+    uint32_t fImageOffset;
+    uint32_t fPathOffset, fPathLength;
+};
+
+static uint32_t packed_id(SkPackedGlyphID id) {
+    uint32_t value;
+    memcpy(&value, &id, sizeof(value));
+    return value;
+}
+
+const SkGlyphStore::Strike::Glyph* SkGlyphStore::Strike::find(SkPackedGlyphID packedID) const {
+    uint32_t id = packed_id(packedID);
+    int lo = 0, hi = fGlyphCount;
+    while (lo < hi) {
+        int mid = (lo + hi) >> 1;
+        if (fGlyphs[mid].fID < id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < fGlyphCount && fGlyphs[lo].fID == id ? &fGlyphs[lo] : nullptr;
+}
+
+bool SkGlyphStore::Strike::initGlyph(SkGlyph* glyph) const {
+    const Glyph* stored = this->find(glyph->getPackedID());
+    if (!stored) {
+        return false;
+    }
+    glyph->fAdvanceX = stored->fAdvanceX;
+    glyph->fAdvanceY = stored->fAdvanceY;
+    glyph->fWidth = stored->fWidth;
+    glyph->fHeight = stored->fHeight;
+    glyph->fTop = stored->fTop;
+    glyph->fLeft = stored->fLeft;
+    glyph->fMaskFormat = stored->fMaskFormat;
+    glyph->fRsbDelta = stored->fRsbDelta;
+    glyph->fLsbDelta = stored->fLsbDelta;
+    glyph->fForceBW = stored->fForceBW;
+    if (stored->fImageOffset) {
+        // Images are only ever read once made, so they can stay in the read-only mapping.
+        glyph->fImage = const_cast<char*>(fBase + stored->fImageOffset);
+    }
+    return true;
+}
+
+bool SkGlyphStore::Strike::readPath(SkPackedGlyphID packedID, SkPath* path) const {
+    const Glyph* stored = this->find(packedID);
+    if (!stored || !stored->fPathOffset) {
+        return false;
+    }
+    return path->readFromMemory(fBase + stored->fPathOffset, stored->fPathLength) ==
+           stored->fPathLength;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+// Reads the 4 byte aligned fields of a store, refusing to read past its end.
+class Reader {
+public:
+    Reader(const char* base, size_t size) : fBase(base), fSize(size), fOffset(0) {}
+
+    template <typename T> const T* skip(size_t count = 1) {
+        if (count > (fSize - fOffset) / sizeof(T)) {
+            return nullptr;
+        }
+        const T* p = reinterpret_cast<const T*>(fBase + fOffset);
+        fOffset = SkAlign4(fOffset + count * sizeof(T));
+        fOffset = SkTMin(fOffset, fSize);
+        return p;
+    }
+
+    size_t offset() const { return fOffset; }
+
+private:
+    const char* fBase;
+    size_t      fSize;
+    size_t      fOffset;
+};
+}  // namespace
+
+sk_sp<SkGlyphStore> SkGlyphStore::Make(sk_sp<SkData> data) {
+    if (!data || !SkIsAlign4(reinterpret_cast<uintptr_t>(data->data()))) {
+        return nullptr;
+    }
+    Reader reader(static_cast<const char*>(data->data()), data->size());
+    const uint32_t* header = reader.skip<uint32_t>(3);
+    if (!header || header[0] != kMagic || header[1] != kVersion) {
+        return nullptr;
+    }
+
+    sk_sp<SkGlyphStore> store(new SkGlyphStore(data));
+    for (uint32_t i = 0; i < header[2]; ++i) {
+        const char* base = static_cast<const char*>(data->data()) + reader.offset();
+        const uint32_t* strikeSize = reader.skip<uint32_t>();
+        if (!strikeSize || *strikeSize < sizeof(uint32_t) || !SkIsAlign4(*strikeSize) ||
+            !reader.skip<char>(*strikeSize - sizeof(uint32_t))) {
+            return nullptr;
+        }
+
+        Strike strike;
+        strike.fBase = base;
+        strike.fSize = *strikeSize;
+        Reader strikeReader(base, *strikeSize);
+        strikeReader.skip<uint32_t>();
+        const uint32_t* keyLength = strikeReader.skip<uint32_t>();
+        if (!keyLength || *keyLength < sizeof(SkDescriptor)) {
+            return nullptr;
+        }
+        strike.fKey = reinterpret_cast<const SkDescriptor*>(strikeReader.skip<char>(*keyLength));
+        strike.fFontMetrics = strikeReader.skip<SkPaint::FontMetrics>();
+        const uint32_t* glyphCount = strikeReader.skip<uint32_t>();
+        if (!strike.fKey || strike.fKey->getLength() != *keyLength ||
+            !strike.fFontMetrics || !glyphCount) {
+            return nullptr;
+        }
+        strike.fGlyphs = strikeReader.skip<Strike::Glyph>(*glyphCount);
+        strike.fGlyphCount = SkToInt(*glyphCount);
+        if (!strike.fGlyphs) {
+            return nullptr;
+        }
+        for (int g = 0; g < strike.fGlyphCount; ++g) {
+            const Strike::Glyph& glyph = strike.fGlyphs[g];
+            if (g > 0 && strike.fGlyphs[g - 1].fID >= glyph.fID) {
+                return nullptr;
+            }
+            if (glyph.fImageOffset) {
+                SkGlyph sizer;
+                sizer.fWidth = glyph.fWidth;
+                sizer.fHeight = glyph.fHeight;
+                sizer.fMaskFormat = glyph.fMaskFormat;
+                size_t imageSize = sizer.computeImageSize();
+                if (!SkIsAlign4(glyph.fImageOffset) || glyph.fImageOffset > strike.fSize ||
+                    imageSize > strike.fSize - glyph.fImageOffset) {
+                    return nullptr;
+                }
+            }
+            if (glyph.fPathOffset && (glyph.fPathOffset > strike.fSize ||
+                                      glyph.fPathLength > strike.fSize - glyph.fPathOffset)) {
+                return nullptr;
+            }
+        }
+
+        uint32_t checksum = strike.fKey->getChecksum();
+        if (!store->fIndex.find(checksum)) {
+            store->fIndex.set(checksum, store->fStrikes.count());
+            store->fStrikes.push_back(strike);
+        }
+    }
+    return store;
+}
+
+const SkGlyphStore::Strike* SkGlyphStore::findStrike(const SkDescriptor& key) const {
+    const int* index = fIndex.find(key.getChecksum());
+    if (!index) {
+        return nullptr;
+    }
+    const Strike& strike = fStrikes[*index];
+    if (strike.fKey->getLength() != key.getLength() || *strike.fKey != key) {
+        return nullptr;
+    }
+    return &strike;
+}
+
+// Returns false if the typeface has no 'head' table. That table holds the checksum of the whole
+// font file and its creation and modification dates, which tells font files apart. The faces of
+// one file are told apart by their collection index and variation position.
+static bool font_identity(SkTypeface* typeface, uint32_t* identity) {
+    static const SkFontTableTag kHeadTag = SkSetFourByteTag('h', 'e', 'a', 'd');
+    static const size_t kHeadSize = 54;
+
+    uint8_t head[kHeadSize];
+    if (typeface->getTableData(kHeadTag, 0, kHeadSize, head) != kHeadSize) {
+        return false;
+    }
+    SkString family;
+    typeface->getFamilyName(&family);
+    SkFontStyle style = typeface->fontStyle();
+    int weightWidthSlant[] = { style.weight(), style.width(), style.slant() };
+
+    std::unique_ptr<SkFontData> data = typeface->makeFontData();
+    if (!data) {
+        return false;
+    }
+    int index = data->getIndex();
+
+    uint32_t hash = SkOpts::hash(family.c_str(), family.size(), typeface->countGlyphs());
+    hash = SkOpts::hash(weightWidthSlant, sizeof(weightWidthSlant), hash);
+    hash = SkOpts::hash(&index, sizeof(index), hash);
+    hash = SkOpts::hash(data->getAxis(), data->getAxisCount() * sizeof(SkFixed), hash);
+    *identity = SkOpts::hash(head, kHeadSize, hash);
+    return true;
+}
+
+std::unique_ptr<SkDescriptor> SkGlyphStore::MakeKey(SkTypeface* typeface,
+                                                    const SkDescriptor& desc) {
+    uint32_t identity;
+    if (!typeface || !font_identity(typeface, &identity)) {
+        return nullptr;
+    }
+    std::unique_ptr<SkDescriptor> key = desc.copy();
+    uint32_t length;
+    auto rec = static_cast<const SkScalerContext::Rec*>(key->findEntry(kRec_SkDescriptorTag,
+                                                                       &length));
+    if (!rec || length != sizeof(*rec)) {
+        return nullptr;
+    }
+    const_cast<SkScalerContext::Rec*>(rec)->fFontID = identity;
+    key->computeChecksum();
+    return key;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void pad4(SkWStream* stream, size_t length) {
+    static const char kZeros[4] = { 0, 0, 0, 0 };
+    stream->write(kZeros, SkAlign4(length) - length);
+}
+
+void SkGlyphStore::Writer::addStrike(const SkDescriptor& key,
+                                     const SkPaint::FontMetrics& fontMetrics,
+                                     const SkGlyph* const glyphs[], int count) {
+    if (fChecksums.contains(key.getChecksum())) {
+        return;
+    }
+    fChecksums.add(key.getChecksum());
+
+    SkTArray<const SkGlyph*> sorted(count);
+    sorted.push_back_n(count, glyphs);
+    SkTQSort(sorted.begin(), sorted.end() - 1, [](const SkGlyph* a, const SkGlyph* b) {
+        return packed_id(a->getPackedID()) < packed_id(b->getPackedID());
+    });
+
+    size_t offset = sizeof(uint32_t) + sizeof(uint32_t) + SkAlign4(key.getLength()) +
+                    sizeof(SkPaint::FontMetrics) + sizeof(uint32_t) +
+                    count * sizeof(Strike::Glyph);
+    SkTArray<Strike::Glyph> records(count);
+    for (const SkGlyph* glyph : sorted) {
+        Strike::Glyph& record = records.push_back();
+        sk_bzero(&record, sizeof(record));
+        record.fID = packed_id(glyph->getPackedID());
+        record.fAdvanceX = glyph->fAdvanceX;
+        record.fAdvanceY = glyph->fAdvanceY;
+        record.fWidth = glyph->fWidth;
+        record.fHeight = glyph->fHeight;
+        record.fTop = glyph->fTop;
+        record.fLeft = glyph->fLeft;
+        record.fMaskFormat = glyph->fMaskFormat;
+        record.fRsbDelta = glyph->fRsbDelta;
+        record.fLsbDelta = glyph->fLsbDelta;
+        record.fForceBW = glyph->fForceBW;
+        if (glyph->fImage) {
+            record.fImageOffset = SkToU32(offset);
+            offset += SkAlign4(glyph->computeImageSize());
+        }
+        if (glyph->fPathData && glyph->fPathData->fPath) {
+            record.fPathOffset = SkToU32(offset);
+            record.fPathLength = SkToU32(glyph->fPathData->fPath->writeToMemory(nullptr));
+            offset += SkAlign4(record.fPathLength);
+        }
+    }
+
+    fStrikes.write32(SkToU32(offset));
+    fStrikes.write32(key.getLength());
+    fStrikes.write(&key, key.getLength());
+    pad4(&fStrikes, key.getLength());
+    fStrikes.write(&fontMetrics, sizeof(fontMetrics));
+    fStrikes.write32(count);
+    fStrikes.write(records.begin(), count * sizeof(Strike::Glyph));
+    for (const SkGlyph* glyph : sorted) {
+        if (glyph->fImage) {
+            size_t size = glyph->computeImageSize();
+            fStrikes.write(glyph->fImage, size);
+            pad4(&fStrikes, size);
+        }
+        if (glyph->fPathData && glyph->fPathData->fPath) {
+            size_t size = glyph->fPathData->fPath->writeToMemory(nullptr);
+            SkAutoTMalloc<char> buffer(size);
+            glyph->fPathData->fPath->writeToMemory(buffer.get());
+            fStrikes.write(buffer.get(), size);
+            pad4(&fStrikes, size);
+        }
+    }
+    fStrikeCount++;
+}
+
+bool SkGlyphStore::Writer::write(SkWStream* stream) {
+    if (!stream->write32(kMagic) || !stream->write32(kVersion) ||
+        !stream->write32(fStrikeCount)) {
+        return false;
+    }
+    // Unlike writeToStream(), this says whether the strikes were all written.
+    std::unique_ptr<SkStreamAsset> strikes(fStrikes.detachAsStream());
+    if (!SkStreamCopy(stream, strikes.get())) {
+        return false;
+    }
+    stream->flush();
+    return true;
+}
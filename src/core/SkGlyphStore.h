@@ -0,0 +1,98 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkGlyphStore_DEFINED
+#define SkGlyphStore_DEFINED
+
+#include "SkData.h"
+#include "SkDescriptor.h"
+#include "SkGlyph.h"
+#include "SkPaint.h"
+#include "SkRefCnt.h"
+#include "SkStream.h"
+#include "SkTArray.h"
+#include "SkTHash.h"
+
+class SkPath;
+class SkTypeface;
+
+/**
+ *  Glyphs that an earlier process saved to a file, memory mapped back in so that new strikes
+ *  can be filled from them instead of from their scaler contexts. Glyph images are used in
+ *  place, straight from the mapping. See SkGraphics::SetFontCacheFile().
+ *
+ *  A strike is stored under its descriptor with the process-local font ID replaced by a hash
+ *  of the font's identity; see MakeKey().
+ */
+class SkGlyphStore : public SkNVRefCnt<SkGlyphStore> {
+public:
+    class Strike {
+    public:
+        const SkPaint::FontMetrics& getFontMetrics() const { return *fFontMetrics; }
+
+        /** If the strike has the glyph with glyph's fID, set its metrics and image from the
+            stored ones and return true.
+        */
+        bool initGlyph(SkGlyph* glyph) const;
+
+        /** If the strike has a path for the glyph, read it into path and return true. */
+        bool readPath(SkPackedGlyphID, SkPath* path) const;
+
+    private:
+        friend class SkGlyphStore;
+        struct Glyph;
+
+        const Glyph* find(SkPackedGlyphID) const;
+
+        const char*                 fBase;
+        size_t                      fSize;
+        const SkDescriptor*         fKey;
+        const SkPaint::FontMetrics* fFontMetrics;
+        const Glyph*                fGlyphs;
+        int                         fGlyphCount;
+    };
+
+    /** Returns nullptr if data was not written by a Writer of this version. */
+    static sk_sp<SkGlyphStore> Make(sk_sp<SkData> data);
+
+    /** Return the strike stored under key, or nullptr. */
+    const Strike* findStrike(const SkDescriptor& key) const;
+
+    /** Return the key that a strike for desc, whose fFontID names typeface, is stored under.
+        Returns nullptr if typeface can't be told apart from other fonts across processes.
+    */
+    static std::unique_ptr<SkDescriptor> MakeKey(SkTypeface*, const SkDescriptor& desc);
+
+    class Writer {
+    public:
+        Writer() : fStrikeCount(0) {}
+
+        /** Add the glyphs of a strike, keyed by MakeKey(). A strike whose key has the checksum
+            of one already added is skipped.
+        */
+        void addStrike(const SkDescriptor& key, const SkPaint::FontMetrics&,
+                       const SkGlyph* const glyphs[], int count);
+
+        /** Write the store to stream. This empties the writer, so call it just once. */
+        bool write(SkWStream*);
+
+    private:
+        SkDynamicMemoryWStream fStrikes;
+        int                    fStrikeCount;
+        SkTHashSet<uint32_t>   fChecksums;
+    };
+
+private:
+    SkGlyphStore(sk_sp<SkData> data) : fData(std::move(data)) {}
+
+    sk_sp<SkData>               fData;
+    SkTArray<Strike>            fStrikes;
+    // Maps descriptor checksums to indices in fStrikes.
+    SkTHashMap<uint32_t, int>   fIndex;
+};
+
+#endif
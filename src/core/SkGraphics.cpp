@@ -23,6 +23,7 @@
 #include "SkRefCnt.h"
 #include "SkResourceCache.h"
 #include "SkScalerContext.h"
+#include "SkScan.h"
 #include "SkShader.h"
 #include "SkStream.h"
 #include "SkTSearch.h"
@@ -62,6 +63,14 @@ void SkGraphics::PurgeAllCaches() {
     SkImageFilter::PurgeCache();
 }
 
+int SkGraphics::GetAAFillBands() {
+    return gSkAAFillBands.load();
+}
+
+int SkGraphics::SetAAFillBands(int bands) {
+    return gSkAAFillBands.exchange(SkTMax(bands, 0));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 static const char kFontCacheLimitStr[] = "font-cache-limit";
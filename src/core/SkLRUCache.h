@@ -22,12 +22,7 @@ public:
     : fMaxCount(maxCount) {}
 
     ~SkLRUCache() {
-        Entry* node = fLRU.head();
-        while (node) {
-            fLRU.remove(node);
-            delete node;
-            node = fLRU.head();
-        }
+        this->reset();
     }
 
     V* find(const K& key) {
@@ -57,6 +52,14 @@ public:
         return fMap.count();
     }
 
+    void reset() {
+        fMap.reset();
+        for (Entry* e = fLRU.head(); e; e = fLRU.head()) {
+            fLRU.remove(e);
+            delete e;
+        }
+    }
+
 private:
     struct Entry {
         Entry(const K& key, V&& value)
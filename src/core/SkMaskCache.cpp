@@ -6,6 +6,7 @@
  */
 
 #include "SkMaskCache.h"
+#include "SkScan.h"
 
 #define CHECK_LOCAL(localCache, localName, globalName, ...) \
     ((localCache) ? localCache->localName(__VA_ARGS__) : SkResourceCache::globalName(__VA_ARGS__))
@@ -188,3 +189,133 @@ void SkMaskCache::Add(SkScalar sigma, SkBlurStyle style, SkBlurQuality quality,
     RectsBlurKey key(sigma, style, quality, rects, count);
     return CHECK_LOCAL(localCache, add, Add, new RectsBlurRec(key, mask, data));
 }
+
+//////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+static unsigned gPathMaskKeyNamespaceLabel;
+static unsigned gPathDrawKeyNamespaceLabel;
+
+struct PathMaskKey : public SkResourceCache::Key {
+public:
+    PathMaskKey(void* nameSpace, const SkPath& path, const SkMatrix& matrix, const SkPaint& paint)
+        : fGenID(path.getGenerationID())
+        , fFillType(path.getFillType())
+        , fScaleX(matrix.getScaleX())
+        , fSkewX(matrix.getSkewX())
+        , fTransX(matrix.getTranslateX() - SkScalarFloorToScalar(matrix.getTranslateX()))
+        , fSkewY(matrix.getSkewY())
+        , fScaleY(matrix.getScaleY())
+        , fTransY(matrix.getTranslateY() - SkScalarFloorToScalar(matrix.getTranslateY()))
+        , fStrokeWidth(paint.getStrokeWidth())
+        , fMiter(paint.getStrokeMiter())
+        , fStyle((paint.getStyle() << 16) | (paint.getStrokeCap() << 8) | paint.getStrokeJoin())
+        , fAnalyticAA(gSkUseAnalyticAA.load())
+    {
+        if (SkPaint::kFill_Style == paint.getStyle()) {
+            // stroke parameters don't affect fills
+            fStrokeWidth = fMiter = 0;
+            fStyle = SkPaint::kFill_Style << 16;
+        }
+        this->init(nameSpace, 0,
+                   sizeof(fGenID) + sizeof(fFillType) + sizeof(fScaleX) + sizeof(fSkewX) +
+                   sizeof(fTransX) + sizeof(fSkewY) + sizeof(fScaleY) + sizeof(fTransY) +
+                   sizeof(fStrokeWidth) + sizeof(fMiter) + sizeof(fStyle) + sizeof(fAnalyticAA));
+    }
+
+    uint32_t    fGenID;
+    int32_t     fFillType;
+    SkScalar    fScaleX;
+    SkScalar    fSkewX;
+    SkScalar    fTransX;
+    SkScalar    fSkewY;
+    SkScalar    fScaleY;
+    SkScalar    fTransY;
+    SkScalar    fStrokeWidth;
+    SkScalar    fMiter;
+    int32_t     fStyle;
+    int32_t     fAnalyticAA;
+};
+
+// Records that a path was drawn once, so only draws that repeat get a mask.
+struct PathDrawRec : public SkResourceCache::Rec {
+    PathDrawRec(const PathMaskKey& key) : fKey(key) {}
+
+    PathMaskKey    fKey;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this); }
+    const char* getCategory() const override { return "path-draw"; }
+
+    static bool Visitor(const SkResourceCache::Rec&, void*) {
+        return true;
+    }
+};
+
+struct PathMaskRec : public SkResourceCache::Rec {
+    PathMaskRec(const PathMaskKey& key, const SkMask& mask, SkCachedData* data)
+        : fKey(key)
+    {
+        fValue.fMask = mask;
+        fValue.fData = data;
+        fValue.fData->attachToCacheAndRef();
+    }
+    ~PathMaskRec() {
+        fValue.fData->detachFromCacheAndUnref();
+    }
+
+    PathMaskKey    fKey;
+    MaskValue      fValue;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fValue.fData->size(); }
+    const char* getCategory() const override { return "path-mask"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override {
+        return fValue.fData->diagnostic_only_getDiscardable();
+    }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const PathMaskRec& rec = static_cast<const PathMaskRec&>(baseRec);
+        MaskValue* result = static_cast<MaskValue*>(contextData);
+
+        SkCachedData* tmpData = rec.fValue.fData;
+        tmpData->ref();
+        if (nullptr == tmpData->data()) {
+            tmpData->unref();
+            return false;
+        }
+        *result = rec.fValue;
+        return true;
+    }
+};
+} // namespace
+
+SkCachedData* SkMaskCache::FindAndRef(const SkPath& path, const SkMatrix& matrix,
+                                      const SkPaint& paint, SkMask* mask,
+                                      SkResourceCache* localCache) {
+    MaskValue result;
+    PathMaskKey key(&gPathMaskKeyNamespaceLabel, path, matrix, paint);
+    if (!CHECK_LOCAL(localCache, find, Find, key, PathMaskRec::Visitor, &result)) {
+        return nullptr;
+    }
+
+    *mask = result.fMask;
+    mask->fImage = (uint8_t*)(result.fData->data());
+    return result.fData;
+}
+
+void SkMaskCache::Add(const SkPath& path, const SkMatrix& matrix, const SkPaint& paint,
+                      const SkMask& mask, SkCachedData* data, SkResourceCache* localCache) {
+    PathMaskKey key(&gPathMaskKeyNamespaceLabel, path, matrix, paint);
+    return CHECK_LOCAL(localCache, add, Add, new PathMaskRec(key, mask, data));
+}
+
+bool SkMaskCache::NotePathDraw(const SkPath& path, const SkMatrix& matrix, const SkPaint& paint,
+                               SkResourceCache* localCache) {
+    PathMaskKey key(&gPathDrawKeyNamespaceLabel, path, matrix, paint);
+    if (CHECK_LOCAL(localCache, find, Find, key, PathDrawRec::Visitor, nullptr)) {
+        return true;
+    }
+    CHECK_LOCAL(localCache, add, Add, new PathDrawRec(key));
+    return false;
+}
@@ -11,6 +11,8 @@
 #include "SkBlurTypes.h"
 #include "SkCachedData.h"
 #include "SkMask.h"
+#include "SkPaint.h"
+#include "SkPath.h"
 #include "SkRect.h"
 #include "SkResourceCache.h"
 #include "SkRRect.h"
@@ -39,6 +41,25 @@ public:
     static void Add(SkScalar sigma, SkBlurStyle style, SkBlurQuality quality,
                     const SkRect rects[], int count, const SkMask& mask, SkCachedData* data,
                     SkResourceCache* localCache = nullptr);
+
+    /**
+     * Coverage masks for anti-aliased path draws, keyed by the path's generation ID and fill
+     * type, the paint's stroke parameters, and the matrix with only the fractional part of its
+     * translate. So draws that differ by whole pixels share a mask, and its bounds are relative
+     * to the floor of the translate.
+     */
+    static SkCachedData* FindAndRef(const SkPath& path, const SkMatrix& matrix,
+                                    const SkPaint& paint, SkMask* mask,
+                                    SkResourceCache* localCache = nullptr);
+    static void Add(const SkPath& path, const SkMatrix& matrix, const SkPaint& paint,
+                    const SkMask& mask, SkCachedData* data,
+                    SkResourceCache* localCache = nullptr);
+    /**
+     * Returns true if the same path draw was noted before. Otherwise notes it and returns
+     * false, so that only draws that repeat are worth a mask.
+     */
+    static bool NotePathDraw(const SkPath& path, const SkMatrix& matrix, const SkPaint& paint,
+                             SkResourceCache* localCache = nullptr);
 };
 
 #endif
@@ -71,6 +71,8 @@ namespace SkOpts {
     DEFINE_DEFAULT(fill_block_dimensions);
 
     DEFINE_DEFAULT(blit_mask_d32_a8);
+    BlitLCD16Row blit_lcd16_row        = nullptr;
+    BlitLCD16Row blit_lcd16_opaque_row = nullptr;
 
     DEFINE_DEFAULT(blit_row_color32);
     DEFINE_DEFAULT(blit_row_s32a_opaque);
@@ -40,6 +40,10 @@ namespace SkOpts {
     extern bool (*fill_block_dimensions)(SkTextureCompressor::Format, int* x, int* y);
 
     extern void (*blit_mask_d32_a8)(SkPMColor*, size_t, const SkAlpha*, size_t, SkColor, int, int);
+    // Rows of LCD16 masks, as SkBlitMask::BlitLCD16RowFactory() returns.  These are nullptr
+    // unless the CPU has something faster than the platform procs.
+    typedef void (*BlitLCD16Row)(SkPMColor[], const uint16_t[], SkColor, int, SkPMColor);
+    extern BlitLCD16Row blit_lcd16_row, blit_lcd16_opaque_row;
     extern void (*blit_row_color32)(SkPMColor*, const SkPMColor*, int, SkPMColor);
     extern void (*blit_row_s32a_opaque)(SkPMColor*, const SkPMColor*, int, U8CPU);
 
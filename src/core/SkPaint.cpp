@@ -2201,36 +2201,40 @@ static bool has_thick_frame(const SkPaint& paint) {
             paint.getStyle() != SkPaint::kFill_Style;
 }
 
-SkTextBaseIter::SkTextBaseIter(const char text[], size_t length,
-                                   const SkPaint& paint,
-                                   bool applyStrokeAndPathEffects)
-    : fPaint(paint) {
-    fGlyphCacheProc = SkPaint::GetGlyphCacheProc(paint.getTextEncoding(),
-                                                 paint.isDevKernText(),
-                                                 true);
-
-    fPaint.setLinearText(true);
-    fPaint.setMaskFilter(nullptr);   // don't want this affecting our path-cache lookup
+SkScalar SkTextBaseIter::SetupCachePaint(SkPaint* paint, bool* applyStrokeAndPathEffects) {
+    paint->setLinearText(true);
+    paint->setMaskFilter(nullptr);   // don't want this affecting our path-cache lookup
 
-    if (fPaint.getPathEffect() == nullptr && !has_thick_frame(fPaint)) {
-        applyStrokeAndPathEffects = false;
+    if (paint->getPathEffect() == nullptr && !has_thick_frame(*paint)) {
+        *applyStrokeAndPathEffects = false;
     }
 
     // can't use our canonical size if we need to apply patheffects
-    if (fPaint.getPathEffect() == nullptr) {
-        fPaint.setTextSize(SkIntToScalar(SkPaint::kCanonicalTextSizeForPaths));
-        fScale = paint.getTextSize() / SkPaint::kCanonicalTextSizeForPaths;
-        if (has_thick_frame(fPaint)) {
-            fPaint.setStrokeWidth(fPaint.getStrokeWidth() / fScale);
+    SkScalar scale = SK_Scalar1;
+    if (paint->getPathEffect() == nullptr) {
+        scale = paint->getTextSize() / SkPaint::kCanonicalTextSizeForPaths;
+        paint->setTextSize(SkIntToScalar(SkPaint::kCanonicalTextSizeForPaths));
+        if (has_thick_frame(*paint)) {
+            paint->setStrokeWidth(paint->getStrokeWidth() / scale);
         }
-    } else {
-        fScale = SK_Scalar1;
     }
 
-    if (!applyStrokeAndPathEffects) {
-        fPaint.setStyle(SkPaint::kFill_Style);
-        fPaint.setPathEffect(nullptr);
+    if (!*applyStrokeAndPathEffects) {
+        paint->setStyle(SkPaint::kFill_Style);
+        paint->setPathEffect(nullptr);
     }
+    return scale;
+}
+
+SkTextBaseIter::SkTextBaseIter(const char text[], size_t length,
+                                   const SkPaint& paint,
+                                   bool applyStrokeAndPathEffects)
+    : fPaint(paint) {
+    fGlyphCacheProc = SkPaint::GetGlyphCacheProc(paint.getTextEncoding(),
+                                                 paint.isDevKernText(),
+                                                 true);
+
+    fScale = SetupCachePaint(&fPaint, &applyStrokeAndPathEffects);
 
     // SRGBTODO: Is this correct?
     fCache = fPaint.detachCache(nullptr, SkPaint::kFakeGammaAndBoostContrast_ScalerContextFlags,
@@ -10,6 +10,7 @@
 #include "SkPathMeasurePriv.h"
 #include "SkGeometry.h"
 #include "SkPath.h"
+#include "SkResourceCache.h"
 #include "SkTSearch.h"
 
 #define kMaxTValue  0x3FFFFFFF
@@ -689,6 +690,232 @@ bool SkPathMeasure::nextContour() {
     return this->getLength() > 0;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+namespace {
+static unsigned gPathMeasureKeyNamespaceLabel;
+
+struct PathMeasureKey : public SkResourceCache::Key {
+public:
+    PathMeasureKey(uint32_t genID, bool forceClosed, SkScalar resScale)
+        : fGenID(genID)
+        , fForceClosed(forceClosed)
+        , fResScale(resScale)
+    {
+        this->init(&gPathMeasureKeyNamespaceLabel, 0,
+                   sizeof(fGenID) + sizeof(fForceClosed) + sizeof(fResScale));
+    }
+
+    uint32_t    fGenID;
+    uint32_t    fForceClosed;
+    SkScalar    fResScale;
+};
+
+struct PathMeasureRec : public SkResourceCache::Rec {
+    PathMeasureRec(const PathMeasureKey& key, sk_sp<SkPathMeasureSnapshot> snapshot)
+        : fKey(key)
+        , fSnapshot(std::move(snapshot)) {}
+
+    PathMeasureKey                  fKey;
+    sk_sp<SkPathMeasureSnapshot>    fSnapshot;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fSnapshot->approximateBytesUsed();
+    }
+    const char* getCategory() const override { return "path-measure"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* context) {
+        const PathMeasureRec& rec = static_cast<const PathMeasureRec&>(baseRec);
+        *reinterpret_cast<sk_sp<SkPathMeasureSnapshot>*>(context) = rec.fSnapshot;
+        return true;
+    }
+};
+} // namespace
+
+sk_sp<SkPathMeasureSnapshot> SkPathMeasureSnapshot::Make(const SkPath& path, bool forceClosed,
+                                                         SkScalar resScale) {
+    const bool cacheable = !path.isVolatile();
+    PathMeasureKey key(path.getGenerationID(), forceClosed, resScale);
+    sk_sp<SkPathMeasureSnapshot> snapshot;
+    if (cacheable && SkResourceCache::Find(key, PathMeasureRec::Visitor, &snapshot)) {
+        return snapshot;
+    }
+
+    // Every contour SkPathMeasure visits starts with a move emitted by the same iterator, so
+    // counting those tells us exactly how many times to build.
+    int contourCount = 0;
+    {
+        SkPath::Iter iter(path, forceClosed);
+        SkPoint pts[4];
+        SkPath::Verb verb;
+        while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+            contourCount += (SkPath::kMove_Verb == verb);
+        }
+    }
+
+    snapshot.reset(new SkPathMeasureSnapshot);
+    SkPathMeasure meas(path, forceClosed, resScale);
+    for (int i = 0; i < contourCount; ++i) {
+        meas.buildSegments();
+        const int segCount = meas.fSegments.count();
+        if (0 == segCount || 0 == meas.fLength) {
+            continue;
+        }
+
+        Contour* contour = snapshot->fContours.append();
+        contour->fFirstSegment = snapshot->fSegments.count();
+        contour->fSegmentCount = segCount;
+        contour->fLength = meas.fLength;
+        contour->fIsClosed = meas.fIsClosed;
+
+        SkScalar* distances = snapshot->fDistances.append(segCount);
+        Segment* segments = snapshot->fSegments.append(segCount);
+        for (int j = 0; j < segCount; ++j) {
+            const SkPathMeasure::Segment& src = meas.fSegments[j];
+            Segment& dst = segments[j];
+            // This mirrors the interpolation done by SkPathMeasure::distanceToSegment().
+            dst.fStartD = j > 0 ? meas.fSegments[j - 1].fDistance : 0;
+            dst.fStartT = 0;
+            if (j > 0 && meas.fSegments[j - 1].fPtIndex == src.fPtIndex) {
+                dst.fStartT = meas.fSegments[j - 1].getScalarT();
+            }
+            dst.fStopT = src.getScalarT();
+            dst.fTPerD = (dst.fStopT - dst.fStartT) / (src.fDistance - dst.fStartD);
+            dst.fPtIndex = src.fPtIndex;
+            dst.fType = src.fType;
+            distances[j] = src.fDistance;
+        }
+    }
+    snapshot->fPts.swap(meas.fPts);
+
+    if (cacheable) {
+        SkResourceCache::Add(new PathMeasureRec(key, snapshot));
+    }
+    return snapshot;
+}
+
+SkScalar SkPathMeasureSnapshot::getLength(int contour) const {
+    return this->contour(contour).fLength;
+}
+
+bool SkPathMeasureSnapshot::isClosed(int contour) const {
+    return this->contour(contour).fIsClosed;
+}
+
+size_t SkPathMeasureSnapshot::approximateBytesUsed() const {
+    return sizeof(*this) +
+           fContours.reserved() * sizeof(Contour) +
+           fDistances.reserved() * sizeof(SkScalar) +
+           fSegments.reserved() * sizeof(Segment) +
+           fPts.reserved() * sizeof(SkPoint);
+}
+
+// Returns the index (relative to the contour) of the first segment whose end distance is
+// >= distance. hint is the answer for the previous query, or -1.
+int SkPathMeasureSnapshot::findSegment(const Contour& contour, SkScalar distance,
+                                       int hint) const {
+    const SkScalar* distances = fDistances.begin() + contour.fFirstSegment;
+    const int count = contour.fSegmentCount;
+
+    // Queries usually move forward a little at a time; try the hint and its successor first.
+    if (hint >= 0 && hint < count && fSegments[contour.fFirstSegment + hint].fStartD <= distance) {
+        if (distance <= distances[hint]) {
+            return hint;
+        }
+        if (hint + 1 < count && distance <= distances[hint + 1]) {
+            return hint + 1;
+        }
+    }
+
+    int lo = 0,
+        hi = count - 1;
+    while (lo < hi) {
+        int mid = (hi + lo) >> 1;
+        if (distances[mid] < distance) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return hi;
+}
+
+void SkPathMeasureSnapshot::posTan(const Segment& seg, SkScalar distance,
+                                   SkPoint* position, SkVector* tangent) const {
+    SkScalar t = seg.fStartT + (distance - seg.fStartD) * seg.fTPerD;
+    t = SkTPin(t, seg.fStartT, seg.fStopT);
+    compute_pos_tan(&fPts[seg.fPtIndex], seg.fType, t, position, tangent);
+}
+
+void SkPathMeasureSnapshot::getPosTan(int contourIndex, SkScalar distance,
+                                      SkPoint* position, SkVector* tangent) const {
+    const Contour& contour = this->contour(contourIndex);
+    distance = SkTPin(distance, 0.0f, contour.fLength);
+    int index = this->findSegment(contour, distance, -1);
+    this->posTan(fSegments[contour.fFirstSegment + index], distance, position, tangent);
+}
+
+void SkPathMeasureSnapshot::getPosTan(int contourIndex, const SkScalar distances[], int count,
+                                      SkPoint positions[], SkVector tangents[]) const {
+    const Contour& contour = this->contour(contourIndex);
+    int index = -1;
+    for (int i = 0; i < count; ++i) {
+        SkScalar distance = SkTPin(distances[i], 0.0f, contour.fLength);
+        index = this->findSegment(contour, distance, index);
+        this->posTan(fSegments[contour.fFirstSegment + index], distance,
+                     positions ? &positions[i] : nullptr, tangents ? &tangents[i] : nullptr);
+    }
+}
+
+bool SkPathMeasureSnapshot::getSegment(int contourIndex, SkScalar startD, SkScalar stopD,
+                                       SkPath* dst, bool startWithMoveTo) const {
+    SkASSERT(dst);
+    const Contour& contour = this->contour(contourIndex);
+
+    if (startD < 0) {
+        startD = 0;
+    }
+    if (stopD > contour.fLength) {
+        stopD = contour.fLength;
+    }
+    if (startD > stopD) {
+        return false;
+    }
+
+    const Segment* segments = fSegments.begin() + contour.fFirstSegment;
+    int startIndex = this->findSegment(contour, startD, -1);
+    int stopIndex = this->findSegment(contour, stopD, startIndex);
+    const Segment* seg = &segments[startIndex];
+    const Segment* stopSeg = &segments[stopIndex];
+    SkScalar startT = SkTPin(seg->fStartT + (startD - seg->fStartD) * seg->fTPerD,
+                             seg->fStartT, seg->fStopT);
+    SkScalar stopT = SkTPin(stopSeg->fStartT + (stopD - stopSeg->fStartD) * stopSeg->fTPerD,
+                            stopSeg->fStartT, stopSeg->fStopT);
+
+    if (startWithMoveTo) {
+        SkPoint p;
+        compute_pos_tan(&fPts[seg->fPtIndex], seg->fType, startT, &p, nullptr);
+        dst->moveTo(p);
+    }
+
+    if (seg->fPtIndex == stopSeg->fPtIndex) {
+        SkPathMeasure_segTo(&fPts[seg->fPtIndex], seg->fType, startT, stopT, dst);
+    } else {
+        do {
+            SkPathMeasure_segTo(&fPts[seg->fPtIndex], seg->fType, startT, SK_Scalar1, dst);
+            unsigned ptIndex = seg->fPtIndex;
+            do {
+                ++seg;
+            } while (seg->fPtIndex == ptIndex);
+            startT = 0;
+        } while (seg->fPtIndex < stopSeg->fPtIndex);
+        SkPathMeasure_segTo(&fPts[seg->fPtIndex], seg->fType, 0, stopT, dst);
+    }
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
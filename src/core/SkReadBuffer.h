@@ -71,6 +71,7 @@ public:
         kGradientShaderFloatColor_Version  = 49,
         kXfermodeToBlendMode_Version       = 50,
         kXfermodeToBlendMode2_Version      = 51,
+        kCompactTextBlobPositions_Version  = 52,
     };
 
     /**
@@ -8,6 +8,8 @@
 
 #include "SkAtomics.h"
 #include "SkRegionPriv.h"
+#include "SkTDArray.h"
+#include "SkTSort.h"
 #include "SkTemplates.h"
 #include "SkUtils.h"
 
@@ -585,16 +587,254 @@ void SkRegion::translate(int dx, int dy, SkRegion* dst) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+// Where an interval starts or ends in a band: coverage goes up by one at a left side and down
+// by one at a right side.
+struct XEdge {
+    int32_t fX;
+    int32_t fWinding;
+
+    bool operator<(const XEdge& other) const { return fX < other.fX; }
+};
+
+/*  Writes region runs one horizontal band at a time, from the top down. Identical neighbouring
+    scanlines are merged and empty ones above and below everything are dropped, so the runs come
+    out in the same form operate() produces.
+ */
+class RunsBuilder {
+public:
+    RunsBuilder(SkTDArray<SkRegion::RunType>* runs) : fRuns(runs), fPrevScanline(-1) {
+        runs->rewind();
+    }
+
+    // Adds the band [top, bottom), covered wherever at least minCoverage of the intervals
+    // bounded by edges (which must be sorted) overlap.
+    void addBand(int32_t top, int32_t bottom, const SkTDArray<XEdge>& edges, int minCoverage) {
+        SkTDArray<SkRegion::RunType>& runs = *fRuns;
+        if (fPrevScanline < 0) {
+            runs.append()[0] = top;
+        }
+
+        // Append this band's scanline: bottom, interval count, intervals, x-sentinel.
+        const int scanline = runs.count();
+        runs.append(2);
+        int coverage = 0;
+        for (int e = 0; e < edges.count();) {
+            const int32_t x = edges[e].fX;
+            const bool wasInside = coverage >= minCoverage;
+            do {
+                coverage += edges[e++].fWinding;
+            } while (e < edges.count() && edges[e].fX == x);
+            if (wasInside != (coverage >= minCoverage)) {
+                *runs.append() = x;
+            }
+        }
+        const int intervalCount = (runs.count() - scanline - 2) >> 1;
+        if (fPrevScanline < 0 && 0 == intervalCount) {
+            runs.rewind();  // nothing covered yet
+            return;
+        }
+        runs[scanline] = bottom;
+        runs[scanline + 1] = intervalCount;
+        *runs.append() = SkRegion::kRunTypeSentinel;
+
+        if (fPrevScanline >= 0 && runs[fPrevScanline + 1] == intervalCount &&
+                !memcmp(&runs[fPrevScanline + 2], &runs[scanline + 2],
+                        2 * intervalCount * sizeof(SkRegion::RunType))) {
+            // Same as the scanline above, so just extend that one down.
+            runs[fPrevScanline] = bottom;
+            runs.setCount(scanline);
+        } else {
+            fPrevScanline = scanline;
+        }
+    }
+
+    // Returns false (and leaves the runs empty) if nothing was covered.
+    bool finish() {
+        if (fPrevScanline < 0) {
+            return false;
+        }
+        if (0 == (*fRuns)[fPrevScanline + 1]) {
+            fRuns->setCount(fPrevScanline);  // drop the empty scanline below everything
+        }
+        *fRuns->append() = SkRegion::kRunTypeSentinel;
+        return true;
+    }
+
+private:
+    SkTDArray<SkRegion::RunType>* fRuns;
+    int                           fPrevScanline;  // index of the last scanline's bottom
+};
+
+// Sorts ys[0..count) and removes duplicates, returning how many are left.
+int sort_unique(int32_t ys[], int count) {
+    SkTQSort(ys, ys + count - 1);
+    int uniqueCount = 1;
+    for (int i = 1; i < count; ++i) {
+        if (ys[i] != ys[uniqueCount - 1]) {
+            ys[uniqueCount++] = ys[i];
+        }
+    }
+    return uniqueCount;
+}
+
+}  // namespace
+
+/*  Sweep down through the rects one band at a time, where the bands are bounded by consecutive
+    distinct tops and bottoms, and write the runs for the area covered by at least minCoverage
+    of the (non-empty) rects. Returns false if nothing is covered.
+ */
+static bool sweep_rects(const SkIRect rects[], int count, int minCoverage,
+                        SkTDArray<SkRegion::RunType>* runs) {
+    SkAutoTMalloc<const SkIRect*> byTop(count);
+    SkAutoTMalloc<int32_t> ys(2 * count);
+    int rectCount = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!rects[i].isEmpty()) {
+            byTop[rectCount] = &rects[i];
+            ys[2 * rectCount] = rects[i].fTop;
+            ys[2 * rectCount + 1] = rects[i].fBottom;
+            rectCount += 1;
+        }
+    }
+    RunsBuilder builder(runs);
+    if (rectCount < minCoverage) {
+        return false;
+    }
+
+    SkTQSort(byTop.get(), byTop.get() + rectCount - 1, [](const SkIRect* a, const SkIRect* b) {
+        return a->fTop < b->fTop;
+    });
+    const int yCount = sort_unique(ys.get(), 2 * rectCount);
+
+    SkTDArray<const SkIRect*> active;
+    SkTDArray<XEdge> edges;
+    int nextRect = 0;
+    for (int i = 0; i + 1 < yCount; ++i) {
+        const int32_t top = ys[i];
+
+        for (int j = active.count() - 1; j >= 0; --j) {
+            if (active[j]->fBottom <= top) {
+                active.removeShuffle(j);
+            }
+        }
+        while (nextRect < rectCount && byTop[nextRect]->fTop <= top) {
+            *active.append() = byTop[nextRect++];
+        }
+
+        edges.rewind();
+        if (active.count() >= minCoverage) {
+            for (const SkIRect* r : active) {
+                *edges.append() = { r->fLeft, 1 };
+                *edges.append() = { r->fRight, -1 };
+            }
+            SkTQSort(edges.begin(), edges.end() - 1);
+        }
+        builder.addBand(top, ys[i + 1], edges, minCoverage);
+    }
+    return builder.finish();
+}
+
 bool SkRegion::setRects(const SkIRect rects[], int count) {
+    SkTDArray<RunType> runs;
+    if (!sweep_rects(rects, count, 1, &runs)) {
+        return this->setEmpty();
+    }
+    return this->setRuns(runs.begin(), runs.count());
+}
+
+bool SkRegion::setRegions(const SkRegion* const regions[], int count, Op op) {
     if (0 == count) {
-        this->setEmpty();
-    } else {
-        this->setRect(rects[0]);
-        for (int i = 1; i < count; i++) {
-            this->op(rects[i], kUnion_Op);
+        return this->setEmpty();
+    }
+    if (kUnion_Op != op && kIntersect_Op != op) {
+        SkRegion result(*regions[0]);
+        for (int i = 1; i < count; ++i) {
+            result.op(*regions[i], op);
+        }
+        this->swap(result);
+        return !this->isEmpty();
+    }
+
+    // Walk every region's scanlines together, one band at a time. Each region's intervals on a
+    // scanline are disjoint, so a point is in all of the regions exactly when count of them
+    // cover it.
+    const int minCoverage = kUnion_Op == op ? 1 : count;
+
+    struct Cursor {
+        int32_t         fTop;       // top of the current scanline
+        const RunType*  fScanline;  // the current scanline's bottom, followed by its intervals
+    };
+    SkAutoTMalloc<RunType> rectRuns(count * kRectRegionRuns);
+    SkAutoTMalloc<Cursor> cursors(count);
+    SkTDArray<int32_t> ys;
+    int cursorCount = 0;
+    for (int i = 0; i < count; ++i) {
+        if (regions[i]->isEmpty()) {
+            continue;
         }
+        int intervals;
+        const RunType* runs = regions[i]->getRuns(&rectRuns[i * kRectRegionRuns], &intervals);
+        Cursor& cursor = cursors[cursorCount++];
+        cursor.fTop = runs[0];
+        cursor.fScanline = runs + 1;
+
+        *ys.append() = runs[0];
+        for (runs += 1; kRunTypeSentinel != runs[0]; runs = skip_intervals(runs + 2)) {
+            *ys.append() = runs[0];
+        }
+    }
+    if (cursorCount < minCoverage) {
+        return this->setEmpty();
+    }
+
+    SkTQSort(cursors.get(), cursors.get() + cursorCount - 1, [](const Cursor& a, const Cursor& b) {
+        return a.fTop < b.fTop;
+    });
+    const int yCount = sort_unique(ys.begin(), ys.count());
+
+    SkTDArray<RunType> runs;
+    RunsBuilder builder(&runs);
+    SkTDArray<Cursor*> active;
+    SkTDArray<XEdge> edges;
+    int nextCursor = 0;
+    for (int i = 0; i + 1 < yCount; ++i) {
+        const int32_t top = ys[i];
+
+        while (nextCursor < cursorCount && cursors[nextCursor].fTop <= top) {
+            *active.append() = &cursors[nextCursor++];
+        }
+        for (int j = active.count() - 1; j >= 0; --j) {
+            Cursor* cursor = active[j];
+            while (cursor->fScanline[0] <= top) {
+                cursor->fTop = cursor->fScanline[0];
+                cursor->fScanline = skip_intervals(cursor->fScanline + 2);
+            }
+            if (kRunTypeSentinel == cursor->fScanline[0]) {
+                active.removeShuffle(j);
+            }
+        }
+
+        edges.rewind();
+        if (active.count() >= minCoverage) {
+            for (const Cursor* cursor : active) {
+                for (const RunType* x = cursor->fScanline + 2; kRunTypeSentinel != x[0]; x += 2) {
+                    *edges.append() = { x[0], 1 };
+                    *edges.append() = { x[1], -1 };
+                }
+            }
+            if (!edges.isEmpty()) {
+                SkTQSort(edges.begin(), edges.end() - 1);
+            }
+        }
+        builder.addBand(top, ys[i + 1], edges, minCoverage);
+    }
+
+    if (!builder.finish()) {
+        return this->setEmpty();
     }
-    return !this->isEmpty();
+    return this->setRuns(runs.begin(), runs.count());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
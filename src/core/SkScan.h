@@ -24,6 +24,8 @@ class SkPath;
 typedef SkIRect SkXRect;
 
 extern std::atomic<bool> gSkUseAnalyticAA;
+// See SkGraphics::SetAAFillBands().
+extern std::atomic<int> gSkAAFillBands;
 
 class AdditiveBlitter;
 
@@ -67,6 +69,20 @@ public:
     static void HairRoundPath(const SkPath&, const SkRasterClip&, SkBlitter*);
     static void AntiHairRoundPath(const SkPath&, const SkRasterClip&, SkBlitter*);
 
+    /**
+     *  Returns how many horizontal bands, at most maxBandCount, AntiFillPathInBands() would
+     *  split this fill into, or a count less than two if the path should be filled in one pass
+     *  with AntiFillPath().
+     */
+    static int CountAntiFillBands(const SkPath&, const SkRasterClip&, int maxBandCount);
+    /**
+     *  Fills the path exactly like AntiFillPath(), but walks the rows of each band in parallel
+     *  on an SkTaskGroup. blitters[i] receives only the rows of band i. bandCount must come
+     *  from CountAntiFillBands().
+     */
+    static void AntiFillPathInBands(const SkPath&, const SkRasterClip&,
+                                    SkBlitter* const blitters[], int bandCount);
+
 private:
     friend class SkAAClip;
     friend class SkRegion;
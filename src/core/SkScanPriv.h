@@ -34,6 +34,12 @@ void sk_fill_path(const SkPath& path, const SkIRect& clipRect,
                   SkBlitter* blitter, int start_y, int stop_y, int shiftEdgesUp,
                   bool pathContainedInClip);
 
+// Fills a non-convex, non-inverse path like sk_fill_path(), but builds its edges once and walks
+// the rows from bandTops[i] to bandTops[i + 1] through blitters[i] on an SkTaskGroup.
+void sk_fill_path_in_bands(const SkPath& path, const SkIRect& clipRect,
+                           SkBlitter* const blitters[], const int bandTops[], int bandCount,
+                           int shiftEdgesUp, bool pathContainedInClip);
+
 void aaa_fill_path(const SkPath& path, const SkIRect& clipRect, AdditiveBlitter*,
                    int start_y, int stop_y, bool pathContainedInClip, bool isUsingMask,
                    bool forceRLE);
@@ -11,6 +11,7 @@
 #include "SkAnalyticEdge.h"
 #include "SkEdgeBuilder.h"
 #include "SkGeometry.h"
+#include "SkNx.h"
 #include "SkPath.h"
 #include "SkQuadClipper.h"
 #include "SkRasterClip.h"
@@ -88,6 +89,53 @@ static inline void addAlpha(SkAlpha& alpha, SkAlpha delta) {
     alpha = SkAlphaRuns::CatchOverflow(alpha + (int)delta);
 }
 
+// The following helpers process a whole row of alphas 16 (or 4) at a time. Since every sum is
+// at most 256 (see addAlpha), a saturating add produces exactly what CatchOverflow produces.
+static inline void addAlphas(SkAlpha* dst, const SkAlpha* src, int len) {
+    for (; len >= 16; dst += 16, src += 16, len -= 16) {
+        Sk16b::Load(dst).saturatedAdd(Sk16b::Load(src)).store(dst);
+    }
+    for (int i = 0; i < len; i++) {
+        addAlpha(dst[i], src[i]);
+    }
+}
+
+static inline void addAlphas(SkAlpha* dst, SkAlpha alpha, int len) {
+    Sk16b alpha16(alpha);
+    for (; len >= 16; dst += 16, len -= 16) {
+        Sk16b::Load(dst).saturatedAdd(alpha16).store(dst);
+    }
+    for (int i = 0; i < len; i++) {
+        addAlpha(dst[i], alpha);
+    }
+}
+
+// dst[i] = max(dst[i] - src[i], 0)
+static inline void subAlphas(SkAlpha* dst, const SkAlpha* src, int len) {
+    for (; len >= 16; dst += 16, src += 16, len -= 16) {
+        Sk16b a = Sk16b::Load(dst);
+        (a - Sk16b::Min(a, Sk16b::Load(src))).store(dst);
+    }
+    for (int i = 0; i < len; i++) {
+        dst[i] = dst[i] > src[i] ? dst[i] - src[i] : 0;
+    }
+}
+
+// alphas[i] = (alpha16 + i * dY) >> 8, truncated to 8 bits just like the scalar SkAlpha store.
+static inline void rampAlphas(SkAlpha* alphas, SkFixed alpha16, SkFixed dY, int count) {
+    Sk4i a(alpha16, alpha16 + dY, alpha16 + dY * 2, alpha16 + dY * 3),
+         step(dY * 4);
+    for (; count >= 4; alphas += 4, count -= 4) {
+        SkNx_cast<uint8_t>((a >> 8) & 0xFF).store(alphas);
+        a = a + step;
+        alpha16 += dY * 4;
+    }
+    for (int i = 0; i < count; i++) {
+        alphas[i] = alpha16 >> 8;
+        alpha16 += dY;
+    }
+}
+
 class AdditiveBlitter : public SkBlitter {
 public:
     virtual ~AdditiveBlitter() {}
@@ -231,10 +279,7 @@ void MaskAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha alpha) {
 
 void MaskAdditiveBlitter::blitAntiH(int x, int y, int width, const SkAlpha alpha) {
     SkASSERT(x >= fMask.fBounds.fLeft -1);
-    uint8_t* row = this->getRow(y);
-    for (int i=0; i<width; i++) {
-        addAlpha(row[x + i], alpha);
-    }
+    addAlphas(this->getRow(y) + x, alpha, width);
 }
 
 void MaskAdditiveBlitter::blitV(int x, int y, int height, SkAlpha alpha) {
@@ -430,9 +475,7 @@ void RunBasedAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha antialias[],
         }
         fRuns.fRuns[x + i] = 1;
     }
-    for (int i=0; i<len; i++) {
-        addAlpha(fRuns.fAlpha[x + i], antialias[i]);
-    }
+    addAlphas(fRuns.fAlpha + x, antialias, len);
 }
 void RunBasedAdditiveBlitter::blitAntiH(int x, int y, const SkAlpha alpha) {
     checkY(y);
@@ -523,10 +566,7 @@ static inline void computeAlphaAboveLine(SkAlpha* alphas, SkFixed l, SkFixed r,
         SkFixed firstH = SkFixedMul(first, dY); // vertical edge of the left-most triangle
         alphas[0] = SkFixedMul(first, firstH) >> 9; // triangle alpha
         SkFixed alpha16 = firstH + (dY >> 1); // rectangle plus triangle
-        for (int i = 1; i < R - 1; i++) {
-            alphas[i] = alpha16 >> 8;
-            alpha16 += dY;
-        }
+        rampAlphas(alphas + 1, alpha16, dY, R - 2);
         alphas[R - 1] = fullAlpha - partialTriangleToAlpha(last, dY);
     }
 }
@@ -547,10 +587,8 @@ static inline void computeAlphaBelowLine(
         SkFixed lastH = SkFixedMul(last, dY); // vertical edge of the right-most triangle
         alphas[R-1] = SkFixedMul(last, lastH) >> 9; // triangle alpha
         SkFixed alpha16 = lastH + (dY >> 1); // rectangle plus triangle
-        for (int i = R - 2; i > 0; i--) {
-            alphas[i] = alpha16 >> 8;
-            alpha16 += dY;
-        }
+        // alphas[R - 2] down to alphas[1] get alpha16, alpha16 + dY, ...; fill them left to right.
+        rampAlphas(alphas + 1, alpha16 + (R - 3) * dY, -dY, R - 2);
         alphas[0] = fullAlpha - partialTriangleToAlpha(first, dY);
     }
 }
@@ -594,9 +632,7 @@ static inline void blit_two_alphas(AdditiveBlitter* blitter, int y, int x,
 static SK_ALWAYS_INLINE void blit_full_alpha(AdditiveBlitter* blitter, int y, int x, int len,
                             SkAlpha fullAlpha, SkAlpha* maskRow, bool isUsingMask) {
     if (isUsingMask) {
-        for (int i=0; i<len; i++) {
-            addAlpha(maskRow[x + i], fullAlpha);
-        }
+        addAlphas(maskRow + x, fullAlpha, len);
     } else {
         if (fullAlpha == 0xFF) {
             blitter->getRealBlitter()->blitH(x, y, len);
@@ -636,10 +672,8 @@ static void blit_aaa_trapezoid_row(AdditiveBlitter* blitter, int y,
     SkAlpha* tempAlphas = alphas + len + 1;
     int16_t* runs = (int16_t*)(alphas + (len + 1) * 2);
 
-    for (int i = 0; i < len; i++) {
-        runs[i] = 1;
-        alphas[i] = fullAlpha;
-    }
+    memset(alphas, fullAlpha, len);
+    sk_memset16((uint16_t*)runs, 1, len);
     runs[len] = 0;
 
     int uL = SkFixedFloorToInt(ul);
@@ -654,13 +688,7 @@ static void blit_aaa_trapezoid_row(AdditiveBlitter* blitter, int y,
     } else {
         computeAlphaBelowLine(tempAlphas + uL - L, ul - (uL << 16), ll - (uL << 16),
                 lDY, fullAlpha);
-        for (int i = uL; i < lL; i++) {
-            if (alphas[i - L] > tempAlphas[i - L]) {
-                alphas[i - L] -= tempAlphas[i - L];
-            } else {
-                alphas[i - L] = 0;
-            }
-        }
+        subAlphas(alphas + uL - L, tempAlphas + uL - L, lL - uL);
     }
 
     int uR = SkFixedFloorToInt(ur);
@@ -675,19 +703,11 @@ static void blit_aaa_trapezoid_row(AdditiveBlitter* blitter, int y,
     } else {
         computeAlphaAboveLine(tempAlphas + uR - L, ur - (uR << 16), lr - (uR << 16),
                 rDY, fullAlpha);
-        for (int i = uR; i < lR; i++) {
-            if (alphas[i - L] > tempAlphas[i - L]) {
-                alphas[i - L] -= tempAlphas[i - L];
-            } else {
-                alphas[i - L] = 0;
-            }
-        }
+        subAlphas(alphas + uR - L, tempAlphas + uR - L, lR - uR);
     }
 
     if (isUsingMask) {
-        for (int i=0; i<len; i++) {
-            addAlpha(maskRow[L + i], alphas[i]);
-        }
+        addAlphas(maskRow + L, alphas, len);
     } else {
         if (fullAlpha == 0xFF) { // Real blitter is faster than RunBasedAdditiveBlitter
             blitter->getRealBlitter()->blitAntiH(L, y, alphas, runs);
@@ -775,3 +775,74 @@ void SkScan::AntiFillPath(const SkPath& path, const SkRasterClip& clip,
         SkScan::AntiFillPath(path, tmp, &aaBlitter, true);
     }
 }
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Bands shorter than this don't recoup the cost of stepping and copying the edges for them.
+static const int kMinAntiFillBandHeight = 64;
+
+// Only fills that AntiFillPath() would hand to the RLE supersampler's general edge walker can be
+// banded; anything else is drawn in one pass. Returns the path's rounded out bounds in ir.
+static bool can_anti_fill_in_bands(const SkPath& path, const SkRasterClip& clip, SkIRect* ir) {
+    if (clip.isEmpty() || !clip.isBW() || path.isInverseFillType() || path.isConvex()) {
+        return false;
+    }
+    if (!safeRoundOut(path.getBounds(), ir, SK_MaxS32 >> SHIFT)) {
+        return false;
+    }
+    const SkIRect& clipBounds = clip.getBounds();
+    SkIRect clippedIR;
+    return clippedIR.intersect(*ir, clipBounds) &&
+           !rect_overflows_short_shift(clippedIR, SHIFT) &&
+           clipBounds.fRight <= 32767 && clipBounds.fBottom <= 32767 &&
+           !MaskSuperBlitter::CanHandleRect(*ir);
+}
+
+int SkScan::CountAntiFillBands(const SkPath& path, const SkRasterClip& clip, int maxBandCount) {
+    SkIRect ir;
+    if (maxBandCount <= 1 || !can_anti_fill_in_bands(path, clip, &ir)) {
+        return 0;
+    }
+    SkAssertResult(ir.intersect(clip.getBounds()));
+    return SkTMin(maxBandCount, ir.height() / kMinAntiFillBandHeight);
+}
+
+namespace {
+// The supersampler flushes its last row when it is deleted, so it goes before its clipper.
+struct AntiFillBand {
+    AntiFillBand(SkBlitter* blitter, const SkRegion& clip, const SkIRect& ir,
+                 const SkIRect& rows)
+        : fClipper(blitter, &clip, ir)
+        , fSuperBlitter(fClipper.getBlitter(), rows, clip, false) {}
+
+    SkScanClipper   fClipper;
+    SuperBlitter    fSuperBlitter;
+};
+}
+
+void SkScan::AntiFillPathInBands(const SkPath& path, const SkRasterClip& clip,
+                                 SkBlitter* const blitters[], int bandCount) {
+    SkIRect ir;
+    SkAssertResult(can_anti_fill_in_bands(path, clip, &ir));
+    const SkRegion& clipRgn = clip.bwRgn();
+    SkIRect rows = ir;
+    SkAssertResult(rows.intersect(clipRgn.getBounds()));
+    SkASSERT(bandCount > 1 && bandCount <= rows.height());
+
+    // Every band keeps the full width, so its runs match those of a single pass.
+    SkAutoTArray<int> bandTops(bandCount + 1);
+    SkAutoTArray<std::unique_ptr<AntiFillBand>> bands(bandCount);
+    SkAutoTArray<SkBlitter*> superBlitters(bandCount);
+    for (int index = 0; index <= bandCount; ++index) {
+        bandTops[index] = rows.fTop + rows.height() * index / bandCount;
+    }
+    for (int index = 0; index < bandCount; ++index) {
+        SkIRect band = ir;
+        band.fTop = bandTops[index];
+        band.fBottom = bandTops[index + 1];
+        bands[index].reset(new AntiFillBand(blitters[index], clipRgn, ir, band));
+        superBlitters[index] = &bands[index]->fSuperBlitter;
+    }
+    sk_fill_path_in_bands(path, clipRgn.getBounds(), superBlitters.get(), bandTops.get(),
+                          bandCount, SHIFT, bands[0]->fClipper.getClipRect() == nullptr);
+}
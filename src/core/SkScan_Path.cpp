@@ -14,6 +14,7 @@
 #include "SkQuadClipper.h"
 #include "SkRasterClip.h"
 #include "SkRegion.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 #include "SkTSort.h"
 
@@ -512,6 +513,129 @@ void sk_fill_path(const SkPath& path, const SkIRect& clipRect, SkBlitter* blitte
     }
 }
 
+// Steps the edges from row start_y to row stop_y without blitting. The edges must end up in
+// the same order walk_edges() would leave them in, so this mirrors its loop exactly.
+static void advance_edges(SkEdge* prevHead, int start_y, int stop_y) {
+    for (int curr_y = start_y; curr_y < stop_y; ++curr_y) {
+        SkEdge* currE = prevHead->fNext;
+        SkFixed prevX = prevHead->fX;
+
+        while (currE->fFirstY <= curr_y) {
+            SkEdge* next = currE->fNext;
+            SkFixed newX;
+
+            if (currE->fLastY == curr_y) {
+                if (currE->fCurveCount < 0) {
+                    if (((SkCubicEdge*)currE)->updateCubic()) {
+                        newX = currE->fX;
+                        goto NEXT_X;
+                    }
+                } else if (currE->fCurveCount > 0) {
+                    if (((SkQuadraticEdge*)currE)->updateQuadratic()) {
+                        newX = currE->fX;
+                        goto NEXT_X;
+                    }
+                }
+                remove_edge(currE);
+            } else {
+                newX = currE->fX + currE->fDX;
+                currE->fX = newX;
+            NEXT_X:
+                if (newX < prevX) {
+                    backward_insert_edge_based_on_x(currE  SkPARAM(curr_y));
+                } else {
+                    prevX = newX;
+                }
+            }
+            currE = next;
+        }
+        insert_new_edges(currE, curr_y + 1);
+    }
+}
+
+// Copies the edges after prevHead into alloc, linked between head and tail, for a walk that
+// starts at row start_y. Edges already under way start again at start_y so the copy is sorted
+// the way walk_edges() expects. A curve edge whose segments are used up walks like a line, so
+// only its count decides how much of it to copy.
+static void copy_edges(const SkEdge* prevHead, int start_y, SkEdge* head, SkEdge* tail,
+                       SkChunkAlloc* alloc) {
+    head->fPrev = nullptr;
+    head->fFirstY = kEDGE_HEAD_Y;
+    head->fX = SK_MinS32;
+    tail->fNext = nullptr;
+    tail->fFirstY = kEDGE_TAIL_Y;
+
+    SkEdge* prev = head;
+    for (const SkEdge* edge = prevHead->fNext; edge->fFirstY != kEDGE_TAIL_Y;
+            edge = edge->fNext) {
+        size_t size = edge->fCurveCount < 0 ? sizeof(SkCubicEdge)
+                    : edge->fCurveCount > 0 ? sizeof(SkQuadraticEdge) : sizeof(SkEdge);
+        SkEdge* copy = (SkEdge*)alloc->allocThrow(size);
+        memcpy(copy, edge, size);
+        copy->fFirstY = SkTMax(copy->fFirstY, start_y);
+        copy->fPrev = prev;
+        prev->fNext = copy;
+        prev = copy;
+    }
+    prev->fNext = tail;
+    tail->fPrev = prev;
+}
+
+void sk_fill_path_in_bands(const SkPath& path, const SkIRect& clipRect,
+                           SkBlitter* const blitters[], const int bandTops[], int bandCount,
+                           int shiftEdgesUp, bool pathContainedInClip) {
+    SkASSERT(!path.isConvex() && !path.isInverseFillType());
+
+    SkIRect shiftedClip = clipRect;
+    shiftedClip.fLeft <<= shiftEdgesUp;
+    shiftedClip.fRight <<= shiftEdgesUp;
+    shiftedClip.fTop <<= shiftEdgesUp;
+    shiftedClip.fBottom <<= shiftEdgesUp;
+
+    SkEdgeBuilder   builder;
+    SkIRect* builderClip = pathContainedInClip ? nullptr : &shiftedClip;
+    int count = builder.build(path, builderClip, shiftEdgesUp, true);
+    SkASSERT(count >= 0);
+    if (0 == count) {
+        return;
+    }
+
+    SkEdge headEdge, tailEdge, *last;
+    SkEdge* edge = sort_edges(builder.edgeList(), count, &last);
+
+    headEdge.fPrev = nullptr;
+    headEdge.fNext = edge;
+    headEdge.fFirstY = kEDGE_HEAD_Y;
+    headEdge.fX = SK_MinS32;
+    edge->fPrev = &headEdge;
+
+    tailEdge.fPrev = last;
+    tailEdge.fNext = nullptr;
+    tailEdge.fFirstY = kEDGE_TAIL_Y;
+    last->fNext = &tailEdge;
+
+    // Each band walks its own copy of the edges, taken once the shared list has been stepped
+    // down to the band's top row. The copies stay alive until every band is done.
+    SkChunkAlloc alloc(16*1024);
+    SkAutoTArray<SkEdge> bandHeads(bandCount), bandTails(bandCount);
+    SkTaskGroup tasks;
+    int curr_y = SkLeftShift(bandTops[0], shiftEdgesUp);
+    for (int index = 0; index < bandCount; ++index) {
+        int start_y = SkLeftShift(bandTops[index], shiftEdgesUp);
+        int stop_y = SkLeftShift(bandTops[index + 1], shiftEdgesUp);
+        SkASSERT(pathContainedInClip ||
+                 (start_y >= shiftedClip.fTop && stop_y <= shiftedClip.fBottom));
+        advance_edges(&headEdge, curr_y, start_y);
+        curr_y = start_y;
+        copy_edges(&headEdge, start_y, &bandHeads[index], &bandTails[index], &alloc);
+        tasks.add([&, index, start_y, stop_y] {
+            walk_edges(&bandHeads[index], path.getFillType(), blitters[index], start_y, stop_y,
+                       nullptr, shiftedClip.right());
+        });
+    }
+    tasks.wait();
+}
+
 void sk_blit_above(SkBlitter* blitter, const SkIRect& ir, const SkRegion& clip) {
     const SkIRect& cr = clip.getBounds();
     SkIRect tmp;
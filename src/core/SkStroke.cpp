@@ -7,6 +7,7 @@
 
 #include "SkStrokerPriv.h"
 #include "SkGeometry.h"
+#include "SkNx.h"
 #include "SkPathPriv.h"
 
 enum {
@@ -129,6 +130,7 @@ public:
 
     void moveTo(const SkPoint&);
     void lineTo(const SkPoint&, const SkPath::Iter* iter = nullptr);
+    void polylineTo(const SkPoint pts[], int count, bool closed);
     void quadTo(const SkPoint&, const SkPoint&);
     void conicTo(const SkPoint&, const SkPoint&, SkScalar weight);
     void cubicTo(const SkPoint&, const SkPoint&, const SkPoint&);
@@ -237,6 +239,7 @@ private:
     void    finishContour(bool close, bool isLine);
     bool    preJoinTo(const SkPoint&, SkVector* normal, SkVector* unitNormal,
                       bool isLine);
+    void    joinTo(const SkVector& normal, const SkVector& unitNormal, bool isLine);
     void    postJoinTo(const SkPoint&, const SkVector& normal,
                        const SkVector& unitNormal);
 
@@ -249,9 +252,6 @@ bool SkPathStroker::preJoinTo(const SkPoint& currPt, SkVector* normal,
                               SkVector* unitNormal, bool currIsLine) {
     SkASSERT(fSegmentCount >= 0);
 
-    SkScalar    prevX = fPrevPt.fX;
-    SkScalar    prevY = fPrevPt.fY;
-
     if (!set_normal_unitnormal(fPrevPt, currPt, fResScale, fRadius, normal, unitNormal)) {
         if (SkStrokerPriv::CapFactory(SkPaint::kButt_Cap) == fCapper) {
             return false;
@@ -263,19 +263,23 @@ bool SkPathStroker::preJoinTo(const SkPoint& currPt, SkVector* normal,
         unitNormal->set(1, 0);
     }
 
+    this->joinTo(*normal, *unitNormal, currIsLine);
+    return true;
+}
+
+void SkPathStroker::joinTo(const SkVector& normal, const SkVector& unitNormal, bool currIsLine) {
     if (fSegmentCount == 0) {
-        fFirstNormal = *normal;
-        fFirstUnitNormal = *unitNormal;
-        fFirstOuterPt.set(prevX + normal->fX, prevY + normal->fY);
+        fFirstNormal = normal;
+        fFirstUnitNormal = unitNormal;
+        fFirstOuterPt.set(fPrevPt.fX + normal.fX, fPrevPt.fY + normal.fY);
 
         fOuter.moveTo(fFirstOuterPt.fX, fFirstOuterPt.fY);
-        fInner.moveTo(prevX - normal->fX, prevY - normal->fY);
+        fInner.moveTo(fPrevPt.fX - normal.fX, fPrevPt.fY - normal.fY);
     } else {    // we have a previous segment
-        fJoiner(&fOuter, &fInner, fPrevUnitNormal, fPrevPt, *unitNormal,
+        fJoiner(&fOuter, &fInner, fPrevUnitNormal, fPrevPt, unitNormal,
                 fRadius, fInvMiterLimit, fPrevIsLine, currIsLine);
     }
     fPrevIsLine = currIsLine;
-    return true;
 }
 
 void SkPathStroker::postJoinTo(const SkPoint& currPt, const SkVector& normal,
@@ -434,6 +438,153 @@ void SkPathStroker::lineTo(const SkPoint& currPt, const SkPath::Iter* iter) {
     this->postJoinTo(currPt, normal, unitNormal);
 }
 
+// Computes the unit normal of each of the count segments pts[i] -> pts[i + 1], exactly as
+// set_normal_unitnormal() would. The deltas and squared lengths are computed four at a time; the
+// square root and division stay scalar, since Sk4f only estimates them on ARMv7 NEON. valid[i] is
+// false where set_normal_unitnormal() would fail or would need its (slow) double precision
+// fallback; the caller handles those itself.
+static void set_unit_normals(const SkPoint pts[], int count, SkScalar scale,
+                             SkVector unitNormals[], bool valid[]) {
+    int i = 0;
+#if !(defined(SK_CPU_ARM32) && defined(SK_ARM_HAS_NEON))
+    // (ARMv7 NEON also flushes denormals to zero, so it keeps to the scalar loop below.)
+    const SkScalar kNearlyZeroSquared = SK_ScalarNearlyZero * SK_ScalarNearlyZero;
+    for (; i + 4 <= count; i += 4) {
+        const SkPoint* p = pts + i;
+        Sk4f dx = (Sk4f(p[1].fX, p[2].fX, p[3].fX, p[4].fX) -
+                   Sk4f(p[0].fX, p[1].fX, p[2].fX, p[3].fX)) * scale,
+             dy = (Sk4f(p[1].fY, p[2].fY, p[3].fY, p[4].fY) -
+                   Sk4f(p[0].fY, p[1].fY, p[2].fY, p[3].fY)) * scale;
+        Sk4f mag2 = dx * dx + dy * dy;
+        for (int j = 0; j < 4; ++j) {
+            valid[i + j] = mag2[j] > kNearlyZeroSquared && mag2[j] < SK_ScalarInfinity;
+            if (valid[i + j]) {
+                SkScalar invMag = 1 / sk_float_sqrt(mag2[j]);
+                // rotateCCW()
+                unitNormals[i + j].set(dy[j] * invMag, -(dx[j] * invMag));
+            }
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        valid[i] = set_normal_unitnormal(pts[i], pts[i + 1], scale, 1, &unitNormals[i],
+                                         &unitNormals[i]);
+    }
+}
+
+// Same as calling lineTo(pts[i], iter) for i in [1, count), where pts[0] is the current point
+// and pts[] is the rest of the contour's lines. closed says whether a close verb ends the run;
+// if so, pts[] may already end with the iterator's implicit closing line. The segment normals
+// are computed up front in bulk, and the has_valid_tangent() lookahead that lineTo() does for
+// teeny lines is answered from bounds gathered in one backwards scan.
+void SkPathStroker::polylineTo(const SkPoint pts[], int count, bool closed) {
+    SkASSERT(count >= 2 && pts[0] == fPrevPt);
+    const int segCount = count - 1;
+
+    SkAutoSTMalloc<64, SkVector> unitNormals(segCount);
+    SkAutoSTMalloc<64, bool> normalIsValid(segCount);
+    set_unit_normals(pts, segCount, fResScale, unitNormals.get(), normalIsValid.get());
+
+    // has_valid_tangent() looks past the current line for a line that isn't degenerate, measured
+    // from the current point: skipped lines don't move it. A close is a tangent if the current
+    // point isn't the move point. (An implicit close line at the end of pts[] can be scanned
+    // like the others: it only matters when the current point is the move point it ends at.)
+    const int last = count - 1;
+    // later[i] bounds pts[i + 2 .. last], and records the points at its extremes.
+    struct Later {
+        SkRect  fBounds;
+        int     fExtremes[4];
+    };
+    SkAutoSTMalloc<64, Later> later(segCount);
+    for (int i = segCount - 1; i >= 0; --i) {
+        Later& l = later[i];
+        int j = i + 2;
+        if (j > last) {
+            l.fBounds.setEmpty();
+            continue;
+        }
+        if (j == last) {
+            l.fBounds.set(pts[j], pts[j]);
+            l.fExtremes[0] = l.fExtremes[1] = l.fExtremes[2] = l.fExtremes[3] = j;
+            continue;
+        }
+        l = later[i + 1];
+        if (pts[j].fX < l.fBounds.fLeft) {
+            l.fBounds.fLeft = pts[j].fX;
+            l.fExtremes[0] = j;
+        }
+        if (pts[j].fY < l.fBounds.fTop) {
+            l.fBounds.fTop = pts[j].fY;
+            l.fExtremes[1] = j;
+        }
+        if (pts[j].fX > l.fBounds.fRight) {
+            l.fBounds.fRight = pts[j].fX;
+            l.fExtremes[2] = j;
+        }
+        if (pts[j].fY > l.fBounds.fBottom) {
+            l.fBounds.fBottom = pts[j].fY;
+            l.fExtremes[3] = j;
+        }
+    }
+    auto laterTangentIsValid = [&](int i) {
+        const SkPoint& curr = pts[i + 1];
+        // the close from curr back to the move point
+        if (closed && curr != fFirstPt) {
+            return true;
+        }
+        const Later& l = later[i];
+        if (i + 2 > last) {
+            return false;
+        }
+        for (int e : l.fExtremes) {
+            if (!curr.equalsWithinTolerance(pts[e])) {
+                return true;
+            }
+        }
+        // The farthest corner of the bounds is no nearer than any point inside them.
+        SkPoint corner = {
+            curr.fX - l.fBounds.fLeft > l.fBounds.fRight - curr.fX ? l.fBounds.fLeft
+                                                                  : l.fBounds.fRight,
+            curr.fY - l.fBounds.fTop > l.fBounds.fBottom - curr.fY ? l.fBounds.fTop
+                                                                  : l.fBounds.fBottom,
+        };
+        if (curr.equalsWithinTolerance(corner)) {
+            return false;
+        }
+        // Only a remainder of the contour that is itself nearly a point gets here.
+        for (int j = i + 2; j <= last; ++j) {
+            if (!curr.equalsWithinTolerance(pts[j])) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    const bool isButt = SkStrokerPriv::CapFactory(SkPaint::kButt_Cap) == fCapper;
+    for (int i = 0; i < segCount; ++i) {
+        const SkPoint& currPt = pts[i + 1];
+        bool teenyLine = fPrevPt.equalsWithinTolerance(currPt, SK_ScalarNearlyZero * fInvResScale);
+        if (isButt && teenyLine) {
+            continue;
+        }
+        if (teenyLine && (fJoinCompleted || laterTangentIsValid(i))) {
+            continue;
+        }
+        SkVector normal, unitNormal;
+        // Once a teeny line has been skipped, fPrevPt no longer starts this segment, so its
+        // precomputed normal does not apply.
+        if (normalIsValid[i] && fPrevPt == pts[i]) {
+            unitNormal = unitNormals[i];
+            unitNormal.scale(fRadius, &normal);
+            this->joinTo(normal, unitNormal, true);
+        } else if (!this->preJoinTo(currPt, &normal, &unitNormal, true)) {
+            continue;
+        }
+        this->line_to(currPt, normal);
+        this->postJoinTo(currPt, normal, unitNormal);
+    }
+}
+
 void SkPathStroker::setQuadEndNormal(const SkPoint quad[3], const SkVector& normalAB,
         const SkVector& unitNormalAB, SkVector* normalBC, SkVector* unitNormalBC) {
     if (!set_normal_unitnormal(quad[1], quad[2], fResScale, fRadius, normalBC, unitNormalBC)) {
@@ -1383,6 +1534,11 @@ void SkStroke::strokePath(const SkPath& src, SkPath* dst) const {
     bool ignoreCenter = fDoFill && (src.getSegmentMasks() == SkPath::kLine_SegmentMask) && 
                         src.isLastContourClosed() && src.isConvex();
 
+    // Line-only paths (polylines, which can be very long) hand whole runs of lines to the
+    // stroker at once. (Its tangent lookahead compares finite points only.)
+    const bool isPolyline = src.getSegmentMasks() == SkPath::kLine_SegmentMask && src.isFinite();
+    SkTDArray<SkPoint> polyline;
+
     SkPathStroker   stroker(src, radius, fMiterLimit, this->getCap(), this->getJoin(),
                             fResScale, ignoreCenter);
     SkPath::Iter    iter(src, false);
@@ -1395,7 +1551,20 @@ void SkStroke::strokePath(const SkPath& src, SkPath* dst) const {
                 stroker.moveTo(pts[0]);
                 break;
             case SkPath::kLine_Verb:
-                stroker.lineTo(pts[1], &iter);
+                if (isPolyline) {
+                    polyline.rewind();
+                    polyline.append(2, pts);
+                    SkPath::Verb nextVerb;
+                    for (SkPath::Iter peek = iter;
+                         SkPath::kLine_Verb == (nextVerb = peek.next(pts, false));
+                         iter = peek) {
+                        *polyline.append() = pts[1];
+                    }
+                    stroker.polylineTo(polyline.begin(), polyline.count(),
+                                       SkPath::kClose_Verb == nextVerb);
+                } else {
+                    stroker.lineTo(pts[1], &iter);
+                }
                 lastSegment = SkPath::kLine_Verb;
                 break;
             case SkPath::kQuad_Verb:
@@ -291,9 +291,124 @@ union PositioningAndExtended {
     struct {
         SkTextBlob::GlyphPositioning positioning;
         bool extended;
-        uint16_t padding;
+        uint8_t compact;
+        uint8_t padding;
     };
 };
+
+// How a run's positions are serialized, when not as the run stores them. The x and y
+// coordinates are written separately, and either may be written compactly.
+enum CompactPositions : uint8_t {
+    // Every glyph has the same y, which is written once.
+    kSharedY_CompactPositions    = 1 << 0,
+    // The coordinates are written as deltas; see quantize_coords().
+    kQuantizedX_CompactPositions = 1 << 1,
+    kQuantizedY_CompactPositions = 1 << 2,
+    kAll_CompactPositions        = (1 << 3) - 1,
+};
+
+// Quantized coordinates are multiples of 1/64 away from the first, which is written as a scalar.
+// Each is written as an int16_t delta from the one before.
+static const SkScalar kCoordQuantum = 1.0f / 64;
+
+static SkScalar dequantize_coord(SkScalar first, int32_t steps) {
+    return first + SkIntToScalar(steps) * kCoordQuantum;
+}
+
+/** Fills deltas and returns true if count coordinates, stride scalars apart, can be written as
+ *  deltas and read back exactly.
+ */
+static bool quantize_coords(const SkScalar coords[], int stride, int count, int16_t deltas[]) {
+    const SkScalar first = coords[0];
+    int32_t steps = 0;
+    for (int i = 0; i < count; ++i) {
+        SkScalar coord = coords[i * stride];
+        float exactSteps = (coord - first) / kCoordQuantum;
+        // Also fails for NaN.
+        if (!(SkScalarAbs(exactSteps) < (1 << 24))) {
+            return false;
+        }
+        int32_t next = (int32_t)exactSteps;
+        int32_t delta = next - steps;
+        if (delta < SK_MinS16 || delta > SK_MaxS16 ||
+            SkFloat2Bits(dequantize_coord(first, next)) != SkFloat2Bits(coord)) {
+            return false;
+        }
+        deltas[i] = SkToS16(delta);
+        steps = next;
+    }
+    return true;
+}
+
+static void write_coords(SkWriteBuffer& buffer, const SkScalar coords[], int stride, int count,
+                         const int16_t deltas[]) {
+    if (deltas) {
+        buffer.writeScalar(coords[0]);
+        buffer.writeByteArray(deltas, count * sizeof(int16_t));
+        return;
+    }
+    SkAutoSTMalloc<128, SkScalar> scalars(count);
+    for (int i = 0; i < count; ++i) {
+        scalars[i] = coords[i * stride];
+    }
+    buffer.writeByteArray(scalars.get(), count * sizeof(SkScalar));
+}
+
+static bool read_coords(SkReadBuffer& reader, SkScalar coords[], int stride, int count,
+                        bool quantized) {
+    if (quantized) {
+        SkScalar first = reader.readScalar();
+        SkAutoSTMalloc<128, int16_t> deltas(count);
+        if (!reader.readByteArray(deltas.get(), count * sizeof(int16_t))) {
+            return false;
+        }
+        int32_t steps = 0;
+        for (int i = 0; i < count; ++i) {
+            steps += deltas[i];
+            // No writer goes this far, and further could overflow.
+            if (SkTAbs(steps) >= (1 << 24)) {
+                return false;
+            }
+            coords[i * stride] = dequantize_coord(first, steps);
+        }
+        return true;
+    }
+    SkAutoSTMalloc<128, SkScalar> scalars(count);
+    if (!reader.readByteArray(scalars.get(), count * sizeof(SkScalar))) {
+        return false;
+    }
+    for (int i = 0; i < count; ++i) {
+        coords[i * stride] = scalars[i];
+    }
+    return true;
+}
+
+/** Returns which of a run's coordinates can be written compactly, filling xDeltas and yDeltas
+ *  for those that can be quantized.
+ */
+static uint8_t compact_positions(const SkScalar pos[], int count, unsigned scalarsPerGlyph,
+                                 int16_t xDeltas[], int16_t yDeltas[]) {
+    uint8_t compact = 0;
+    if (0 == scalarsPerGlyph) {
+        return compact;
+    }
+    if (quantize_coords(pos, scalarsPerGlyph, count, xDeltas)) {
+        compact |= kQuantizedX_CompactPositions;
+    }
+    if (2 == scalarsPerGlyph) {
+        compact |= kSharedY_CompactPositions;
+        for (int i = 1; i < count; ++i) {
+            if (SkFloat2Bits(pos[2 * i + 1]) != SkFloat2Bits(pos[1])) {
+                compact &= ~kSharedY_CompactPositions;
+                break;
+            }
+        }
+        if (!(compact & kSharedY_CompactPositions) && quantize_coords(pos + 1, 2, count, yDeltas)) {
+            compact |= kQuantizedY_CompactPositions;
+        }
+    }
+    return compact;
+}
 } // namespace
 
 void SkTextBlob::flatten(SkWriteBuffer& buffer) const {
@@ -313,6 +428,12 @@ void SkTextBlob::flatten(SkWriteBuffer& buffer) const {
         pe.positioning = it.positioning();
         SkASSERT((int32_t)it.positioning() == pe.intValue);  // backwards compat.
 
+        const int count = it.glyphCount();
+        const unsigned scalarsPerGlyph = ScalarsPerGlyph(it.positioning());
+        SkAutoSTMalloc<128, int16_t> xDeltas(count), yDeltas(count);
+        pe.compact = compact_positions(it.pos(), count, scalarsPerGlyph,
+                                       xDeltas.get(), yDeltas.get());
+
         uint32_t textSize = it.textSize();
         pe.extended = textSize > 0;
         buffer.write32(pe.intValue);
@@ -325,8 +446,18 @@ void SkTextBlob::flatten(SkWriteBuffer& buffer) const {
         buffer.writePaint(runPaint);
 
         buffer.writeByteArray(it.glyphs(), it.glyphCount() * sizeof(uint16_t));
-        buffer.writeByteArray(it.pos(),
-            it.glyphCount() * sizeof(SkScalar) * ScalarsPerGlyph(it.positioning()));
+        if (!pe.compact) {
+            buffer.writeByteArray(it.pos(), count * sizeof(SkScalar) * scalarsPerGlyph);
+        } else {
+            write_coords(buffer, it.pos(), scalarsPerGlyph, count,
+                         pe.compact & kQuantizedX_CompactPositions ? xDeltas.get() : nullptr);
+            if (pe.compact & kSharedY_CompactPositions) {
+                buffer.writeScalar(it.pos()[1]);
+            } else if (2 == scalarsPerGlyph) {
+                write_coords(buffer, it.pos() + 1, 2, count,
+                             pe.compact & kQuantizedY_CompactPositions ? yDeltas.get() : nullptr);
+            }
+        }
         if (pe.extended) {
             buffer.writeByteArray(it.clusters(), sizeof(uint32_t) * it.glyphCount());
             buffer.writeByteArray(it.text(), it.textSize());
@@ -357,6 +488,14 @@ sk_sp<SkTextBlob> SkTextBlob::MakeFromBuffer(SkReadBuffer& reader) {
         if (glyphCount <= 0 || pos > kFull_Positioning) {
             return nullptr;
         }
+        const uint8_t compact = pe.compact;
+        if ((compact & ~kAll_CompactPositions) ||
+            (compact && reader.isVersionLT(SkReadBuffer::kCompactTextBlobPositions_Version)) ||
+            (compact && kDefault_Positioning == pos) ||
+            (compact & (kSharedY_CompactPositions | kQuantizedY_CompactPositions) &&
+             kFull_Positioning != pos)) {
+            return nullptr;
+        }
         uint32_t textSize = pe.extended ? (uint32_t)reader.read32() : 0;
 
         SkPoint offset;
@@ -381,11 +520,30 @@ sk_sp<SkTextBlob> SkTextBlob::MakeFromBuffer(SkReadBuffer& reader) {
             return nullptr;
         }
 
-        if (!reader.readByteArray(buf->glyphs, glyphCount * sizeof(uint16_t)) ||
-            !reader.readByteArray(buf->pos,
-                                  glyphCount * sizeof(SkScalar) * ScalarsPerGlyph(pos))) {
+        const unsigned scalarsPerGlyph = ScalarsPerGlyph(pos);
+        if (!reader.readByteArray(buf->glyphs, glyphCount * sizeof(uint16_t))) {
             return nullptr;
         }
+        if (!compact) {
+            if (!reader.readByteArray(buf->pos, glyphCount * sizeof(SkScalar) * scalarsPerGlyph)) {
+                return nullptr;
+            }
+        } else {
+            if (!read_coords(reader, buf->pos, scalarsPerGlyph, glyphCount,
+                             compact & kQuantizedX_CompactPositions)) {
+                return nullptr;
+            }
+            if (compact & kSharedY_CompactPositions) {
+                SkScalar y = reader.readScalar();
+                for (int j = 0; j < glyphCount; ++j) {
+                    buf->pos[2 * j + 1] = y;
+                }
+            } else if (2 == scalarsPerGlyph &&
+                       !read_coords(reader, buf->pos + 1, 2, glyphCount,
+                                    compact & kQuantizedY_CompactPositions)) {
+                return nullptr;
+            }
+        }
 
         if (pe.extended) {
             if (!reader.readByteArray(buf->clusters, glyphCount * sizeof(uint32_t))  ||
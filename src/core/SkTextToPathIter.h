@@ -14,6 +14,14 @@
 class SkGlyphCache;
 
 class SkTextBaseIter {
+public:
+    /**
+     *  Changes paint into the one an iterator made with it finds its glyph cache with, and
+     *  returns the scale from that paint's text size back to the original one. Clears
+     *  applyStrokeAndPathEffects if there is nothing to apply.
+     */
+    static SkScalar SetupCachePaint(SkPaint* paint, bool* applyStrokeAndPathEffects);
+
 protected:
     SkTextBaseIter(const char text[], size_t length, const SkPaint& paint,
                    bool applyStrokeAndPathEffects);
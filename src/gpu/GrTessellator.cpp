@@ -13,6 +13,7 @@
 #include "SkChunkAlloc.h"
 #include "SkGeometry.h"
 #include "SkPath.h"
+#include "SkTaskGroup.h"
 
 #include <stdio.h>
 
@@ -1735,6 +1736,35 @@ int count_points(Poly* polys, SkPath::FillType fillType) {
     return count;
 }
 
+int polys_to_winding_vertices(Poly* polys, SkPath::FillType fillType, int count,
+                              GrTessellator::WindingVertex* verts) {
+    GrTessellator::WindingVertex* vertsEnd = verts;
+    SkAutoTMalloc<SkPoint> points(count);
+    SkPoint* pointsEnd = points.get();
+    for (Poly* poly = polys; poly; poly = poly->fNext) {
+        if (apply_fill_type(fillType, poly)) {
+            SkPoint* start = pointsEnd;
+            pointsEnd = static_cast<SkPoint*>(poly->emit(nullptr, pointsEnd));
+            while (start != pointsEnd) {
+                vertsEnd->fPos = *start;
+                vertsEnd->fWinding = poly->fWinding;
+                ++start;
+                ++vertsEnd;
+            }
+        }
+    }
+    int actualCount = static_cast<int>(vertsEnd - verts);
+    SkASSERT(actualCount <= count);
+    SkASSERT(pointsEnd - points.get() == actualCount);
+    return actualCount;
+}
+
+// PathsToVertices() splits its paths between at most this many tasks.
+const int kMaxTessellationTasks = 32;
+
+// Minimum block size of each PathsToVertices() task's scratch allocator.
+const size_t kScratchBlockSize = 16 * 1024;
+
 } // namespace
 
 namespace GrTessellator {
@@ -1798,26 +1828,44 @@ int PathToVertices(const SkPath& path, SkScalar tolerance, const SkRect& clipBou
     }
 
     *verts = new GrTessellator::WindingVertex[count];
-    GrTessellator::WindingVertex* vertsEnd = *verts;
-    SkPoint* points = new SkPoint[count];
-    SkPoint* pointsEnd = points;
-    for (Poly* poly = polys; poly; poly = poly->fNext) {
-        if (apply_fill_type(fillType, poly)) {
-            SkPoint* start = pointsEnd;
-            pointsEnd = static_cast<SkPoint*>(poly->emit(nullptr, pointsEnd));
-            while (start != pointsEnd) {
-                vertsEnd->fPos = *start;
-                vertsEnd->fWinding = poly->fWinding;
-                ++start;
-                ++vertsEnd;
-            }
-        }
+    return polys_to_winding_vertices(polys, fillType, count, *verts);
+}
+
+int PathToVertices(const SkPath& path, SkScalar tolerance, const SkRect& clipBounds,
+                   SkChunkAlloc* scratch, SkTDArray<WindingVertex>* verts) {
+    verts->rewind();
+    int contourCnt;
+    int sizeEstimate;
+    get_contour_count_and_size_estimate(path, tolerance, &contourCnt, &sizeEstimate);
+    if (contourCnt <= 0) {
+        return 0;
     }
-    int actualCount = static_cast<int>(vertsEnd - *verts);
-    SkASSERT(actualCount <= count);
-    SkASSERT(pointsEnd - points == actualCount);
-    delete[] points;
-    return actualCount;
+    scratch->rewind();
+    bool isLinear;
+    Poly* polys = path_to_polys(path, tolerance, clipBounds, contourCnt, *scratch, false,
+                                &isLinear);
+    SkPath::FillType fillType = path.getFillType();
+    int count = count_points(polys, fillType);
+    if (0 == count) {
+        return 0;
+    }
+
+    verts->setCount(count);
+    verts->setCount(polys_to_winding_vertices(polys, fillType, count, verts->begin()));
+    return verts->count();
+}
+
+void PathsToVertices(const SkPath paths[], int pathCount, SkScalar tolerance,
+                     const SkRect& clipBounds, SkTDArray<WindingVertex> verts[]) {
+    // Each task tessellates every taskCount'th path, reusing one scratch allocator for all of
+    // them, so the vertex and edge storage is only allocated a handful of times per task.
+    const int taskCount = SkTMin(pathCount, kMaxTessellationTasks);
+    SkTaskGroup().batch(taskCount, [&](int task) {
+        SkChunkAlloc scratch(kScratchBlockSize);
+        for (int i = task; i < pathCount; i += taskCount) {
+            PathToVertices(paths[i], tolerance, clipBounds, &scratch, &verts[i]);
+        }
+    });
 }
 
 } // namespace
@@ -10,7 +10,9 @@
 
 #include "GrColor.h"
 #include "SkPoint.h"
+#include "SkTDArray.h"
 
+class SkChunkAlloc;
 class SkPath;
 struct SkRect;
 
@@ -45,6 +47,17 @@ struct WindingVertex {
 int PathToVertices(const SkPath& path, SkScalar tolerance, const SkRect& clipBounds,
                    WindingVertex** verts);
 
+// As above, but the triangles are written to 'verts' (replacing its contents), and the
+// intermediate vertices, edges and polygons are allocated from 'scratch', which is rewound
+// first. Reusing the same 'scratch' and 'verts' across paths avoids most per-path allocations.
+int PathToVertices(const SkPath& path, SkScalar tolerance, const SkRect& clipBounds,
+                   SkChunkAlloc* scratch, SkTDArray<WindingVertex>* verts);
+
+// Triangulates pathCount paths concurrently on the SkTaskGroup thread pool, writing the
+// triangles of paths[i] to verts[i]. None of this needs a GPU or a GrContext.
+void PathsToVertices(const SkPath paths[], int pathCount, SkScalar tolerance,
+                     const SkRect& clipBounds, SkTDArray<WindingVertex> verts[]);
+
 int PathToTriangles(const SkPath& path, SkScalar tolerance, const SkRect& clipBounds, 
                     VertexAllocator*, bool antialias, const GrColor& color,
                     bool canTweakAlphaForCoverage, bool *isLinear);
@@ -9,6 +9,11 @@
 #define SkBlitMask_opts_DEFINED
 
 #include "Sk4px.h"
+#include "SkColorPriv.h"
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    #include <immintrin.h>
+#endif
 
 namespace SK_OPTS_NS {
 
@@ -131,6 +136,166 @@ namespace SK_OPTS_NS {
     }
 
 #else
+  #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    // These work on 8 pixels at a time, with the same math as the Sk4px versions below.
+
+    // (x*y + x) / 256, as Sk4px::approxMulDiv255().
+    static inline __m256i approx_mul_div_255(__m256i x, __m256i y) {
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i xLo = _mm256_unpacklo_epi8(x, zero),
+                xHi = _mm256_unpackhi_epi8(x, zero);
+        __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(xLo, _mm256_unpacklo_epi8(y, zero)), xLo),
+                hi = _mm256_add_epi16(_mm256_mullo_epi16(xHi, _mm256_unpackhi_epi8(y, zero)), xHi);
+        return _mm256_packus_epi16(_mm256_srli_epi16(lo, 8), _mm256_srli_epi16(hi, 8));
+    }
+
+    static inline __m256i invert(__m256i x) {
+        return _mm256_sub_epi8(_mm256_set1_epi8((char)0xFF), x);
+    }
+
+    static inline __m256i alpha_bytes(__m256i px) {
+        static_assert(SK_A32_SHIFT == 24, "Intel's always little-endian.");
+        return _mm256_shuffle_epi8(px, _mm256_setr_epi8(3,3,3,3, 7,7,7,7, 11,11,11,11, 15,15,15,15,
+                                                        3,3,3,3, 7,7,7,7, 11,11,11,11, 15,15,15,15));
+    }
+
+    // Reads n < 16 bytes into the low bytes of a vector, zeroing the rest.  We read 8, 4, 2, and
+    // 1 bytes at a time; this runs for every row of every glyph, so a byte loop is too slow.
+    static inline __m128i load_bytes(const void* src, int n) {
+        const uint8_t* bytes = (const uint8_t*)src;
+        uint64_t lo = 0, hi = 0;
+        uint64_t* half = &lo;
+        int shift = 0;
+        if (n & 8) {
+            memcpy(&lo, bytes, 8);
+            bytes += 8;
+            half = &hi;
+        }
+        if (n & 4) {
+            uint32_t v;
+            memcpy(&v, bytes, 4);
+            *half |= v;
+            bytes += 4;
+            shift += 32;
+        }
+        if (n & 2) {
+            uint16_t v;
+            memcpy(&v, bytes, 2);
+            *half |= (uint64_t)v << shift;
+            bytes += 2;
+            shift += 16;
+        }
+        if (n & 1) {
+            *half |= (uint64_t)*bytes << shift;
+        }
+        return _mm_set_epi64x(hi, lo);
+    }
+
+    // Reads n < 8 pixels from dst, and writes the first n pixels of px back to dst.  Plain loads
+    // and stores of 4, 2, and 1 pixels are much cheaper than masked ones.
+    static inline __m256i load_pixels(const SkPMColor* dst, int n) {
+        __m128i four = _mm_setzero_si128(),
+                rest = _mm_setzero_si128();
+        if (n & 4) {
+            four = _mm_loadu_si128((const __m128i*)dst);
+            dst += 4;
+        }
+        if (n & 2) {
+            rest = _mm_loadl_epi64((const __m128i*)dst);
+            dst += 2;
+        }
+        if (n & 1) {
+            rest = (n & 2) ? _mm_insert_epi32(rest, *dst, 2) : _mm_cvtsi32_si128(*dst);
+        }
+        return (n & 4) ? _mm256_inserti128_si256(_mm256_castsi128_si256(four), rest, 1)
+                       : _mm256_castsi128_si256(rest);
+    }
+
+    static inline void store_pixels(SkPMColor* dst, __m256i px, int n) {
+        __m128i lo = _mm256_castsi256_si128(px);
+        if (n & 4) {
+            _mm_storeu_si128((__m128i*)dst, lo);
+            lo = _mm256_extracti128_si256(px, 1);
+            dst += 4;
+        }
+        if (n & 2) {
+            _mm_storel_epi64((__m128i*)dst, lo);
+            lo = _mm_srli_si128(lo, 8);
+            dst += 2;
+        }
+        if (n & 1) {
+            *dst = _mm_cvtsi128_si32(lo);
+        }
+    }
+
+    // Spread 8 alphas across the 4 bytes of each of 8 pixels.
+    static inline __m256i spread_alphas(__m128i a) {
+        __m256i as = _mm256_broadcastsi128_si256(a);
+        return _mm256_shuffle_epi8(as, _mm256_setr_epi8(0,0,0,0, 1,1,1,1, 2,2,2,2, 3,3,3,3,
+                                                        4,4,4,4, 5,5,5,5, 6,6,6,6, 7,7,7,7));
+    }
+
+    // Like Sk4px::MapDstAlpha(), finishing any last 1-7 pixels with load_pixels() and
+    // store_pixels().
+    template <typename Fn>
+    static inline void map_dst_alpha(int n, SkPMColor* dst, const SkAlpha* a, const Fn& fn) {
+        for (; n >= 8; n -= 8, dst += 8, a += 8) {
+            __m256i d = _mm256_loadu_si256((const __m256i*)dst);
+            _mm256_storeu_si256((__m256i*)dst,
+                                fn(d, spread_alphas(_mm_loadl_epi64((const __m128i*)a))));
+        }
+        if (n > 0) {
+            __m256i d = load_pixels(dst, n);
+            store_pixels(dst, fn(d, spread_alphas(load_bytes(a, n))), n);
+        }
+    }
+
+    static void blit_mask_d32_a8_general(SkPMColor* dst, size_t dstRB,
+                                         const SkAlpha* mask, size_t maskRB,
+                                         SkColor color, int w, int h) {
+        const __m256i s = _mm256_set1_epi32(SkPreMultiplyColor(color));
+        auto fn = [&](__m256i d, __m256i aa) {
+            __m256i left  = approx_mul_div_255(s, aa),
+                    right = approx_mul_div_255(d, invert(alpha_bytes(left)));
+            return _mm256_add_epi8(left, right);
+        };
+        while (h --> 0) {
+            map_dst_alpha(w, dst, mask, fn);
+            dst  +=  dstRB / sizeof(*dst);
+            mask += maskRB / sizeof(*mask);
+        }
+    }
+
+    static void blit_mask_d32_a8_opaque(SkPMColor* dst, size_t dstRB,
+                                        const SkAlpha* mask, size_t maskRB,
+                                        SkColor color, int w, int h) {
+        SkASSERT(SkColorGetA(color) == 0xFF);
+        const __m256i s = _mm256_set1_epi32(SkPreMultiplyColor(color));
+        auto fn = [&](__m256i d, __m256i aa) {
+            return _mm256_add_epi8(approx_mul_div_255(s, aa), approx_mul_div_255(d, invert(aa)));
+        };
+        while (h --> 0) {
+            map_dst_alpha(w, dst, mask, fn);
+            dst  +=  dstRB / sizeof(*dst);
+            mask += maskRB / sizeof(*mask);
+        }
+    }
+
+    static void blit_mask_d32_a8_black(SkPMColor* dst, size_t dstRB,
+                                       const SkAlpha* mask, size_t maskRB,
+                                       int w, int h) {
+        const __m256i alphaMask = _mm256_set1_epi32(SK_A32_MASK << SK_A32_SHIFT);
+        auto fn = [&](__m256i d, __m256i aa) {
+            return _mm256_add_epi8(_mm256_and_si256(aa, alphaMask),
+                                   approx_mul_div_255(d, invert(aa)));
+        };
+        while (h --> 0) {
+            map_dst_alpha(w, dst, mask, fn);
+            dst  +=  dstRB / sizeof(*dst);
+            mask += maskRB / sizeof(*mask);
+        }
+    }
+  #else
     static void blit_mask_d32_a8_general(SkPMColor* dst, size_t dstRB,
                                          const SkAlpha* mask, size_t maskRB,
                                          SkColor color, int w, int h) {
@@ -187,6 +352,7 @@ namespace SK_OPTS_NS {
             mask += maskRB / sizeof(*mask);
         }
     }
+  #endif
 #endif
 
 static void blit_mask_d32_a8(SkPMColor* dst, size_t dstRB,
@@ -201,6 +367,98 @@ static void blit_mask_d32_a8(SkPMColor* dst, size_t dstRB,
     }
 }
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+// LCD16 rows for SkBlitMask::BlitLCD16RowFactory(), as SkBlitLCD16Row_SSE2() and
+// SkBlitLCD16OpaqueRow_SSE2() but 8 pixels at a time.
+
+// Shift the top 5 bits of each LCD16 mask component in line with the matching SkPMColor byte.
+template <int kShift>
+static inline __m256i shift_lcd16_component(__m256i x) {
+    return kShift >= 0 ? _mm256_slli_epi32(x, kShift >= 0 ?  kShift : 0)
+                       : _mm256_srli_epi32(x, kShift <  0 ? -kShift : 0);
+}
+
+// Unpack 8 LCD16 masks to 16 bit lanes of 0..32, lined up with the channels of 8 pixels
+// unpacked by _mm256_unpack{lo,hi}_epi8(), as SkBlendLCD16_SSE2() does for 4.
+static inline void unpack_lcd16(__m128i mask, __m256i* maskLo, __m256i* maskHi) {
+    __m256i m = _mm256_cvtepu16_epi32(mask);
+    __m256i r = _mm256_and_si256(
+            shift_lcd16_component<SK_R32_SHIFT - SK_R16_SHIFT - SK_R16_BITS + 5>(m),
+            _mm256_set1_epi32(0x1F << SK_R32_SHIFT));
+    __m256i g = _mm256_and_si256(
+            shift_lcd16_component<SK_G32_SHIFT - SK_G16_SHIFT - SK_G16_BITS + 5>(m),
+            _mm256_set1_epi32(0x1F << SK_G32_SHIFT));
+    __m256i b = _mm256_and_si256(
+            shift_lcd16_component<SK_B32_SHIFT - SK_B16_SHIFT - SK_B16_BITS + 5>(m),
+            _mm256_set1_epi32(0x1F << SK_B32_SHIFT));
+    m = _mm256_or_si256(_mm256_or_si256(r, g), b);
+
+    // Upscale from 0..31 to 0..32.
+    *maskLo = _mm256_unpacklo_epi8(m, _mm256_setzero_si256());
+    *maskHi = _mm256_unpackhi_epi8(m, _mm256_setzero_si256());
+    *maskLo = _mm256_add_epi16(*maskLo, _mm256_srli_epi16(*maskLo, 4));
+    *maskHi = _mm256_add_epi16(*maskHi, _mm256_srli_epi16(*maskHi, 4));
+}
+
+// dst + ((src - dst) * mask >> 5), for src and mask unpacked to 16 bit lanes.
+static inline __m256i blend_lcd16(__m256i src, __m256i dst, __m256i maskLo, __m256i maskHi) {
+    __m256i dstLo = _mm256_unpacklo_epi8(dst, _mm256_setzero_si256()),
+            dstHi = _mm256_unpackhi_epi8(dst, _mm256_setzero_si256());
+    maskLo = _mm256_srai_epi16(_mm256_mullo_epi16(maskLo, _mm256_sub_epi16(src, dstLo)), 5);
+    maskHi = _mm256_srai_epi16(_mm256_mullo_epi16(maskHi, _mm256_sub_epi16(src, dstHi)), 5);
+    return _mm256_packus_epi16(_mm256_add_epi16(dstLo, maskLo), _mm256_add_epi16(dstHi, maskHi));
+}
+
+// Call fn(dst, maskLo, maskHi) for each 8 pixels of a row that aren't all masked out, finishing
+// any last 1-7 pixels with load_pixels() and store_pixels().
+template <typename Fn>
+static inline void map_lcd16(int n, SkPMColor* dst, const uint16_t* mask, const Fn& fn) {
+    __m256i maskLo, maskHi;
+    for (; n >= 8; n -= 8, dst += 8, mask += 8) {
+        __m128i m = _mm_loadu_si128((const __m128i*)mask);
+        if (!_mm_testz_si128(m, m)) {
+            unpack_lcd16(m, &maskLo, &maskHi);
+            __m256i d = _mm256_loadu_si256((const __m256i*)dst);
+            _mm256_storeu_si256((__m256i*)dst, fn(d, maskLo, maskHi));
+        }
+    }
+    if (n > 0) {
+        __m128i m = load_bytes(mask, n * sizeof(uint16_t));
+        if (!_mm_testz_si128(m, m)) {
+            unpack_lcd16(m, &maskLo, &maskHi);
+            store_pixels(dst, fn(load_pixels(dst, n), maskLo, maskHi), n);
+        }
+    }
+}
+
+static void blit_lcd16_row(SkPMColor dst[], const uint16_t mask[], SkColor src, int width,
+                           SkPMColor) {
+    // Opaque src, with each channel in a 16 bit lane.
+    const __m256i src16 = _mm256_unpacklo_epi8(
+            _mm256_set1_epi32(SkPackARGB32(0xFF, SkColorGetR(src), SkColorGetG(src),
+                                           SkColorGetB(src))),
+            _mm256_setzero_si256());
+    const __m256i srcA = _mm256_set1_epi16(SkAlpha255To256(SkColorGetA(src)));
+    map_lcd16(width, dst, mask, [&](__m256i d, __m256i maskLo, __m256i maskHi) {
+        maskLo = _mm256_srli_epi16(_mm256_mullo_epi16(maskLo, srcA), 8);
+        maskHi = _mm256_srli_epi16(_mm256_mullo_epi16(maskHi, srcA), 8);
+        return blend_lcd16(src16, d, maskLo, maskHi);
+    });
+}
+
+static void blit_lcd16_opaque_row(SkPMColor dst[], const uint16_t mask[], SkColor src, int width,
+                                  SkPMColor) {
+    const __m256i src16 = _mm256_unpacklo_epi8(
+            _mm256_set1_epi32(SkPackARGB32(0xFF, SkColorGetR(src), SkColorGetG(src),
+                                           SkColorGetB(src))),
+            _mm256_setzero_si256());
+    const __m256i alphaMask = _mm256_set1_epi32(SK_A32_MASK << SK_A32_SHIFT);
+    map_lcd16(width, dst, mask, [&](__m256i d, __m256i maskLo, __m256i maskHi) {
+        return _mm256_or_si256(blend_lcd16(src16, d, maskLo, maskHi), alphaMask);
+    });
+}
+#endif
+
 }  // SK_OPTS_NS
 
 #endif//SkBlitMask_opts_DEFINED
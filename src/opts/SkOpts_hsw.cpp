@@ -10,6 +10,7 @@
 
 #define SK_OPTS_NS hsw
 #include "SkBitmapFilter_opts.h"
+#include "SkBlitMask_opts.h"
 #include "SkRasterPipeline_opts.h"
 
 #if defined(_INC_MATH) && !defined(INC_MATH_IS_SAFE_NOW)
@@ -21,6 +22,10 @@ namespace SkOpts {
         run_pipeline     = hsw::run_pipeline;
         compile_pipeline = hsw::compile_pipeline;
         convolve_vertically = hsw::convolve_vertically;
+
+        blit_mask_d32_a8      = hsw::blit_mask_d32_a8;
+        blit_lcd16_row        = hsw::blit_lcd16_row;
+        blit_lcd16_opaque_row = hsw::blit_lcd16_opaque_row;
     }
 }
 
@@ -10,6 +10,8 @@
 #include "SkPathPriv.h"
 #include "SkPathOps.h"
 #include "SkPathOpsCommon.h"
+#include "SkTaskGroup.h"
+#include "SkTSort.h"
 
 static bool one_contour(const SkPath& path) {
     SkChunkAlloc allocator(256);
@@ -193,3 +195,113 @@ bool SkOpBuilder::resolve(SkPath* result) {
     }
     return success;
 }
+
+// Operands whose bounds touch, or nearly touch, may still share edges, so they must be
+// resolved together.
+static SkRect cluster_bounds(const SkRect& bounds) {
+    SkScalar largest = SkTMax(SkTMax(SkScalarAbs(bounds.fLeft), SkScalarAbs(bounds.fRight)),
+                              SkTMax(SkScalarAbs(bounds.fTop), SkScalarAbs(bounds.fBottom)));
+    SkScalar outset = SkTMax(largest, SK_Scalar1) * (FLT_EPSILON * 16);
+    return bounds.makeOutset(outset, outset);
+}
+
+static int find_cluster(SkTDArray<int>* parent, int index) {
+    while ((*parent)[index] != index) {
+        (*parent)[index] = (*parent)[(*parent)[index]];
+        index = (*parent)[index];
+    }
+    return index;
+}
+
+bool SkOpBuilder::resolveBatch(SkPath* result, bool inParallel) {
+    int count = fOps.count();
+    for (int index = 0; index < count; ++index) {
+        if (kUnion_SkPathOp != fOps[index] || fPathRefs[index].isInverseFillType()) {
+            return this->resolve(result);
+        }
+    }
+    // Sweep the operands left to right, merging the clusters of any two whose bounds overlap.
+    // Operands with empty bounds add nothing to a union and are dropped.
+    SkTArray<SkRect> bounds(count);
+    SkTDArray<int> parent;
+    SkTDArray<int> order;
+    parent.setCount(count);
+    for (int index = 0; index < count; ++index) {
+        bounds.push_back(cluster_bounds(fPathRefs[index].getBounds()));
+        parent[index] = index;
+        if (!fPathRefs[index].getBounds().isEmpty()) {
+            *order.append() = index;
+        }
+    }
+    if (order.count() > 1) {
+        SkTQSort(order.begin(), order.end() - 1, [&bounds](int a, int b) {
+            return bounds[a].fLeft < bounds[b].fLeft;
+        });
+    }
+    SkTDArray<int> active;
+    for (int index : order) {
+        const SkRect& test = bounds[index];
+        int kept = 0;
+        for (int activeIndex : active) {
+            if (bounds[activeIndex].fRight >= test.fLeft) {
+                active[kept++] = activeIndex;
+            }
+        }
+        active.setCount(kept);
+        for (int activeIndex : active) {
+            const SkRect& other = bounds[activeIndex];
+            if (other.fTop <= test.fBottom && test.fTop <= other.fBottom) {
+                parent[find_cluster(&parent, activeIndex)] = find_cluster(&parent, index);
+            }
+        }
+        *active.append() = index;
+    }
+    // Gather each cluster's operands, in their original order, into its own builder.
+    SkTDArray<int> clusterOf;
+    clusterOf.setCount(count);
+    for (int index = 0; index < count; ++index) {
+        clusterOf[index] = -1;
+    }
+    SkTArray<SkOpBuilder> clusters;
+    for (int index = 0; index < count; ++index) {
+        if (fPathRefs[index].getBounds().isEmpty()) {
+            continue;
+        }
+        int root = find_cluster(&parent, index);
+        if (clusterOf[root] < 0) {
+            clusterOf[root] = clusters.count();
+            clusters.push_back();
+        }
+        clusters[clusterOf[root]].add(fPathRefs[index], kUnion_SkPathOp);
+    }
+    int clusterCount = clusters.count();
+    if (clusterCount <= 1) {
+        return this->resolve(result);
+    }
+    this->reset();
+
+    SkTArray<SkPath> clusterResults(clusterCount);
+    clusterResults.push_back_n(clusterCount);
+    SkAutoTMalloc<bool> succeeded(clusterCount);
+    auto resolveCluster = [&](int index) {
+        succeeded[index] = clusters[index].resolve(&clusterResults[index]);
+    };
+    if (inParallel) {
+        SkTaskGroup().batch(clusterCount, resolveCluster);
+    } else {
+        for (int index = 0; index < clusterCount; ++index) {
+            resolveCluster(index);
+        }
+    }
+    // Cluster bounds do not overlap, so their results can simply be concatenated.
+    SkPath sum;
+    for (int index = 0; index < clusterCount; ++index) {
+        if (!succeeded[index]) {
+            return false;
+        }
+        sum.addPath(clusterResults[index]);
+    }
+    sum.setFillType(SkPath::kEvenOdd_FillType);
+    *result = sum;
+    return true;
+}
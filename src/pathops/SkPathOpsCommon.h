@@ -26,6 +26,9 @@ bool HandleCoincidence(SkOpContourHead* , SkOpCoincidence* );
 bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
              SkDEBUGPARAMS(bool skipAssert)
              SkDEBUGPARAMS(const char* testName));
+bool RectilinearOp(const SkPath& one, const SkPath& two, SkPathOp op, SkPath::FillType fillType,
+                   SkPath* result);
+bool RectilinearSimplify(const SkPath& path, SkPath::FillType fillType, SkPath* result);
 SkScalar ScaleFactor(const SkPath& path);
 void ScalePath(const SkPath& path, SkScalar scale, SkPath* scaled);
 
@@ -319,6 +319,15 @@ bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
 }
 
 bool Op(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result) {
+    // axis-aligned polygons on integer coordinates don't need the curve machinery; their
+    // contours are traced by SkRegion, so their order and start points differ from OpDebug's
+    SkPathOp rectilinearOp = gOpInverse[op][one.isInverseFillType()][two.isInverseFillType()];
+    SkPath::FillType fillType = gOutInverse[rectilinearOp][one.isInverseFillType()]
+            [two.isInverseFillType()] ? SkPath::kInverseEvenOdd_FillType
+            : SkPath::kEvenOdd_FillType;
+    if (RectilinearOp(one, two, rectilinearOp, fillType, result)) {
+        return true;
+    }
 #if DEBUG_DUMP_VERIFY
     if (SkPathOpsDebug::gVerifyOp) {
         if (!OpDebug(one, two, op, result  SkDEBUGPARAMS(false) SkDEBUGPARAMS(nullptr))) {
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#include "SkPathOpsCommon.h"
+#include "SkRegion.h"
+
+// SkRegion scan converts with 16.16 fixed point edges; stay well inside that range.
+static const SkScalar kMaxRectilinearCoord = 16384;
+
+static bool is_rectilinear_point(const SkPoint& pt) {
+    return pt.fX == SkScalarFloorToScalar(pt.fX) && pt.fY == SkScalarFloorToScalar(pt.fY)
+            && SkScalarAbs(pt.fX) <= kMaxRectilinearCoord
+            && SkScalarAbs(pt.fY) <= kMaxRectilinearCoord;
+}
+
+static bool is_rectilinear_line(const SkPoint& start, const SkPoint& end) {
+    return start.fX == end.fX || start.fY == end.fY;
+}
+
+// Returns true if every contour, including its implied closing edge, is made of horizontal and
+// vertical lines between integer points. Such paths are covered exactly by an SkRegion.
+static bool is_rectilinear(const SkPath& path) {
+    if (path.getSegmentMasks() & ~SkPath::kLine_SegmentMask) {
+        return false;
+    }
+    SkPath::RawIter iter(path);
+    SkPoint pts[4];
+    SkPoint first = { 0, 0 };
+    SkPoint last = { 0, 0 };
+    SkPath::Verb verb;
+    while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+        switch (verb) {
+            case SkPath::kMove_Verb:
+                if (!is_rectilinear_line(last, first) || !is_rectilinear_point(pts[0])) {
+                    return false;
+                }
+                first = last = pts[0];
+                break;
+            case SkPath::kLine_Verb:
+                if (!is_rectilinear_point(pts[1]) || !is_rectilinear_line(pts[0], pts[1])) {
+                    return false;
+                }
+                last = pts[1];
+                break;
+            case SkPath::kClose_Verb:
+                break;
+            default:
+                return false;
+        }
+    }
+    return is_rectilinear_line(last, first);
+}
+
+static void set_region(const SkPath& path, const SkRegion& clip, SkRegion* region) {
+    // inverse fills have already been folded into the operator and the output fill type
+    SkPath noninverse(path);
+    noninverse.setFillType(SkPath::ConvertToNonInverseFillType(path.getFillType()));
+    region->setPath(noninverse, clip);
+}
+
+static void set_result(const SkRegion& region, SkPath::FillType fillType, SkPath* result) {
+    result->reset();
+    region.getBoundaryPath(result);
+    result->setFillType(fillType);
+}
+
+bool RectilinearOp(const SkPath& one, const SkPath& two, SkPathOp op, SkPath::FillType fillType,
+        SkPath* result) {
+    if (!is_rectilinear(one) || !is_rectilinear(two)) {
+        return false;
+    }
+    static const SkRegion::Op kRegionOps[] = {
+        SkRegion::kDifference_Op,
+        SkRegion::kIntersect_Op,
+        SkRegion::kUnion_Op,
+        SkRegion::kXOR_Op,
+        SkRegion::kReverseDifference_Op,
+    };
+    static_assert(SK_ARRAY_COUNT(kRegionOps) == kReverseDifference_SkPathOp + 1, "region_ops");
+    SkRect bounds = one.getBounds();
+    bounds.join(two.getBounds());
+    SkRegion clip(bounds.roundOut());
+    SkRegion oneRegion, twoRegion;
+    set_region(one, clip, &oneRegion);
+    set_region(two, clip, &twoRegion);
+    oneRegion.op(twoRegion, kRegionOps[op]);
+    set_result(oneRegion, fillType, result);
+    return true;
+}
+
+bool RectilinearSimplify(const SkPath& path, SkPath::FillType fillType, SkPath* result) {
+    if (!is_rectilinear(path)) {
+        return false;
+    }
+    SkRegion clip(path.getBounds().roundOut());
+    SkRegion region;
+    set_region(path, clip, &region);
+    set_result(region, fillType, result);
+    return true;
+}
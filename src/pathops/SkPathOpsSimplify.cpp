@@ -220,6 +220,13 @@ bool SimplifyDebug(const SkPath& path, SkPath* result
 }
 
 bool Simplify(const SkPath& path, SkPath* result) {
+    // axis-aligned polygons on integer coordinates don't need the curve machinery; their
+    // contours are traced by SkRegion, so their order and start points differ from SimplifyDebug's
+    SkPath::FillType fillType = path.isInverseFillType() ? SkPath::kInverseEvenOdd_FillType
+            : SkPath::kEvenOdd_FillType;
+    if (!path.isConvex() && RectilinearSimplify(path, fillType, result)) {
+        return true;
+    }
 #if DEBUG_DUMP_VERIFY
     if (SkPathOpsDebug::gVerifyOp) {
         if (!SimplifyDebug(path, result  SkDEBUGPARAMS(false) SkDEBUGPARAMS(nullptr))) {
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "SkColorSpace.h"
 #include "SkImage.h"
 #include "SkPDFBitmap.h"
 #include "SkPDFCanon.h"
@@ -102,6 +103,72 @@ void SkPDFCanon::addPDFBitmap(SkBitmapKey key, sk_sp<SkPDFObject> pdfBitmap) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+static bool same_pixels(const SkBitmap& a, const SkBitmap& b) {
+    if (a.width() != b.width() || a.height() != b.height() ||
+        a.colorType() != b.colorType() || a.alphaType() != b.alphaType() ||
+        !SkColorSpace::Equals(a.colorSpace(), b.colorSpace())) {
+        return false;
+    }
+    SkAutoLockPixels autoLockA(a), autoLockB(b);
+    if (!a.getPixels() || !b.getPixels()) {
+        return false;
+    }
+    size_t rowBytes = a.info().minRowBytes();
+    for (int y = 0; y < a.height(); ++y) {
+        if (memcmp(a.getAddr(0, y), b.getAddr(0, y), rowBytes)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SkPDFCanon::findFilteredImage(const SkData& key,
+                                   const SkBitmap& source,
+                                   SkBitmap* result,
+                                   SkIPoint* offset) const {
+    for (const FilteredImageRec& rec : fFilteredImageRecords) {
+        if (rec.fKey->equals(&key) && same_pixels(rec.fSource, source)) {
+            *result = rec.fResult;
+            *offset = rec.fOffset;
+            return true;
+        }
+    }
+    return false;
+}
+
+void SkPDFCanon::addFilteredImage(sk_sp<SkData> key,
+                                  const SkBitmap& source,
+                                  const SkBitmap& result,
+                                  SkIPoint offset) {
+    static const size_t kFilteredImageBudget = 64 * 1024 * 1024;
+    // The source is usually a layer that is drawn into again; keep a copy.
+    SkBitmap sourceCopy(source);
+    if (!source.isImmutable()) {
+        if (!source.copyTo(&sourceCopy)) {
+            return;
+        }
+        sourceCopy.setImmutable();
+    }
+    fFilteredImageBytes += sourceCopy.getSafeSize() + result.getSafeSize();
+    fFilteredImageRecords.push_back(
+            FilteredImageRec{std::move(key), sourceCopy, result, offset});
+    int evict = 0;
+    while (fFilteredImageBytes > kFilteredImageBudget &&
+           evict < fFilteredImageRecords.count() - 1) {
+        const FilteredImageRec& rec = fFilteredImageRecords[evict++];
+        fFilteredImageBytes -= rec.fSource.getSafeSize() + rec.fResult.getSafeSize();
+    }
+    if (evict > 0) {
+        int count = fFilteredImageRecords.count();
+        for (int i = evict; i < count; ++i) {
+            fFilteredImageRecords[i - evict] = std::move(fFilteredImageRecords[i]);
+        }
+        fFilteredImageRecords.pop_back_n(evict);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 sk_sp<SkPDFStream> SkPDFCanon::makeInvertFunction() {
     if (fInvertFunction) {
         return fInvertFunction;
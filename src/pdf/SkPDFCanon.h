@@ -7,6 +7,7 @@
 #ifndef SkPDFCanon_DEFINED
 #define SkPDFCanon_DEFINED
 
+#include "SkData.h"
 #include "SkPDFGraphicState.h"
 #include "SkPDFShader.h"
 #include "SkPixelSerializer.h"
@@ -56,6 +57,17 @@ public:
     sk_sp<SkPDFObject> findPDFBitmap(SkBitmapKey key) const;
     void addPDFBitmap(SkBitmapKey key, sk_sp<SkPDFObject>);
 
+    /** Image filter results are keyed by everything that determines them
+     *  (see SkPDFDevice::drawSpecial), so that a filtered layer repeated on
+     *  several pages is filtered and embedded once.  The key only holds a
+     *  hash of the source pixels, so the source is kept too and compared
+     *  before a result is reused.  Only the most recent results are kept,
+     *  to bound memory use. */
+    bool findFilteredImage(const SkData& key, const SkBitmap& source,
+                           SkBitmap* result, SkIPoint* offset) const;
+    void addFilteredImage(sk_sp<SkData> key, const SkBitmap& source,
+                          const SkBitmap& result, SkIPoint offset);
+
     SkTHashMap<uint32_t, SkAdvancedTypefaceMetrics*> fTypefaceMetrics;
     SkTHashMap<uint32_t, SkPDFDict*> fFontDescriptors;
     SkTHashMap<uint64_t, SkPDFFont*> fFontMap;
@@ -80,6 +92,15 @@ private:
     SkTArray<ShaderRec> fAlphaShaderRecords;
     SkTArray<ShaderRec> fImageShaderRecords;
 
+    struct FilteredImageRec {
+        sk_sp<SkData> fKey;
+        SkBitmap fSource;  // Immutable.
+        SkBitmap fResult;
+        SkIPoint fOffset;
+    };
+    SkTArray<FilteredImageRec> fFilteredImageRecords;  // Oldest first.
+    size_t fFilteredImageBytes = 0;
+
     struct WrapGS {
         explicit WrapGS(const SkPDFGraphicState* ptr = nullptr) : fPtr(ptr) {}
         const SkPDFGraphicState* fPtr;
@@ -2277,6 +2277,148 @@ void SkPDFDevice::internalDrawImage(const SkMatrix& origMatrix,
 
 #include "SkSpecialImage.h"
 #include "SkImageFilter.h"
+#include "SkFlattenableSerialization.h"
+#include "SkOpts.h"
+#include "SkTaskGroup.h"
+
+static bool is_flattenable(const SkImageFilter* filter) {
+    if (!filter) {
+        return true;
+    }
+    if (!filter->getTypeName()) {
+        return false;  // Not registered.
+    }
+    for (int i = 0; i < filter->countInputs(); ++i) {
+        if (!is_flattenable(filter->getInput(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Everything that determines the output of an image filter: the flattened
+// filter, the matrix, the clip and a hash of the source, which the canon
+// checks against the source itself.  Returns nullptr if the filter can not
+// be flattened.
+static sk_sp<SkData> make_filter_key(SkImageFilter* filter,
+                                     const SkMatrix& matrix,
+                                     const SkIRect& clipBounds,
+                                     const SkBitmap& src) {
+    if (!is_flattenable(filter)) {
+        return nullptr;
+    }
+    sk_sp<SkData> flattened(SkValidatingSerializeFlattenable(filter));
+    if (!flattened) {
+        return nullptr;
+    }
+    SkAutoLockPixels autoLockPixels(src);
+    if (!src.getPixels()) {
+        return nullptr;
+    }
+    // Two differently seeded hashes of the source, to make collisions unlikely.
+    uint32_t pixelHash[2] = {0, 0x5EED};
+    size_t rowBytes = src.info().minRowBytes();
+    for (int y = 0; y < src.height(); ++y) {
+        const void* row = src.getAddr(0, y);
+        pixelHash[0] = SkOpts::hash(row, rowBytes, pixelHash[0]);
+        pixelHash[1] = SkOpts::hash(row, rowBytes, pixelHash[1]);
+    }
+    SkScalar values[9];
+    matrix.get9(values);
+
+    SkDynamicMemoryWStream key;
+    key.write(flattened->data(), flattened->size());
+    key.write(values, sizeof(values));
+    key.write(&clipBounds, sizeof(clipBounds));
+    key.write32(src.width());
+    key.write32(src.height());
+    key.write32(src.colorType());
+    key.write(pixelHash, sizeof(pixelHash));
+    return key.detachAsData();
+}
+
+// Large layers are filtered in horizontal bands on an SkTaskGroup.  Image
+// filters only promise correct output within the clip bounds they are given,
+// so each band's output is clipped to its band when it is composited.
+static const int kFilterBandHeight = 256;
+static const int kMinBandedFilterArea = 512 * 512;
+
+static bool filter_image(SkImageFilter* filter,
+                         SkSpecialImage* srcImg,
+                         const SkBitmap& srcBM,
+                         const SkMatrix& matrix,
+                         const SkIRect& clipBounds,
+                         SkImageFilterCache* cache,
+                         SkBitmap* result,
+                         SkIPoint* offset) {
+    // TODO: Should PDF be operating in a specified color space? For now, run the filter
+    // in the same color space as the source (this is different from all other backends).
+    SkImageFilter::OutputProperties outputProperties(srcImg->getColorSpace());
+    int bandCount = (clipBounds.height() + kFilterBandHeight - 1) / kFilterBandHeight;
+    if (bandCount < 2 ||
+        (int64_t)clipBounds.width() * clipBounds.height() < kMinBandedFilterArea) {
+        SkImageFilter::Context ctx(matrix, clipBounds, cache, outputProperties);
+        *offset = SkIPoint::Make(0, 0);
+        sk_sp<SkSpecialImage> resultImg(filter->filterImage(srcImg, ctx, offset));
+        return resultImg && resultImg->getROPixels(result);
+    }
+
+    struct Band {
+        SkIRect fClip;
+        sk_sp<SkSpecialImage> fImage;
+        SkIPoint fOffset;
+    };
+    SkAutoTArray<Band> bands(bandCount);
+    SkTaskGroup().batch(bandCount, [&](int i) {
+        Band& band = bands[i];
+        int top = clipBounds.top() + i * kFilterBandHeight;
+        band.fClip = SkIRect::MakeLTRB(clipBounds.left(), top, clipBounds.right(),
+                                       SkTMin(top + kFilterBandHeight, clipBounds.bottom()));
+        band.fOffset = SkIPoint::Make(0, 0);
+        SkImageFilter::Context ctx(matrix, band.fClip, cache, outputProperties);
+        band.fImage = filter->filterImage(srcImg, ctx, &band.fOffset);
+    });
+
+    SkIRect bounds = SkIRect::MakeEmpty();
+    for (int i = 0; i < bandCount; ++i) {
+        const Band& band = bands[i];
+        if (band.fImage) {
+            SkIRect imageBounds = SkIRect::MakeXYWH(band.fOffset.x(), band.fOffset.y(),
+                                                    band.fImage->width(),
+                                                    band.fImage->height());
+            if (imageBounds.intersect(band.fClip)) {
+                bounds.join(imageBounds);
+            }
+        }
+    }
+    // The bands are composited in the source's color space, and at its depth
+    // if that is more than 8888 can hold.
+    SkColorType colorType = kRGBA_F16_SkColorType == srcBM.colorType() ? kRGBA_F16_SkColorType
+                                                                       : kN32_SkColorType;
+    SkImageInfo info = SkImageInfo::Make(bounds.width(), bounds.height(), colorType,
+                                         kPremul_SkAlphaType, sk_ref_sp(srcBM.colorSpace()));
+    if (bounds.isEmpty() || !result->tryAllocPixels(info)) {
+        return false;
+    }
+    result->eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(*result);
+    canvas.translate(-SkIntToScalar(bounds.left()), -SkIntToScalar(bounds.top()));
+    SkPaint paint;
+    paint.setBlendMode(SkBlendMode::kSrc);
+    for (int i = 0; i < bandCount; ++i) {
+        const Band& band = bands[i];
+        SkBitmap bandBM;
+        if (band.fImage && band.fImage->getROPixels(&bandBM)) {
+            canvas.save();
+            canvas.clipRect(SkRect::Make(band.fClip));
+            canvas.drawBitmap(bandBM, SkIntToScalar(band.fOffset.x()),
+                              SkIntToScalar(band.fOffset.y()), &paint);
+            canvas.restore();
+        }
+    }
+    *offset = SkIPoint::Make(bounds.left(), bounds.top());
+    return true;
+}
 
 void SkPDFDevice::drawSpecial(const SkDraw& draw, SkSpecialImage* srcImg, int x, int y,
                                  const SkPaint& paint) {
@@ -2290,20 +2432,36 @@ void SkPDFDevice::drawSpecial(const SkDraw& draw, SkSpecialImage* srcImg, int x,
         SkMatrix matrix = *draw.fMatrix;
         matrix.postTranslate(SkIntToScalar(-x), SkIntToScalar(-y));
         const SkIRect clipBounds = draw.fRC->getBounds().makeOffset(-x, -y);
-        sk_sp<SkImageFilterCache> cache(this->getImageFilterCache());
-        // TODO: Should PDF be operating in a specified color space? For now, run the filter
-        // in the same color space as the source (this is different from all other backends).
-        SkImageFilter::OutputProperties outputProperties(srcImg->getColorSpace());
-        SkImageFilter::Context ctx(matrix, clipBounds, cache.get(), outputProperties);
-
-        sk_sp<SkSpecialImage> resultImg(filter->filterImage(srcImg, ctx, &offset));
-        if (resultImg) {
-            SkPaint tmpUnfiltered(paint);
-            tmpUnfiltered.setImageFilter(nullptr);
-            if (resultImg->getROPixels(&resultBM)) {
-                this->drawSprite(draw, resultBM, x + offset.x(), y + offset.y(), tmpUnfiltered);
+        // Reusing the same (immutable) bitmap lets the canon de-dupe the
+        // image object as well.
+        SkPDFCanon* canon = fDocument->canon();
+        SkBitmap srcBM;
+        if (!srcImg->getROPixels(&srcBM)) {
+            return;
+        }
+        sk_sp<SkData> key = make_filter_key(filter, matrix, clipBounds, srcBM);
+        if (!key || !canon->findFilteredImage(*key, srcBM, &resultBM, &offset)) {
+            sk_sp<SkImageFilterCache> cache(this->getImageFilterCache());
+            if (!filter_image(filter, srcImg, srcBM, matrix, clipBounds, cache.get(),
+                              &resultBM, &offset)) {
+                return;
+            }
+            if (srcBM.pixelRef() == resultBM.pixelRef()) {
+                // The filter passed the (mutable) layer through; keep a copy.
+                SkBitmap copy;
+                if (!resultBM.copyTo(&copy)) {
+                    return;
+                }
+                resultBM = copy;
+            }
+            resultBM.setImmutable();
+            if (key) {
+                canon->addFilteredImage(std::move(key), srcBM, resultBM, offset);
             }
         }
+        SkPaint tmpUnfiltered(paint);
+        tmpUnfiltered.setImageFilter(nullptr);
+        this->drawSprite(draw, resultBM, x + offset.x(), y + offset.y(), tmpUnfiltered);
     } else {
         if (srcImg->getROPixels(&resultBM)) {
             this->drawSprite(draw, resultBM, x, y, paint);
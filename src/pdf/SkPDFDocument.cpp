@@ -12,8 +12,14 @@
 #include "SkPDFDocument.h"
 #include "SkPDFUtils.h"
 #include "SkStream.h"
+#include "SkTaskGroup.h"
 
-SkPDFObjectSerializer::SkPDFObjectSerializer() : fBaseOffset(0), fNextToBeSerialized(0) {}
+SkPDFObjectSerializer::SkPDFObjectSerializer()
+    : fBaseOffset(0)
+    , fNextToBeSerialized(0)
+    , fUseObjectStreams(false)
+    , fPendingCount(0)
+    , fPackedCount(0) {}
 
 template <class T> static void renew(T* t) { t->~T(); new (t) T; }
 
@@ -37,8 +43,12 @@ static_assert((SKPDF_MAGIC[3] & 0x7F) == "Skia"[3], "");
 void SkPDFObjectSerializer::serializeHeader(SkWStream* wStream,
                                             const SkDocument::PDFMetadata& md) {
     fBaseOffset = wStream->bytesWritten();
+    fUseObjectStreams = md.fObjectStreams;
+    // Object streams and cross-reference streams were added in PDF 1.5.
     static const char kHeader[] = "%PDF-1.4\n%" SKPDF_MAGIC "\n";
-    wStream->write(kHeader, strlen(kHeader));
+    static const char kHeader15[] = "%PDF-1.5\n%" SKPDF_MAGIC "\n";
+    const char* header = fUseObjectStreams ? kHeader15 : kHeader;
+    wStream->write(header, strlen(header));
     // The PDF spec recommends including a comment with four
     // bytes, all with their high bits set.  "\xD3\xEB\xE9\xE1" is
     // "Skia" with the high bits set.
@@ -58,6 +68,11 @@ void SkPDFObjectSerializer::serializeObjects(SkWStream* wStream) {
         // always free and has a generation number of 65,535; it is
         // the head of the linked list of free objects."
         SkASSERT(fOffsets.count() == fNextToBeSerialized);
+        if (fUseObjectStreams && object->canBeInObjectStream()) {
+            this->packObject(object, index);
+            ++fNextToBeSerialized;
+            continue;
+        }
         fOffsets.push(this->offset(wStream));
         wStream->writeDecAsText(index);
         wStream->writeText(" 0 obj\n");  // Generation number is always 0.
@@ -68,11 +83,131 @@ void SkPDFObjectSerializer::serializeObjects(SkWStream* wStream) {
     }
 }
 
+// Readers must parse a whole object stream to get at any object in it, so
+// keep them modest in size.
+static const int32_t kObjectsPerObjectStream = 100;
+
+// Append the object to the pending object stream, dropping it as
+// serializeObjects() would.
+void SkPDFObjectSerializer::packObject(SkPDFObject* object, int32_t objNum) {
+    fOffsets.push(-1 - fPackedCount);
+    ++fPackedCount;
+    fPendingIndex.writeDecAsText(objNum);
+    fPendingIndex.writeText(" ");
+    fPendingIndex.writeBigDecAsText(fPendingObjects.bytesWritten());
+    fPendingIndex.writeText("\n");
+    object->emitObject(&fPendingObjects, fObjNumMap);
+    fPendingObjects.writeText("\n");
+    object->drop();
+    if (++fPendingCount == kObjectsPerObjectStream) {
+        this->finishObjectStream();
+    }
+}
+
+void SkPDFObjectSerializer::finishObjectStream() {
+    if (0 == fPendingCount) {
+        return;
+    }
+    ObjectStream& objectStream = fObjectStreams.push_back();
+    objectStream.fCount = fPendingCount;
+    objectStream.fFirst = SkToS32(fPendingIndex.bytesWritten());
+    fPendingObjects.writeToStream(&fPendingIndex);
+    fPendingObjects.reset();
+    objectStream.fEncodedData = SkPDFStream::EncodeData(fPendingIndex.detachAsData(),
+                                                        &objectStream.fDeflated);
+    fPendingCount = 0;
+}
+
+static void write_xref_entry(SkWStream* stream, uint8_t type, uint32_t field2, uint16_t field3) {
+    uint8_t entry[7] = {
+        type,
+        (uint8_t)(field2 >> 24), (uint8_t)(field2 >> 16), (uint8_t)(field2 >> 8), (uint8_t)field2,
+        (uint8_t)(field3 >> 8), (uint8_t)field3,
+    };
+    stream->write(entry, sizeof(entry));
+}
+
+// Object streams, followed by a cross-reference stream that replaces both
+// the xref table and the trailer.
+void SkPDFObjectSerializer::serializeXRefStream(SkWStream* wStream,
+                                                const sk_sp<SkPDFObject> docCatalog,
+                                                sk_sp<SkPDFObject> id) {
+    this->finishObjectStream();
+    const int32_t firstObjectStreamNum = SkToS32(fOffsets.count() + 1);
+    SkTDArray<int32_t> objectStreamOffsets;
+    for (int i = 0; i < fObjectStreams.count(); ++i) {
+        ObjectStream& objectStream = fObjectStreams[i];
+        objectStreamOffsets.push(this->offset(wStream));
+        sk_sp<SkPDFStream> stream = SkPDFStream::MakeWithEncodedData(
+                std::move(objectStream.fEncodedData), objectStream.fDeflated);
+        stream->dict()->insertName("Type", "ObjStm");
+        stream->dict()->insertInt("N", objectStream.fCount);
+        stream->dict()->insertInt("First", objectStream.fFirst);
+        wStream->writeDecAsText(firstObjectStreamNum + i);
+        wStream->writeText(" 0 obj\n");
+        stream->emitObject(wStream, fObjNumMap);
+        wStream->writeText("\nendobj\n");
+    }
+    fObjectStreams.reset();
+
+    // The cross-reference stream includes an entry for itself.
+    const int32_t xRefNum = firstObjectStreamNum + objectStreamOffsets.count();
+    int32_t xRefFileOffset = this->offset(wStream);
+    SkDynamicMemoryWStream xRef;
+    // "The first entry in the table (object number 0) shall always be
+    // free and shall have a generation number of 65,535."
+    write_xref_entry(&xRef, 0, 0, 0xFFFF);
+    for (int i = 0; i < fOffsets.count(); ++i) {
+        if (fOffsets[i] >= 0) {
+            write_xref_entry(&xRef, 1, fOffsets[i], 0);
+        } else {
+            int32_t packedIndex = -1 - fOffsets[i];
+            write_xref_entry(&xRef, 2,
+                             firstObjectStreamNum + packedIndex / kObjectsPerObjectStream,
+                             SkToU16(packedIndex % kObjectsPerObjectStream));
+        }
+    }
+    for (int i = 0; i < objectStreamOffsets.count(); ++i) {
+        write_xref_entry(&xRef, 1, objectStreamOffsets[i], 0);
+    }
+    write_xref_entry(&xRef, 1, xRefFileOffset, 0);
+
+    bool deflated;
+    sk_sp<SkData> xRefData = SkPDFStream::EncodeData(xRef.detachAsData(), &deflated);
+    sk_sp<SkPDFStream> xRefStream = SkPDFStream::MakeWithEncodedData(std::move(xRefData),
+                                                                     deflated);
+    SkPDFDict* dict = xRefStream->dict();
+    dict->insertName("Type", "XRef");
+    dict->insertInt("Size", xRefNum + 1);
+    auto widths = sk_make_sp<SkPDFArray>();
+    widths->appendInt(1);
+    widths->appendInt(4);
+    widths->appendInt(2);
+    dict->insertObject("W", std::move(widths));
+    SkASSERT(docCatalog);
+    dict->insertObjRef("Root", docCatalog);
+    SkASSERT(fInfoDict);
+    dict->insertObjRef("Info", std::move(fInfoDict));
+    if (id) {
+        dict->insertObject("ID", std::move(id));
+    }
+    wStream->writeDecAsText(xRefNum);
+    wStream->writeText(" 0 obj\n");
+    xRefStream->emitObject(wStream, fObjNumMap);
+    wStream->writeText("\nendobj\nstartxref\n");
+    wStream->writeBigDecAsText(xRefFileOffset);
+    wStream->writeText("\n%%EOF");
+}
+
 // Xref table and footer
 void SkPDFObjectSerializer::serializeFooter(SkWStream* wStream,
                                             const sk_sp<SkPDFObject> docCatalog,
                                             sk_sp<SkPDFObject> id) {
     this->serializeObjects(wStream);
+    if (fUseObjectStreams) {
+        this->serializeXRefStream(wStream, docCatalog, std::move(id));
+        return;
+    }
     int32_t xRefFileOffset = this->offset(wStream);
     // Include the special zeroth object in the count.
     int32_t objCount = SkToS32(fOffsets.count() + 1);
@@ -181,6 +316,10 @@ SkPDFDocument::SkPDFDocument(SkWStream* stream,
     , fMetadata(metadata)
     , fPDFA(pdfa) {
     fCanon.setPixelSerializer(std::move(jpegEncoder));
+    // PDF/A-1 forbids object streams and cross-reference streams.
+    if (fPDFA) {
+        fMetadata.fObjectStreams = false;
+    }
 }
 
 SkPDFDocument::~SkPDFDocument() {
@@ -422,8 +561,15 @@ void SkPDFDocument::onClose(SkWStream* stream) {
     }
 
     // Build font subsetting info before calling addObjectRecursively().
+    // Each font only reads from the canon (its metrics were cached when the
+    // font was created), so fonts can be subset concurrently.
+    SkTDArray<SkPDFFont*> fonts;
+    fonts.setReserve(fFonts.count());
+    fFonts.foreach([&fonts](SkPDFFont* p) { fonts.push(p); });
     SkPDFCanon* canon = &fCanon;
-    fFonts.foreach([canon](SkPDFFont* p){ p->getFontSubset(canon); });
+    SkTaskGroup().batch(fonts.count(), [&fonts, canon](int i) {
+        fonts[i]->getFontSubset(canon);
+    });
     fObjectSerializer.addObjectRecursively(docCatalog);
     fObjectSerializer.serializeObjects(this->getStream());
     fObjectSerializer.serializeFooter(this->getStream(), docCatalog, fID);
@@ -11,6 +11,7 @@
 #include "SkPDFCanon.h"
 #include "SkPDFMetadata.h"
 #include "SkPDFFont.h"
+#include "SkStream.h"
 
 class SkPDFDevice;
 
@@ -25,11 +26,30 @@ sk_sp<SkDocument> SkPDFMakeDocument(SkWStream* stream,
 // keep similar functionality together.
 struct SkPDFObjectSerializer : SkNoncopyable {
     SkPDFObjNumMap fObjNumMap;
+    // File offset of each object, or -1 - N for the Nth object packed
+    // into an object stream.
     SkTDArray<int32_t> fOffsets;
     sk_sp<SkPDFObject> fInfoDict;
     size_t fBaseOffset;
     int32_t fNextToBeSerialized;  // index in fObjNumMap
 
+    // PDF 1.5 object streams (see SkDocument::PDFMetadata::fObjectStreams).
+    // Object stream numbers are only known once every other object has been
+    // numbered, so finished object streams are held (compressed) until
+    // serializeFooter().
+    struct ObjectStream {
+        sk_sp<SkData> fEncodedData;
+        bool fDeflated;
+        int32_t fCount;
+        int32_t fFirst;  // Offset of the first object in the decoded data.
+    };
+    bool fUseObjectStreams;
+    SkTArray<ObjectStream> fObjectStreams;
+    SkDynamicMemoryWStream fPendingIndex;    // "objNum offset" pairs.
+    SkDynamicMemoryWStream fPendingObjects;
+    int32_t fPendingCount;
+    int32_t fPackedCount;
+
     SkPDFObjectSerializer();
     ~SkPDFObjectSerializer();
     void addObjectRecursively(const sk_sp<SkPDFObject>&);
@@ -37,6 +57,11 @@ struct SkPDFObjectSerializer : SkNoncopyable {
     void serializeObjects(SkWStream*);
     void serializeFooter(SkWStream*, const sk_sp<SkPDFObject>, sk_sp<SkPDFObject>);
     int32_t offset(SkWStream*);
+
+private:
+    void packObject(SkPDFObject*, int32_t objNum);
+    void finishObjectStream();
+    void serializeXRefStream(SkWStream*, const sk_sp<SkPDFObject>, sk_sp<SkPDFObject>);
 };
 
 /** Concrete implementation of SkDocument that creates PDF files. This
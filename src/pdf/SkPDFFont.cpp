@@ -7,6 +7,7 @@
 
 #include "SkData.h"
 #include "SkGlyphCache.h"
+#include "SkOpts.h"
 #include "SkPaint.h"
 #include "SkPDFCanon.h"
 #include "SkPDFConvertType1FontStream.h"
@@ -16,6 +17,7 @@
 #include "SkPDFFont.h"
 #include "SkPDFUtils.h"
 #include "SkRefCnt.h"
+#include "SkResourceCache.h"
 #include "SkScalar.h"
 #include "SkStream.h"
 #include "SkTypes.h"
@@ -302,19 +304,11 @@ static sk_sp<SkData> stream_to_data(std::unique_ptr<SkStreamAsset> stream) {
     return SkData::MakeFromStream(stream.get(), size);
 }
 
-static sk_sp<SkPDFStream> get_subset_font_stream(
+static sk_sp<SkData> get_subset_font_data(
         std::unique_ptr<SkStreamAsset> fontAsset,
-        const SkBitSet& glyphUsage,
+        const SkTDArray<unsigned>& subset,
         const char* fontName,
         int ttcIndex) {
-    // Generate glyph id array in format needed by sfntly.
-    // TODO(halcanary): sfntly should take a more compact format.
-    SkTDArray<unsigned> subset;
-    if (!glyphUsage.has(0)) {
-        subset.push(0);  // Always include glyph 0.
-    }
-    glyphUsage.exportTo(&subset);
-
     unsigned char* subsetFont{nullptr};
     sk_sp<SkData> fontData(stream_to_data(std::move(fontAsset)));
 #if defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) || defined(GOOGLE3)
@@ -336,22 +330,115 @@ static sk_sp<SkPDFStream> get_subset_font_stream(
                                                    &subsetFont);
 #endif
     fontData.reset();
-    subset.reset();
     SkASSERT(subsetFontSize > 0 || subsetFont == nullptr);
     if (subsetFontSize < 1) {
         return nullptr;
     }
     SkASSERT(subsetFont != nullptr);
-    auto subsetStream = sk_make_sp<SkPDFStream>(
-            SkData::MakeWithProc(
-                    subsetFont, subsetFontSize,
-                    [](const void* p, void*) { delete[] (unsigned char*)p; },
-                    nullptr));
-    subsetStream->dict()->insertInt("Length1", subsetFontSize);
-    return subsetStream;
+    return SkData::MakeWithProc(
+            subsetFont, subsetFontSize,
+            [](const void* p, void*) { delete[] (unsigned char*)p; },
+            nullptr);
 }
 #endif  // SK_PDF_USE_SFNTLY
 
+namespace {
+// The expensive parts of a Type0 font (the sfntly subset, the W array and the
+// ToUnicode CMap) depend only on the typeface and the set of glyphs used, so
+// they are kept in the global SkResourceCache and shared across documents.
+static unsigned gPDFFontSubsetKeyNamespaceLabel;
+
+struct PDFFontSubsetKey : public SkResourceCache::Key {
+    PDFFontSubsetKey(SkFontID fontID, const SkTDArray<unsigned>& glyphs)
+        : fFontID(fontID)
+        , fGlyphCount(glyphs.count())
+        , fGlyphHash(SkOpts::hash(glyphs.begin(), glyphs.bytes())) {
+        this->init(&gPDFFontSubsetKeyNamespaceLabel, 0,
+                   sizeof(fFontID) + sizeof(fGlyphCount) + sizeof(fGlyphHash));
+    }
+
+    SkFontID fFontID;
+    int32_t  fGlyphCount;
+    uint32_t fGlyphHash;
+};
+
+struct PDFFontSubsetValue {
+    sk_sp<SkData> fFontSubset;  // nullptr if the font was not subset.
+    sk_sp<SkData> fToUnicode;   // nullptr if the font has no unicode mapping.
+    sk_sp<SkPDFArray> fWidths;  // nullptr if no W entry is needed.
+    int16_t fDefaultWidth;
+};
+
+struct PDFFontSubsetRec : public SkResourceCache::Rec {
+    PDFFontSubsetRec(const PDFFontSubsetKey& key,
+                     const SkTDArray<unsigned>& glyphs,
+                     PDFFontSubsetValue value)
+        : fKey(key), fGlyphs(glyphs), fValue(std::move(value)) {}
+
+    PDFFontSubsetKey   fKey;
+    SkTDArray<unsigned> fGlyphs;  // The key only holds a hash of these.
+    PDFFontSubsetValue fValue;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fGlyphs.bytes()
+               + (fValue.fFontSubset ? fValue.fFontSubset->size() : 0)
+               + (fValue.fToUnicode ? fValue.fToUnicode->size() : 0)
+               + (fValue.fWidths ? fValue.fWidths->size() * sizeof(SkPDFUnion) : 0);
+    }
+    const char* getCategory() const override { return "pdf-font-subset"; }
+
+    struct Context {
+        const SkTDArray<unsigned>* fGlyphs;
+        PDFFontSubsetValue* fResult;
+    };
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const PDFFontSubsetRec& rec = static_cast<const PDFFontSubsetRec&>(baseRec);
+        Context* context = static_cast<Context*>(contextData);
+        if (rec.fGlyphs != *context->fGlyphs) {
+            return false;  // Hash collision: purge and regenerate.
+        }
+        *context->fResult = rec.fValue;
+        return true;
+    }
+};
+}  // namespace
+
+static PDFFontSubsetValue make_type0_font_subset(
+        SkTypeface* face,
+        const SkAdvancedTypefaceMetrics& metrics,
+        const SkBitSet& glyphUsage,
+        const SkTDArray<unsigned>& glyphs,
+        SkGlyphID firstGlyphID,
+        SkGlyphID lastGlyphID) {
+    PDFFontSubsetValue value;
+    #ifdef SK_PDF_USE_SFNTLY
+    if (metrics.fType == SkAdvancedTypefaceMetrics::kTrueType_Font &&
+        !SkToBool(metrics.fFlags & SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
+        int ttcIndex;
+        std::unique_ptr<SkStreamAsset> fontAsset(face->openStream(&ttcIndex));
+        if (fontAsset && fontAsset->getLength() > 0) {
+            value.fFontSubset = get_subset_font_data(
+                    std::move(fontAsset), glyphs, metrics.fFontName.c_str(), ttcIndex);
+        }
+    }
+    #endif  // SK_PDF_USE_SFNTLY
+    {
+        SkAutoGlyphCache glyphCache = vector_cache(face);
+        value.fDefaultWidth = 0;
+        value.fWidths = SkPDFMakeCIDGlyphWidthsArray(
+                glyphCache.get(), &glyphUsage, metrics.fEmSize, &value.fDefaultWidth);
+    }
+    if (metrics.fGlyphToUnicode.count() > 0) {
+        SkDynamicMemoryWStream cmap;
+        SkPDFAppendToUnicodeCmap(metrics.fGlyphToUnicode, &glyphUsage, true,
+                                 firstGlyphID, lastGlyphID, &cmap);
+        value.fToUnicode = cmap.detachAsData();
+    }
+    return value;
+}
+
 void SkPDFType0Font::getFontSubset(SkPDFCanon* canon) {
     const SkAdvancedTypefaceMetrics* metricsPtr =
         SkPDFFont::GetMetrics(this->typeface(), canon);
@@ -366,46 +453,56 @@ void SkPDFType0Font::getFontSubset(SkPDFCanon* canon) {
     auto descriptor = sk_make_sp<SkPDFDict>("FontDescriptor");
     add_common_font_descriptor_entries(descriptor.get(), metrics, 0);
 
-    int ttcIndex;
-    std::unique_ptr<SkStreamAsset> fontAsset(face->openStream(&ttcIndex));
-    size_t fontSize = fontAsset ? fontAsset->getLength() : 0;
-    if (0 == fontSize) {
-        SkDebugf("Error: (SkTypeface)(%p)::openStream() returned "
-                 "empty stream (%p) when identified as kType1CID_Font "
-                 "or kTrueType_Font.\n", face, fontAsset.get());
+    // Generate glyph id array in format needed by sfntly.  It also serves as
+    // the cache key, since the subset depends only on the glyphs used.
+    // TODO(halcanary): sfntly should take a more compact format.
+    SkTDArray<unsigned> glyphs;
+    if (!this->glyphUsage().has(0)) {
+        glyphs.push(0);  // Always include glyph 0.
+    }
+    this->glyphUsage().exportTo(&glyphs);
+
+    PDFFontSubsetValue subset;
+    PDFFontSubsetKey key(face->uniqueID(), glyphs);
+    PDFFontSubsetRec::Context context = {&glyphs, &subset};
+    if (!SkResourceCache::Find(key, PDFFontSubsetRec::Visitor, &context)) {
+        subset = make_type0_font_subset(face, metrics, this->glyphUsage(), glyphs,
+                                        this->firstGlyphID(), this->lastGlyphID());
+        SkResourceCache::Add(new PDFFontSubsetRec(key, glyphs, subset));
+    }
+
+    if (subset.fFontSubset) {
+        SkASSERT(type == SkAdvancedTypefaceMetrics::kTrueType_Font);
+        size_t subsetSize = subset.fFontSubset->size();
+        auto subsetStream = sk_make_sp<SkPDFStream>(std::move(subset.fFontSubset));
+        subsetStream->dict()->insertInt("Length1", subsetSize);
+        descriptor->insertObjRef("FontFile2", std::move(subsetStream));
     } else {
-        switch (type) {
-            case SkAdvancedTypefaceMetrics::kTrueType_Font: {
-                #ifdef SK_PDF_USE_SFNTLY
-                if (!SkToBool(metrics.fFlags &
-                              SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
-                    sk_sp<SkPDFStream> subsetStream = get_subset_font_stream(
-                            std::move(fontAsset), this->glyphUsage(),
-                            metrics.fFontName.c_str(), ttcIndex);
-                    if (subsetStream) {
-                        descriptor->insertObjRef("FontFile2", std::move(subsetStream));
-                        break;
-                    }
-                    // If subsetting fails, fall back to original font data.
-                    fontAsset.reset(face->openStream(&ttcIndex));
-                    SkASSERT(fontAsset);
-                    SkASSERT(fontAsset->getLength() == fontSize);
-                    if (!fontAsset || fontAsset->getLength() == 0) { break; }
+        // Subsetting is unavailable or failed: embed the original font data.
+        int ttcIndex;
+        std::unique_ptr<SkStreamAsset> fontAsset(face->openStream(&ttcIndex));
+        size_t fontSize = fontAsset ? fontAsset->getLength() : 0;
+        if (0 == fontSize) {
+            SkDebugf("Error: (SkTypeface)(%p)::openStream() returned "
+                     "empty stream (%p) when identified as kType1CID_Font "
+                     "or kTrueType_Font.\n", face, fontAsset.get());
+        } else {
+            switch (type) {
+                case SkAdvancedTypefaceMetrics::kTrueType_Font: {
+                    auto fontStream = sk_make_sp<SkPDFSharedStream>(std::move(fontAsset));
+                    fontStream->dict()->insertInt("Length1", fontSize);
+                    descriptor->insertObjRef("FontFile2", std::move(fontStream));
+                    break;
                 }
-                #endif  // SK_PDF_USE_SFNTLY
-                auto fontStream = sk_make_sp<SkPDFSharedStream>(std::move(fontAsset));
-                fontStream->dict()->insertInt("Length1", fontSize);
-                descriptor->insertObjRef("FontFile2", std::move(fontStream));
-                break;
-            }
-            case SkAdvancedTypefaceMetrics::kType1CID_Font: {
-                auto fontStream = sk_make_sp<SkPDFSharedStream>(std::move(fontAsset));
-                fontStream->dict()->insertName("Subtype", "CIDFontType0C");
-                descriptor->insertObjRef("FontFile3", std::move(fontStream));
-                break;
+                case SkAdvancedTypefaceMetrics::kType1CID_Font: {
+                    auto fontStream = sk_make_sp<SkPDFSharedStream>(std::move(fontAsset));
+                    fontStream->dict()->insertName("Subtype", "CIDFontType0C");
+                    descriptor->insertObjRef("FontFile3", std::move(fontStream));
+                    break;
+                }
+                default:
+                    SkASSERT(false);
             }
-            default:
-                SkASSERT(false);
         }
     }
 
@@ -430,18 +527,12 @@ void SkPDFType0Font::getFontSubset(SkPDFCanon* canon) {
     sysInfo->insertInt("Supplement", 0);
     newCIDFont->insertObject("CIDSystemInfo", std::move(sysInfo));
 
-    uint16_t emSize = metrics.fEmSize;
-    int16_t defaultWidth = 0;
-    {
-        SkAutoGlyphCache glyphCache = vector_cache(face);
-        sk_sp<SkPDFArray> widths = SkPDFMakeCIDGlyphWidthsArray(
-                glyphCache.get(), &this->glyphUsage(), emSize, &defaultWidth);
-        if (widths && widths->size() > 0) {
-            newCIDFont->insertObject("W", std::move(widths));
-        }
-        newCIDFont->insertScalar(
-                "DW", scaleFromFontUnits(defaultWidth, emSize));
+    if (subset.fWidths && subset.fWidths->size() > 0) {
+        // Direct object, so it is never dropped and may be shared.
+        newCIDFont->insertObject("W", std::move(subset.fWidths));
     }
+    newCIDFont->insertScalar(
+            "DW", scaleFromFontUnits(subset.fDefaultWidth, metrics.fEmSize));
 
     ////////////////////////////////////////////////////////////////////////////
 
@@ -452,13 +543,9 @@ void SkPDFType0Font::getFontSubset(SkPDFCanon* canon) {
     descendantFonts->appendObjRef(std::move(newCIDFont));
     this->insertObject("DescendantFonts", std::move(descendantFonts));
 
-    if (metrics.fGlyphToUnicode.count() > 0) {
+    if (subset.fToUnicode) {
         this->insertObjRef("ToUnicode",
-                           SkPDFMakeToUnicodeCmap(metrics.fGlyphToUnicode,
-                                                  &this->glyphUsage(),
-                                                  multiByteGlyphs(),
-                                                  firstGlyphID(),
-                                                  lastGlyphID()));
+                           sk_make_sp<SkPDFStream>(std::move(subset.fToUnicode)));
     }
     SkDEBUGCODE(fPopulated = true);
     return;
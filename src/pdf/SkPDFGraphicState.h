@@ -32,6 +32,7 @@ public:
     // demand.
     void emitObject(SkWStream* stream,
                     const SkPDFObjNumMap& objNumMap) const override;
+    bool canBeInObjectStream() const override { return true; }
 
     /** Get the graphic state for the passed SkPaint. The reference count of
      *  the object is incremented and it is the caller's responsibility to
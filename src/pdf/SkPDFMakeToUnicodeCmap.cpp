@@ -209,6 +209,18 @@ void SkPDFAppendCmapSections(const SkTDArray<SkUnichar>& glyphToUnicode,
     append_bfrange_section(bfrangeEntries, multiByteGlyphs, cmap);
 }
 
+void SkPDFAppendToUnicodeCmap(const SkTDArray<SkUnichar>& glyphToUnicode,
+                              const SkBitSet* subset,
+                              bool multiByteGlyphs,
+                              SkGlyphID firstGlyphID,
+                              SkGlyphID lastGlyphID,
+                              SkDynamicMemoryWStream* cmap) {
+    append_tounicode_header(cmap, multiByteGlyphs);
+    SkPDFAppendCmapSections(glyphToUnicode, subset, cmap, multiByteGlyphs,
+                            firstGlyphID, lastGlyphID);
+    append_cmap_footer(cmap);
+}
+
 sk_sp<SkPDFStream> SkPDFMakeToUnicodeCmap(
         const SkTDArray<SkUnichar>& glyphToUnicode,
         const SkBitSet* subset,
@@ -216,10 +228,8 @@ sk_sp<SkPDFStream> SkPDFMakeToUnicodeCmap(
         SkGlyphID firstGlyphID,
         SkGlyphID lastGlyphID) {
     SkDynamicMemoryWStream cmap;
-    append_tounicode_header(&cmap, multiByteGlyphs);
-    SkPDFAppendCmapSections(glyphToUnicode, subset, &cmap, multiByteGlyphs,
-                            firstGlyphID, lastGlyphID);
-    append_cmap_footer(&cmap);
+    SkPDFAppendToUnicodeCmap(glyphToUnicode, subset, multiByteGlyphs,
+                             firstGlyphID, lastGlyphID, &cmap);
     return sk_make_sp<SkPDFStream>(
             std::unique_ptr<SkStreamAsset>(cmap.detachAsStream()));
 }
@@ -18,6 +18,15 @@ sk_sp<SkPDFStream> SkPDFMakeToUnicodeCmap(
         SkGlyphID firstGlyphID,
         SkGlyphID lastGlyphID);
 
+/** Writes the complete (uncompressed) ToUnicode CMap to cmap.  This is the
+ *  data behind SkPDFMakeToUnicodeCmap(). */
+void SkPDFAppendToUnicodeCmap(const SkTDArray<SkUnichar>& glyphToUnicode,
+                              const SkBitSet* subset,
+                              bool multiByteGlyphs,
+                              SkGlyphID firstGlyphID,
+                              SkGlyphID lastGlyphID,
+                              SkDynamicMemoryWStream* cmap);
+
 // Exposed for unit testing.
 void SkPDFAppendCmapSections(const SkTDArray<SkUnichar>& glyphToUnicode,
                              const SkBitSet* subset,
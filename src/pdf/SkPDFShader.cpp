@@ -9,6 +9,7 @@
 #include "SkPDFShader.h"
 
 #include "SkData.h"
+#include "SkOpts.h"
 #include "SkPDFCanon.h"
 #include "SkPDFDevice.h"
 #include "SkPDFDocument.h"
@@ -16,6 +17,7 @@
 #include "SkPDFGraphicState.h"
 #include "SkPDFResourceDict.h"
 #include "SkPDFUtils.h"
+#include "SkResourceCache.h"
 #include "SkScalar.h"
 #include "SkStream.h"
 #include "SkTemplates.h"
@@ -747,11 +749,117 @@ sk_sp<SkPDFArray> SkPDFShader::MakeRangeObject() {
     return range;
 }
 
+namespace {
+// PostScript function code (and its deflated form) only depends on the
+// gradient and its transform, so it is kept in the global SkResourceCache and
+// reused by every document that draws the same gradient.
+static unsigned gPDFFunctionKeyNamespaceLabel;
+
+struct PDFFunctionKey : public SkResourceCache::Key {
+    explicit PDFFunctionKey(const SkTDArray<uint32_t>& description)
+        : fDescriptionCount(description.count())
+        , fDescriptionHash(SkOpts::hash(description.begin(), description.bytes())) {
+        this->init(&gPDFFunctionKeyNamespaceLabel, 0,
+                   sizeof(fDescriptionCount) + sizeof(fDescriptionHash));
+    }
+
+    int32_t  fDescriptionCount;
+    uint32_t fDescriptionHash;
+};
+
+struct PDFFunctionValue {
+    sk_sp<SkData> fEncodedCode;
+    bool fDeflated;
+};
+
+struct PDFFunctionRec : public SkResourceCache::Rec {
+    PDFFunctionRec(const PDFFunctionKey& key,
+                   const SkTDArray<uint32_t>& description,
+                   PDFFunctionValue value)
+        : fKey(key), fDescription(description), fValue(std::move(value)) {}
+
+    PDFFunctionKey fKey;
+    SkTDArray<uint32_t> fDescription;  // The key only holds a hash of this.
+    PDFFunctionValue fValue;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fDescription.bytes() + fValue.fEncodedCode->size();
+    }
+    const char* getCategory() const override { return "pdf-function"; }
+
+    struct Context {
+        const SkTDArray<uint32_t>* fDescription;
+        PDFFunctionValue* fResult;
+    };
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const PDFFunctionRec& rec = static_cast<const PDFFunctionRec&>(baseRec);
+        Context* context = static_cast<Context*>(contextData);
+        if (rec.fDescription != *context->fDescription) {
+            return false;  // Hash collision: purge and regenerate.
+        }
+        *context->fResult = rec.fValue;
+        return true;
+    }
+};
+}  // namespace
+
+static void append_scalars(const SkScalar* values, int count,
+                           SkTDArray<uint32_t>* description) {
+    static_assert(sizeof(SkScalar) == sizeof(uint32_t), "");
+    memcpy(description->append(count), values, count * sizeof(SkScalar));
+}
+
+static void append_matrix(const SkMatrix& matrix, SkTDArray<uint32_t>* description) {
+    SkScalar values[9];
+    matrix.get9(values);
+    append_scalars(values, 9, description);
+}
+
+// Everything that can change the function code or the domain of a
+// function shader.  Mirrors SkPDFShader::State::operator==.
+static void describe_function_shader(const SkPDFShader::State& state,
+                                     SkTDArray<uint32_t>* description) {
+    const SkShader::GradientInfo& info = state.fInfo;
+    description->push(state.fType);
+    description->push(info.fTileMode);
+    description->push(info.fColorCount);
+    memcpy(description->append(info.fColorCount), info.fColors,
+           info.fColorCount * sizeof(SkColor));
+    append_scalars(info.fColorOffsets, info.fColorCount, description);
+    // Only the geometry the gradient type defines; the rest of fPoint and fRadius is not set.
+    append_scalars(&info.fPoint[0].fX, 2, description);
+    switch (state.fType) {
+        case SkShader::kLinear_GradientType:
+            append_scalars(&info.fPoint[1].fX, 2, description);
+            break;
+        case SkShader::kRadial_GradientType:
+            append_scalars(info.fRadius, 1, description);
+            break;
+        case SkShader::kConical_GradientType:
+            append_scalars(&info.fPoint[1].fX, 2, description);
+            append_scalars(info.fRadius, 2, description);
+            break;
+        case SkShader::kSweep_GradientType:
+        case SkShader::kNone_GradientType:
+        case SkShader::kColor_GradientType:
+            break;
+    }
+    append_matrix(state.fCanvasTransform, description);
+    append_matrix(state.fShaderTransform, description);
+    description->push(state.fBBox.fLeft);
+    description->push(state.fBBox.fTop);
+    description->push(state.fBBox.fRight);
+    description->push(state.fBBox.fBottom);
+}
+
 static sk_sp<SkPDFStream> make_ps_function(
-        std::unique_ptr<SkStreamAsset> psCode,
+        PDFFunctionValue psCode,
         sk_sp<SkPDFArray> domain,
         sk_sp<SkPDFObject> range) {
-    auto result = sk_make_sp<SkPDFStream>(std::move(psCode));
+    auto result = SkPDFStream::MakeWithEncodedData(std::move(psCode.fEncodedCode),
+                                                   psCode.fDeflated);
     result->dict()->insertInt("FunctionType", 4);
     result->dict()->insertObject("Domain", std::move(domain));
     result->dict()->insertObject("Range", std::move(range));
@@ -910,33 +1018,40 @@ static sk_sp<SkPDFDict> make_function_shader(SkPDFCanon* canon,
         domain->appendScalar(bbox.fRight);
         domain->appendScalar(bbox.fTop);
         domain->appendScalar(bbox.fBottom);
-        
-        SkDynamicMemoryWStream functionCode;
-        
-        if (state.fType == SkShader::kConical_GradientType) {
-            SkShader::GradientInfo twoPointRadialInfo = *info;
-            SkMatrix inverseMapperMatrix;
-            if (!mapperMatrix.invert(&inverseMapperMatrix)) {
-                return nullptr;
+
+        SkTDArray<uint32_t> description;
+        describe_function_shader(state, &description);
+        PDFFunctionKey key(description);
+        PDFFunctionValue functionCode;
+        PDFFunctionRec::Context context = {&description, &functionCode};
+        if (!SkResourceCache::Find(key, PDFFunctionRec::Visitor, &context)) {
+            SkDynamicMemoryWStream code;
+            if (state.fType == SkShader::kConical_GradientType) {
+                SkShader::GradientInfo twoPointRadialInfo = *info;
+                SkMatrix inverseMapperMatrix;
+                if (!mapperMatrix.invert(&inverseMapperMatrix)) {
+                    return nullptr;
+                }
+                inverseMapperMatrix.mapPoints(twoPointRadialInfo.fPoint, 2);
+                twoPointRadialInfo.fRadius[0] =
+                    inverseMapperMatrix.mapRadius(info->fRadius[0]);
+                twoPointRadialInfo.fRadius[1] =
+                    inverseMapperMatrix.mapRadius(info->fRadius[1]);
+                codeFunction(twoPointRadialInfo, perspectiveInverseOnly, &code);
+            } else {
+                codeFunction(*info, perspectiveInverseOnly, &code);
             }
-            inverseMapperMatrix.mapPoints(twoPointRadialInfo.fPoint, 2);
-            twoPointRadialInfo.fRadius[0] =
-                inverseMapperMatrix.mapRadius(info->fRadius[0]);
-            twoPointRadialInfo.fRadius[1] =
-                inverseMapperMatrix.mapRadius(info->fRadius[1]);
-            codeFunction(twoPointRadialInfo, perspectiveInverseOnly, &functionCode);
-        } else {
-            codeFunction(*info, perspectiveInverseOnly, &functionCode);
+            functionCode.fEncodedCode = SkPDFStream::EncodeData(code.detachAsData(),
+                                                                &functionCode.fDeflated);
+            SkResourceCache::Add(new PDFFunctionRec(key, description, functionCode));
         }
-        
+
         pdfShader->insertObject("Domain", domain);
 
         // Call canon->makeRangeObject() instead of
         // SkPDFShader::MakeRangeObject() so that the canon can
         // deduplicate.
-        std::unique_ptr<SkStreamAsset> functionStream(
-                functionCode.detachAsStream());
-        sk_sp<SkPDFStream> function = make_ps_function(std::move(functionStream),
+        sk_sp<SkPDFStream> function = make_ps_function(std::move(functionCode),
                                                        std::move(domain),
                                                        canon->makeRangeObject());
         pdfShader->insertObjRef("Function", std::move(function));
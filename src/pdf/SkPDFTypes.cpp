@@ -574,6 +574,37 @@ void SkPDFStream::setData(std::unique_ptr<SkStreamAsset> stream) {
     #endif
 }
 
+sk_sp<SkData> SkPDFStream::EncodeData(sk_sp<SkData> data, bool* deflated) {
+    SkASSERT(data);
+    SkASSERT(deflated);
+    *deflated = false;
+    #ifndef SK_PDF_LESS_COMPRESSION
+    if (data->size() > 0) {
+        SkDynamicMemoryWStream compressedData;
+        SkDeflateWStream deflateWStream(&compressedData);
+        deflateWStream.write(data->data(), data->size());
+        deflateWStream.finalize();
+        if (data->size() > compressedData.bytesWritten() + strlen("/Filter_/FlateDecode_")) {
+            *deflated = true;
+            return compressedData.detachAsData();
+        }
+    }
+    #endif
+    return data;
+}
+
+sk_sp<SkPDFStream> SkPDFStream::MakeWithEncodedData(sk_sp<SkData> encoded,
+                                                    bool deflated) {
+    SkASSERT(encoded);
+    sk_sp<SkPDFStream> stream(new SkPDFStream);
+    stream->fCompressedData = skstd::make_unique<SkMemoryStream>(std::move(encoded));
+    if (deflated) {
+        stream->fDict.insertName("Filter", "FlateDecode");
+    }
+    stream->fDict.insertInt("Length", stream->fCompressedData->getLength());
+    return stream;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 bool SkPDFObjNumMap::addObject(SkPDFObject* obj) {
@@ -56,6 +56,13 @@ public:
      */
     virtual void drop() {}
 
+    /**
+     *  Return true if this object is not a stream, so that it may be
+     *  packed into a PDF 1.5 object stream instead of being written
+     *  as a top-level indirect object.
+     */
+    virtual bool canBeInObjectStream() const { return false; }
+
     virtual ~SkPDFObject() {}
 private:
     typedef SkRefCnt INHERITED;
@@ -194,6 +201,7 @@ public:
                     const SkPDFObjNumMap& objNumMap) const override;
     void addResources(SkPDFObjNumMap*) const override;
     void drop() override;
+    bool canBeInObjectStream() const override { return true; }
 
     /** The size of the array.
      */
@@ -242,6 +250,7 @@ public:
                     const SkPDFObjNumMap& objNumMap) const override;
     void addResources(SkPDFObjNumMap*) const override;
     void drop() override;
+    bool canBeInObjectStream() const override { return true; }
 
     /** The size of the dictionary.
      */
@@ -329,6 +338,16 @@ public:
     explicit SkPDFStream(std::unique_ptr<SkStreamAsset> stream);
     virtual ~SkPDFStream();
 
+    /** Encode data the same way the constructors do, so that the result
+     *  can be kept (e.g. across documents) and passed to
+     *  MakeWithEncodedData() without compressing it again.
+     *  @param deflated Set to true iff the result is FlateDecode-encoded. */
+    static sk_sp<SkData> EncodeData(sk_sp<SkData> data, bool* deflated);
+
+    /** Create a PDF stream from the output of EncodeData(). */
+    static sk_sp<SkPDFStream> MakeWithEncodedData(sk_sp<SkData> encoded,
+                                                  bool deflated);
+
     SkPDFDict* dict() { return &fDict; }
 
     // The SkPDFObject interface.
@@ -25,6 +25,7 @@
 #include "SkStream.h"
 #include "SkString.h"
 #include "SkTemplates.h"
+#include "SkTLazy.h"
 #include "SkTypes.h"
 #include <memory>
 
@@ -86,12 +87,21 @@ FT_MemoryRec_ gFTMemory = { nullptr, sk_ft_alloc, sk_ft_free, sk_ft_realloc };
 
 class FreeTypeLibrary : SkNoncopyable {
 public:
-    FreeTypeLibrary() : fLibrary(nullptr), fIsLCDSupported(false), fLCDExtra(0) {
+    FreeTypeLibrary()
+        : fLibrary(nullptr), fIsLCDSupported(false), fLCDExtra(0), fFacesAreIndependent(false)
+    {
         if (FT_New_Library(&gFTMemory, &fLibrary)) {
             return;
         }
         FT_Add_Default_Modules(fLibrary);
 
+        // Older FreeType libraries keep state shared by all their faces (the rasterizers' render
+        // pool), so faces can only be used concurrently from 2.7 on. The runtime library may be
+        // older than the headers we were built with.
+        FT_Int major, minor, patch;
+        FT_Library_Version(fLibrary, &major, &minor, &patch);
+        fFacesAreIndependent = major > 2 || (major == 2 && minor >= 7);
+
         // Setup LCD filtering. This reduces color fringes for LCD smoothed glyphs.
         // Default { 0x10, 0x40, 0x70, 0x40, 0x10 } adds up to 0x110, simulating ink spread.
         // SetLcdFilter must be called before SetLcdFilterWeights.
@@ -132,11 +142,13 @@ public:
     FT_Library library() { return fLibrary; }
     bool isLCDSupported() { return fIsLCDSupported; }
     int lcdExtra() { return fLCDExtra; }
+    bool facesAreIndependent() { return fFacesAreIndependent; }
 
 private:
     FT_Library fLibrary;
     bool fIsLCDSupported;
     int fLCDExtra;
+    bool fFacesAreIndependent;
 
     // FT_Library_SetLcdFilterWeights was introduced in FreeType 2.4.0.
     // The following platforms provide FreeType of at least 2.4.0.
@@ -150,6 +162,10 @@ private:
 
 struct SkFaceRec;
 
+// gFTMutex guards the library and the list of faces: creating and destroying FT_Faces must be
+// serialized on their FT_Library. Using a face (loading glyphs, changing its active size) needs
+// that face's own SkFaceRec::fMutex, and gFTMutex too unless the library's faces are independent
+// (see AutoFTFaceLock), so with a recent FreeType distinct faces can be used concurrently.
 SK_DECLARE_STATIC_MUTEX(gFTMutex);
 static FreeTypeLibrary* gFTLibrary;
 static SkFaceRec* gFaceRecHead;
@@ -207,6 +223,7 @@ protected:
 
 private:
     FT_Face   fFace;  // Shared face from gFaceRecHead.
+    SkMutex*  fFaceMutex;  // Guards fFace, which other scalers may be using too.
     FT_Size   fFTSize;  // The size on the fFace for this scaler.
     FT_Int    fStrikeIndex;
 
@@ -228,9 +245,8 @@ private:
     void getBBoxForCurrentGlyph(SkGlyph* glyph, FT_BBox* bbox,
                                 bool snapToPixelBoundary = false);
     bool getCBoxForLetter(char letter, FT_BBox* bbox);
-    // Caller must lock gFTMutex before calling this function.
     void updateGlyphIfLCD(SkGlyph* glyph);
-    // Caller must lock gFTMutex before calling this function.
+    // Caller must lock fFaceMutex before calling this function.
     // update FreeType2 glyph slot with glyph emboldened
     void emboldenIfNeeded(FT_Face face, FT_GlyphSlot glyph);
     bool shouldSubpixelBitmap(const SkGlyph&, const SkMatrix&);
@@ -242,6 +258,7 @@ private:
 struct SkFaceRec {
     SkFaceRec* fNext;
     FT_Face fFace;
+    SkMutex fMutex;  // Must be held while using fFace.
     FT_StreamRec fFTStream;
     std::unique_ptr<SkStreamAsset> fSkStream;
     uint32_t fRefCnt;
@@ -366,6 +383,9 @@ static FT_Face ref_ft_face(const SkTypeface* typeface) {
         FT_Select_Charmap(rec->fFace, FT_ENCODING_MS_SYMBOL);
     }
 
+    // The generic field is reserved for clients; let face_mutex() find the rec from the face.
+    rec->fFace->generic.data = rec;
+
     rec->fNext = gFaceRecHead;
     gFaceRecHead = rec;
     return rec->fFace;
@@ -398,28 +418,65 @@ void unref_ft_face(FT_Face face) {
     SkDEBUGFAIL("shouldn't get here, face not in list");
 }
 
+// The face must have come from ref_ft_face() and not yet be unreffed.
+static SkMutex& face_mutex(FT_Face face) {
+    return static_cast<SkFaceRec*>(face->generic.data)->fMutex;
+}
+
+// Locks a face for use. If the runtime FreeType shares state between faces, this holds gFTMutex
+// as well, taken after the face's own mutex. The caller must hold a ref on the library.
+class AutoFTFaceLock : SkNoncopyable {
+public:
+    AutoFTFaceLock(SkMutex& faceMutex)
+        : fFaceMutex(faceMutex)
+        , fLocksLibrary(!gFTLibrary->facesAreIndependent())
+    {
+        fFaceMutex.acquire();
+        if (fLocksLibrary) {
+            gFTMutex.acquire();
+        }
+    }
+    ~AutoFTFaceLock() {
+        if (fLocksLibrary) {
+            gFTMutex.release();
+        }
+        fFaceMutex.release();
+    }
+
+private:
+    SkMutex&    fFaceMutex;
+    const bool  fLocksLibrary;
+};
+
 class AutoFTAccess {
 public:
     AutoFTAccess(const SkTypeface* tf) : fFace(nullptr) {
-        gFTMutex.acquire();
-        if (!ref_ft_library()) {
-            sk_throw();
+        {
+            SkAutoMutexAcquire ac(gFTMutex);
+            if (!ref_ft_library()) {
+                sk_throw();
+            }
+            fFace = ref_ft_face(tf);
+        }
+        if (fFace) {
+            fFaceLock.init(face_mutex(fFace));
         }
-        fFace = ref_ft_face(tf);
     }
 
     ~AutoFTAccess() {
+        fFaceLock.reset();
+        SkAutoMutexAcquire ac(gFTMutex);
         if (fFace) {
             unref_ft_face(fFace);
         }
         unref_ft_library();
-        gFTMutex.release();
     }
 
     FT_Face face() { return fFace; }
 
 private:
-    FT_Face     fFace;
+    FT_Face                 fFace;
+    SkTLazy<AutoFTFaceLock> fFaceLock;
 };
 
 ///////////////////////////////////////////////////////////////////////////
@@ -738,23 +795,25 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface> typeface,
                                                    const SkDescriptor* desc)
     : SkScalerContext_FreeType_Base(std::move(typeface), effects, desc)
     , fFace(nullptr)
+    , fFaceMutex(nullptr)
     , fFTSize(nullptr)
     , fStrikeIndex(-1)
 {
-    SkAutoMutexAcquire  ac(gFTMutex);
+    {
+        SkAutoMutexAcquire  ac(gFTMutex);
 
-    if (!ref_ft_library()) {
-        sk_throw();
-    }
+        if (!ref_ft_library()) {
+            sk_throw();
+        }
 
-    // load the font file
-    using UnrefFTFace = SkFunctionWrapper<void, skstd::remove_pointer_t<FT_Face>, unref_ft_face>;
-    using FT_FaceRef = skstd::remove_pointer_t<FT_Face>;
-    std::unique_ptr<FT_FaceRef, UnrefFTFace> ftFace(ref_ft_face(this->getTypeface()));
-    if (nullptr == ftFace) {
+        // load the font file; from here on the destructor releases it, even if we fail below
+        fFace = ref_ft_face(this->getTypeface());
+    }
+    if (nullptr == fFace) {
         SkDEBUGF(("Could not create FT_Face.\n"));
         return;
     }
+    fFaceMutex = &face_mutex(fFace);
 
     fRec.computeMatrices(SkScalerContextRec::kFull_PreMatrixScale, &fScale, &fMatrix22Scalar);
 
@@ -836,12 +895,14 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface> typeface,
         fLoadGlyphFlags = loadFlags;
     }
 
+    AutoFTFaceLock  ac(*fFaceMutex);
+
     using DoneFTSize = SkFunctionWrapper<FT_Error, skstd::remove_pointer_t<FT_Size>, FT_Done_Size>;
-    std::unique_ptr<skstd::remove_pointer_t<FT_Size>, DoneFTSize> ftSize([&ftFace]() -> FT_Size {
+    std::unique_ptr<skstd::remove_pointer_t<FT_Size>, DoneFTSize> ftSize([this]() -> FT_Size {
         FT_Size size;
-        FT_Error err = FT_New_Size(ftFace.get(), &size);
+        FT_Error err = FT_New_Size(fFace, &size);
         if (err != 0) {
-            SkDEBUGF(("FT_New_Size(%s) returned 0x%x.\n", ftFace->family_name, err));
+            SkDEBUGF(("FT_New_Size(%s) returned 0x%x.\n", fFace->family_name, err));
             return nullptr;
         }
         return size;
@@ -853,36 +914,36 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface> typeface,
 
     FT_Error err = FT_Activate_Size(ftSize.get());
     if (err != 0) {
-        SkDEBUGF(("FT_Activate_Size(%s) returned 0x%x.\n", ftFace->family_name, err));
+        SkDEBUGF(("FT_Activate_Size(%s) returned 0x%x.\n", fFace->family_name, err));
         return;
     }
 
-    if (FT_IS_SCALABLE(ftFace)) {
-        err = FT_Set_Char_Size(ftFace.get(), scaleX, scaleY, 72, 72);
+    if (FT_IS_SCALABLE(fFace)) {
+        err = FT_Set_Char_Size(fFace, scaleX, scaleY, 72, 72);
         if (err != 0) {
             SkDEBUGF(("FT_Set_CharSize(%s, %f, %f) returned 0x%x.\n",
-                      ftFace->family_name, fScale.fX, fScale.fY, err));
+                      fFace->family_name, fScale.fX, fScale.fY, err));
             return;
         }
-    } else if (FT_HAS_FIXED_SIZES(ftFace)) {
-        fStrikeIndex = chooseBitmapStrike(ftFace.get(), scaleY);
+    } else if (FT_HAS_FIXED_SIZES(fFace)) {
+        fStrikeIndex = chooseBitmapStrike(fFace, scaleY);
         if (fStrikeIndex == -1) {
-            SkDEBUGF(("No glyphs for font \"%s\" size %f.\n", ftFace->family_name, fScale.fY));
+            SkDEBUGF(("No glyphs for font \"%s\" size %f.\n", fFace->family_name, fScale.fY));
             return;
         }
 
-        err = FT_Select_Size(ftFace.get(), fStrikeIndex);
+        err = FT_Select_Size(fFace, fStrikeIndex);
         if (err != 0) {
             SkDEBUGF(("FT_Select_Size(%s, %d) returned 0x%x.\n",
-                      ftFace->family_name, fStrikeIndex, err));
+                      fFace->family_name, fStrikeIndex, err));
             fStrikeIndex = -1;
             return;
         }
 
         // A non-ideal size was picked, so recompute the matrix.
         // This adjusts for the difference between FT_Set_Char_Size and FT_Select_Size.
-        fMatrix22Scalar.preScale(fScale.x() / ftFace->size->metrics.x_ppem,
-                                 fScale.y() / ftFace->size->metrics.y_ppem);
+        fMatrix22Scalar.preScale(fScale.x() / fFace->size->metrics.x_ppem,
+                                 fScale.y() / fFace->size->metrics.y_ppem);
         fMatrix22.xx = SkScalarToFixed(fMatrix22Scalar.getScaleX());
         fMatrix22.xy = SkScalarToFixed(-fMatrix22Scalar.getSkewX());
         fMatrix22.yx = SkScalarToFixed(-fMatrix22Scalar.getSkewY());
@@ -904,17 +965,17 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface> typeface,
     }
 
     fFTSize = ftSize.release();
-    fFace = ftFace.release();
     fDoLinearMetrics = linearMetrics;
 }
 
 SkScalerContext_FreeType::~SkScalerContext_FreeType() {
-    SkAutoMutexAcquire  ac(gFTMutex);
-
     if (fFTSize != nullptr) {
+        AutoFTFaceLock  ac(*fFaceMutex);
         FT_Done_Size(fFTSize);
     }
 
+    SkAutoMutexAcquire  ac(gFTMutex);
+
     if (fFace != nullptr) {
         unref_ft_face(fFace);
     }
@@ -926,7 +987,7 @@ SkScalerContext_FreeType::~SkScalerContext_FreeType() {
     this face with other context (at different sizes).
 */
 FT_Error SkScalerContext_FreeType::setupSize() {
-    gFTMutex.assertHeld();
+    fFaceMutex->assertHeld();
     FT_Error err = FT_Activate_Size(fFTSize);
     if (err != 0) {
         return err;
@@ -940,12 +1001,12 @@ unsigned SkScalerContext_FreeType::generateGlyphCount() {
 }
 
 uint16_t SkScalerContext_FreeType::generateCharToGlyph(SkUnichar uni) {
-    SkAutoMutexAcquire  ac(gFTMutex);
+    AutoFTFaceLock  ac(*fFaceMutex);
     return SkToU16(FT_Get_Char_Index( fFace, uni ));
 }
 
 SkUnichar SkScalerContext_FreeType::generateGlyphToChar(uint16_t glyph) {
-    SkAutoMutexAcquire  ac(gFTMutex);
+    AutoFTFaceLock  ac(*fFaceMutex);
     // iterate through each cmap entry, looking for matching glyph indices
     FT_UInt glyphIndex;
     SkUnichar charCode = FT_Get_First_Char( fFace, &glyphIndex );
@@ -969,7 +1030,7 @@ void SkScalerContext_FreeType::generateAdvance(SkGlyph* glyph) {
     * which are very cheap to compute with some font formats...
     */
     if (fDoLinearMetrics) {
-        SkAutoMutexAcquire  ac(gFTMutex);
+        AutoFTFaceLock  ac(*fFaceMutex);
 
         if (this->setupSize()) {
             glyph->zeroMetrics();
@@ -1078,7 +1139,7 @@ bool SkScalerContext_FreeType::shouldSubpixelBitmap(const SkGlyph& glyph, const
 }
 
 void SkScalerContext_FreeType::generateMetrics(SkGlyph* glyph) {
-    SkAutoMutexAcquire  ac(gFTMutex);
+    AutoFTFaceLock  ac(*fFaceMutex);
 
     glyph->fRsbDelta = 0;
     glyph->fLsbDelta = 0;
@@ -1191,7 +1252,7 @@ static void clear_glyph_image(const SkGlyph& glyph) {
 }
 
 void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph) {
-    SkAutoMutexAcquire  ac(gFTMutex);
+    AutoFTFaceLock  ac(*fFaceMutex);
 
     if (this->setupSize()) {
         clear_glyph_image(glyph);
@@ -1220,7 +1281,7 @@ void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph) {
 
 
 void SkScalerContext_FreeType::generatePath(SkGlyphID glyphID, SkPath* path) {
-    SkAutoMutexAcquire  ac(gFTMutex);
+    AutoFTFaceLock  ac(*fFaceMutex);
 
     SkASSERT(path);
 
@@ -1261,7 +1322,7 @@ void SkScalerContext_FreeType::generateFontMetrics(SkPaint::FontMetrics* metrics
         return;
     }
 
-    SkAutoMutexAcquire ac(gFTMutex);
+    AutoFTFaceLock ac(*fFaceMutex);
 
     if (this->setupSize()) {
         sk_bzero(metrics, sizeof(*metrics));
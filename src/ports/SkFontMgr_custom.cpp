@@ -5,27 +5,38 @@
  * found in the LICENSE file.
  */
 
+#include "SkData.h"
 #include "SkFontDescriptor.h"
 #include "SkFontHost_FreeType_common.h"
 #include "SkFontMgr.h"
 #include "SkFontMgr_custom.h"
 #include "SkFontStyle.h"
 #include "SkMakeUnique.h"
+#include "SkMutex.h"
+#include "SkOpts.h"
 #include "SkOSFile.h"
 #include "SkOSPath.h"
 #include "SkRefCnt.h"
 #include "SkStream.h"
 #include "SkString.h"
 #include "SkTArray.h"
+#include "SkTHash.h"
 #include "SkTemplates.h"
 #include "SkTypeface.h"
 #include "SkTypefaceCache.h"
 #include "SkTypes.h"
+#include "SkWeakRefCnt.h"
 
+#include <cstdio>
 #include <limits>
 #include <memory>
+#include <sys/stat.h>
 
-class SkData;
+#ifdef SK_BUILD_FOR_WIN
+#    include <process.h>
+#else
+#    include <unistd.h>
+#endif
 
 /** The base SkTypeface implementation for the custom font manager. */
 class SkTypeface_Custom : public SkTypeface_FreeType {
@@ -99,23 +110,78 @@ private:
     typedef SkTypeface_Custom INHERITED;
 };
 
+/**
+ *  A font file, shared by the typefaces of all of its faces. While any stream opened on it is
+ *  alive the file is mapped once, and every stream reads that one mapping. Its pages stay file
+ *  backed, shared with other processes using the font. The file is unmapped when the last stream
+ *  is closed.
+ */
+class SkFontFile_Custom : public SkRefCnt {
+public:
+    explicit SkFontFile_Custom(const char path[]) : fPath(path), fMapping(nullptr) { }
+
+    ~SkFontFile_Custom() override {
+        if (fMapping) {
+            fMapping->weak_unref();
+        }
+    }
+
+    SkStreamAsset* openStream() const {
+        sk_sp<Mapping> mapping;
+        {
+            SkAutoMutexAcquire lock(fMutex);
+            if (fMapping && fMapping->try_ref()) {
+                mapping.reset(fMapping);
+            } else {
+                sk_sp<SkData> data = SkData::MakeFromFileName(fPath.c_str());
+                if (!data) {
+                    return SkStream::MakeFromFile(fPath.c_str()).release();
+                }
+                if (fMapping) {
+                    fMapping->weak_unref();
+                }
+                mapping = sk_make_sp<Mapping>(std::move(data));
+                fMapping = mapping.get();
+                fMapping->weak_ref();
+            }
+        }
+        // Each stream holds a strong ref on the mapping, released with the stream's data.
+        const SkData* data = mapping->fData.get();
+        return new SkMemoryStream(SkData::MakeWithProc(data->data(), data->size(),
+                                                       [](const void*, void* ctx) {
+                                                           static_cast<Mapping*>(ctx)->unref();
+                                                       }, mapping.release()));
+    }
+
+private:
+    struct Mapping : public SkWeakRefCnt {
+        explicit Mapping(sk_sp<SkData> data) : fData(std::move(data)) { }
+        void weak_dispose() const override { fData.reset(); }
+        mutable sk_sp<SkData> fData;
+    };
+
+    const SkString fPath;
+    mutable SkMutex fMutex;
+    mutable Mapping* fMapping;  // Weak ref, guarded by fMutex.
+};
+
 /** The file SkTypeface implementation for the custom font manager. */
 class SkTypeface_File : public SkTypeface_Custom {
 public:
     SkTypeface_File(const SkFontStyle& style, bool isFixedPitch, bool sysFont,
-                    const SkString familyName, const char path[], int index)
+                    const SkString familyName, sk_sp<SkFontFile_Custom> file, int index)
         : INHERITED(style, isFixedPitch, sysFont, familyName, index)
-        , fPath(path)
+        , fFile(std::move(file))
     { }
 
 protected:
     SkStreamAsset* onOpenStream(int* ttcIndex) const override {
         *ttcIndex = this->getIndex();
-        return SkStream::MakeFromFile(fPath.c_str()).release();
+        return fFile->openStream();
     }
 
 private:
-    SkString fPath;
+    sk_sp<SkFontFile_Custom> fFile;
 
     typedef SkTypeface_Custom INHERITED;
 };
@@ -332,17 +398,209 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/**
+ *  What scanning the font files of a directory found, saved to a file so that the next process
+ *  to load the directory can skip scanning (and touching) every font with FreeType.
+ *
+ *  A file's entry is used only while the file has the same size, modification time and hash of
+ *  its first bytes. For most fonts those bytes hold the sfnt table directory, with the checksum of
+ *  every table, but Type 1 fonts and big collections keep their tables past them, so the time is
+ *  needed too. Checking a file only reads one page of it.
+ */
+class FontScanCache : SkNoncopyable {
+public:
+    struct Face {
+        int         fIndex;
+        SkString    fName;
+        SkFontStyle fStyle;
+        bool        fIsFixedPitch;
+    };
+    struct File {
+        uint64_t        fSize;
+        int64_t         fModified;
+        uint32_t        fFingerprint;
+        SkTArray<Face>  fFaces;  // Empty if the file is not a font.
+    };
+
+    /** Reads the cache at path, if there is a valid one. */
+    explicit FontScanCache(const char path[]) : fPath(path), fChanged(false) {
+        sk_sp<SkData> data = SkData::MakeFromFileName(path);
+        if (data && !read_files(data, &fCached)) {
+            fCached.reset();
+        }
+    }
+
+    /** Sets the size, modification time and fingerprint of file. Returns false if the file
+     *  can't be read.
+     */
+    static bool Fingerprint(const char path[], File* file) {
+        struct stat status;
+        if (0 != stat(path, &status)) {
+            return false;
+        }
+        SkFILEStream stream(path);
+        if (!stream.isValid()) {
+            return false;
+        }
+        char header[4096];
+        file->fSize = stream.getLength();
+        file->fModified = status.st_mtime;
+        file->fFingerprint = SkOpts::hash(header, stream.read(header, sizeof(header)));
+        return true;
+    }
+
+    /** Returns the entry for the file at path if it still matches fingerprinted, or nullptr. */
+    const File* find(const SkString& path, const File& fingerprinted) {
+        const File* file = fCached.find(path);
+        if (!file || file->fSize != fingerprinted.fSize ||
+            file->fModified != fingerprinted.fModified ||
+            file->fFingerprint != fingerprinted.fFingerprint) {
+            return nullptr;
+        }
+        return fSeen.set(path, *file);
+    }
+
+    /** Records what scanning the file at path found. */
+    void add(const SkString& path, File file) {
+        fSeen.set(path, std::move(file));
+        fChanged = true;
+    }
+
+    /** If the files seen differ from those cached, replace the cache with the files seen. */
+    void write() const {
+        if (!fChanged && fSeen.count() == fCached.count()) {
+            return;
+        }
+        // Processes starting together may all write the cache, so each writes its own file.
+        SkString tmpPath = SkStringPrintf("%s.%d.tmp", fPath.c_str(), get_process_id());
+        bool written;
+        {
+            SkFILEWStream stream(tmpPath.c_str());
+            written = stream.isValid() && write_files(fSeen, &stream);
+        }
+        // Replace rather than overwrite the file, as another process may be reading it.
+        if (!written || !sk_rename(tmpPath.c_str(), fPath.c_str())) {
+            remove(tmpPath.c_str());
+        }
+    }
+
+private:
+    using Files = SkTHashMap<SkString, File>;
+    static constexpr uint32_t kMagic = SkSetFourByteTag('s', 'k', 'f', 's');
+    static constexpr uint32_t kVersion = 2;
+
+    static int get_process_id() {
+#ifdef SK_BUILD_FOR_WIN
+        return _getpid();
+#else
+        return getpid();
+#endif
+    }
+
+    static bool write_string(const SkString& string, SkWStream* stream) {
+        return stream->write32(SkToU32(string.size())) &&
+               stream->write(string.c_str(), string.size());
+    }
+
+    static bool write_files(const Files& files, SkWStream* stream) {
+        bool ok = stream->write32(kMagic) && stream->write32(kVersion) &&
+                  stream->write32(files.count());
+        files.foreach([&](const SkString& path, const File& file) {
+            ok = ok && write_string(path, stream) &&
+                 stream->write(&file.fSize, sizeof(file.fSize)) &&
+                 stream->write(&file.fModified, sizeof(file.fModified)) &&
+                 stream->write32(file.fFingerprint) &&
+                 stream->write32(file.fFaces.count());
+            for (const Face& face : file.fFaces) {
+                ok = ok && stream->write32(face.fIndex) && write_string(face.fName, stream) &&
+                     stream->write32(face.fStyle.weight()) &&
+                     stream->write32(face.fStyle.width()) &&
+                     stream->write32(face.fStyle.slant()) &&
+                     stream->write32(face.fIsFixedPitch);
+            }
+        });
+        return ok;
+    }
+
+    static bool read_u32(SkStream* stream, uint32_t* value) {
+        return stream->read(value, sizeof(*value)) == sizeof(*value);
+    }
+
+    static bool read_string(SkStreamAsset* stream, SkString* string) {
+        uint32_t length;
+        if (!read_u32(stream, &length) ||
+            length > stream->getLength() - stream->getPosition()) {
+            return false;
+        }
+        string->resize(length);
+        return stream->read(string->writable_str(), length) == length;
+    }
+
+    static bool read_files(sk_sp<SkData> data, Files* files) {
+        SkMemoryStream stream(std::move(data));
+        uint32_t magic, version, fileCount;
+        if (!read_u32(&stream, &magic) || magic != kMagic ||
+            !read_u32(&stream, &version) || version != kVersion ||
+            !read_u32(&stream, &fileCount)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < fileCount; ++i) {
+            SkString path;
+            File file;
+            uint32_t faceCount;
+            if (!read_string(&stream, &path) ||
+                stream.read(&file.fSize, sizeof(file.fSize)) != sizeof(file.fSize) ||
+                stream.read(&file.fModified, sizeof(file.fModified)) != sizeof(file.fModified) ||
+                !read_u32(&stream, &file.fFingerprint) ||
+                !read_u32(&stream, &faceCount) ||
+                faceCount > stream.getLength() - stream.getPosition()) {
+                return false;
+            }
+            for (uint32_t j = 0; j < faceCount; ++j) {
+                Face& face = file.fFaces.push_back();
+                uint32_t index, weight, width, slant, isFixedPitch;
+                if (!read_u32(&stream, &index) || !read_string(&stream, &face.fName) ||
+                    !read_u32(&stream, &weight) || !read_u32(&stream, &width) ||
+                    !read_u32(&stream, &slant) || slant > SkFontStyle::kOblique_Slant ||
+                    !read_u32(&stream, &isFixedPitch)) {
+                    return false;
+                }
+                face.fIndex = index;
+                face.fStyle = SkFontStyle(weight, width, (SkFontStyle::Slant)slant);
+                face.fIsFixedPitch = SkToBool(isFixedPitch);
+            }
+            files->set(std::move(path), std::move(file));
+        }
+        return stream.isAtEnd();
+    }
+
+    const SkString fPath;
+    Files          fCached;
+    Files          fSeen;
+    bool           fChanged;
+};
+
 class DirectorySystemFontLoader : public SkFontMgr_Custom::SystemFontLoader {
 public:
-    DirectorySystemFontLoader(const char* dir) : fBaseDirectory(dir) { }
+    DirectorySystemFontLoader(const char* dir, const char* scanCachePath)
+        : fBaseDirectory(dir), fScanCachePath(scanCachePath) { }
 
     void loadSystemFonts(const SkTypeface_FreeType::Scanner& scanner,
                          SkFontMgr_Custom::Families* families) const override
     {
-        load_directory_fonts(scanner, fBaseDirectory, ".ttf", families);
-        load_directory_fonts(scanner, fBaseDirectory, ".ttc", families);
-        load_directory_fonts(scanner, fBaseDirectory, ".otf", families);
-        load_directory_fonts(scanner, fBaseDirectory, ".pfb", families);
+        std::unique_ptr<FontScanCache> cache;
+        if (!fScanCachePath.isEmpty()) {
+            cache.reset(new FontScanCache(fScanCachePath.c_str()));
+        }
+
+        load_directory_fonts(scanner, cache.get(), fBaseDirectory, ".ttf", families);
+        load_directory_fonts(scanner, cache.get(), fBaseDirectory, ".ttc", families);
+        load_directory_fonts(scanner, cache.get(), fBaseDirectory, ".otf", families);
+        load_directory_fonts(scanner, cache.get(), fBaseDirectory, ".pfb", families);
+
+        if (cache) {
+            cache->write();
+        }
 
         if (families->empty()) {
             SkFontStyleSet_Custom* family = new SkFontStyleSet_Custom(SkString());
@@ -363,7 +621,40 @@ private:
         return nullptr;
     }
 
+    // Scan the faces of the font file with FreeType. Returns false if it can't be opened.
+    static bool scan_file(const SkTypeface_FreeType::Scanner& scanner, const SkString& filename,
+                          SkTArray<FontScanCache::Face>* faces)
+    {
+        std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(filename.c_str());
+        if (!stream) {
+            SkDebugf("---- failed to open <%s>\n", filename.c_str());
+            return false;
+        }
+
+        int numFaces;
+        if (!scanner.recognizedFont(stream.get(), &numFaces)) {
+            SkDebugf("---- failed to open <%s> as a font\n", filename.c_str());
+            return true;
+        }
+
+        for (int faceIndex = 0; faceIndex < numFaces; ++faceIndex) {
+            FontScanCache::Face face;
+            face.fIndex = faceIndex;
+            face.fStyle = SkFontStyle(); // avoid uninitialized warning
+            if (!scanner.scanFont(stream.get(), faceIndex,
+                                  &face.fName, &face.fStyle, &face.fIsFixedPitch, nullptr))
+            {
+                SkDebugf("---- failed to open <%s> <%d> as a font\n",
+                         filename.c_str(), faceIndex);
+                continue;
+            }
+            faces->push_back(std::move(face));
+        }
+        return true;
+    }
+
     static void load_directory_fonts(const SkTypeface_FreeType::Scanner& scanner,
+                                     FontScanCache* cache,
                                      const SkString& directory, const char* suffix,
                                      SkFontMgr_Custom::Families* families)
     {
@@ -372,38 +663,41 @@ private:
 
         while (iter.next(&name, false)) {
             SkString filename(SkOSPath::Join(directory.c_str(), name.c_str()));
-            std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(filename.c_str());
-            if (!stream) {
-                SkDebugf("---- failed to open <%s>\n", filename.c_str());
-                continue;
-            }
 
-            int numFaces;
-            if (!scanner.recognizedFont(stream.get(), &numFaces)) {
-                SkDebugf("---- failed to open <%s> as a font\n", filename.c_str());
-                continue;
+            const SkTArray<FontScanCache::Face>* faces;
+            FontScanCache::File scanned;
+            const bool fingerprinted = cache && FontScanCache::Fingerprint(filename.c_str(),
+                                                                           &scanned);
+            const FontScanCache::File* cached = nullptr;
+            if (fingerprinted) {
+                cached = cache->find(filename, scanned);
             }
-
-            for (int faceIndex = 0; faceIndex < numFaces; ++faceIndex) {
-                bool isFixedPitch;
-                SkString realname;
-                SkFontStyle style = SkFontStyle(); // avoid uninitialized warning
-                if (!scanner.scanFont(stream.get(), faceIndex,
-                                      &realname, &style, &isFixedPitch, nullptr))
-                {
-                    SkDebugf("---- failed to open <%s> <%d> as a font\n",
-                             filename.c_str(), faceIndex);
+            if (cached) {
+                faces = &cached->fFaces;
+            } else {
+                if (!scan_file(scanner, filename, &scanned.fFaces)) {
                     continue;
                 }
+                faces = &scanned.fFaces;
+            }
 
-                SkFontStyleSet_Custom* addTo = find_family(*families, realname.c_str());
+            sk_sp<SkFontFile_Custom> file;
+            if (!faces->empty()) {
+                file = sk_make_sp<SkFontFile_Custom>(filename.c_str());
+            }
+            for (const FontScanCache::Face& face : *faces) {
+                SkFontStyleSet_Custom* addTo = find_family(*families, face.fName.c_str());
                 if (nullptr == addTo) {
-                    addTo = new SkFontStyleSet_Custom(realname);
+                    addTo = new SkFontStyleSet_Custom(face.fName);
                     families->push_back().reset(addTo);
                 }
-                addTo->appendTypeface(sk_make_sp<SkTypeface_File>(style, isFixedPitch, true,
-                                                                  realname, filename.c_str(),
-                                                                  faceIndex));
+                addTo->appendTypeface(sk_make_sp<SkTypeface_File>(face.fStyle, face.fIsFixedPitch,
+                                                                  true, face.fName,
+                                                                  file, face.fIndex));
+            }
+
+            if (fingerprinted && !cached) {
+                cache->add(filename, std::move(scanned));
             }
         }
 
@@ -413,15 +707,20 @@ private:
                 continue;
             }
             SkString dirname(SkOSPath::Join(directory.c_str(), name.c_str()));
-            load_directory_fonts(scanner, dirname, suffix, families);
+            load_directory_fonts(scanner, cache, dirname, suffix, families);
         }
     }
 
     SkString fBaseDirectory;
+    SkString fScanCachePath;
 };
 
 SK_API SkFontMgr* SkFontMgr_New_Custom_Directory(const char* dir) {
-    return new SkFontMgr_Custom(DirectorySystemFontLoader(dir));
+    return SkFontMgr_New_Custom_Directory(dir, nullptr);
+}
+
+SK_API SkFontMgr* SkFontMgr_New_Custom_Directory(const char* dir, const char* scanCachePath) {
+    return new SkFontMgr_Custom(DirectorySystemFontLoader(dir, scanCachePath));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
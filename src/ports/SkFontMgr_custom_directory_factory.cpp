@@ -13,5 +13,9 @@
 #endif
 
 SkFontMgr* SkFontMgr::Factory() {
+#ifdef SK_FONT_SCAN_CACHE_FILE
+    return SkFontMgr_New_Custom_Directory(SK_FONT_FILE_PREFIX, SK_FONT_SCAN_CACHE_FILE);
+#else
     return SkFontMgr_New_Custom_Directory(SK_FONT_FILE_PREFIX);
+#endif
 }
@@ -6,20 +6,25 @@
  */
 
 #include "SkAdvancedTypefaceMetrics.h"
+#include "SkChecksum.h"
 #include "SkDataTable.h"
 #include "SkFixed.h"
 #include "SkFontDescriptor.h"
 #include "SkFontHost_FreeType_common.h"
 #include "SkFontMgr.h"
 #include "SkFontStyle.h"
+#include "SkLRUCache.h"
 #include "SkMakeUnique.h"
 #include "SkMath.h"
 #include "SkMutex.h"
 #include "SkOSFile.h"
 #include "SkRefCnt.h"
+#include "SkSharedMutex.h"
 #include "SkStream.h"
 #include "SkString.h"
+#include "SkTArray.h"
 #include "SkTDArray.h"
+#include "SkTHash.h"
 #include "SkTemplates.h"
 #include "SkTypeface.h"
 #include "SkTypefaceCache.h"
@@ -658,15 +663,178 @@ class SkFontMgr_fontconfig : public SkFontMgr {
         return face;
     }
 
+    /** The family name, style and languages of a fallback query, and the block of characters
+     *  asked about. Whole fallback chains are kept with a block of -1.
+     */
+    struct FallbackKey {
+        FallbackKey() : fHasFamilyName(false), fBlock(0) {}
+        FallbackKey(const char familyName[], const SkFontStyle& style,
+                    const char* bcp47[], int bcp47Count, SkUnichar block)
+            : fFamilyName(familyName)
+            , fHasFamilyName(familyName != nullptr)
+            , fStyle(style)
+            , fBlock(block)
+        {
+            for (int i = 0; i < bcp47Count; ++i) {
+                fLanguages.append(bcp47[i]);
+                fLanguages.append(",");
+            }
+        }
+
+        bool operator==(const FallbackKey& that) const {
+            return fBlock == that.fBlock &&
+                   fStyle == that.fStyle &&
+                   fHasFamilyName == that.fHasFamilyName &&
+                   fFamilyName.equals(that.fFamilyName) &&
+                   fLanguages.equals(that.fLanguages);
+        }
+
+        struct Hash {
+            uint32_t operator()(const FallbackKey& key) const {
+                uint32_t hash = SkChecksum::Mix(key.fBlock) ^ key.fHasFamilyName;
+                hash = SkOpts::hash_fn(key.fFamilyName.c_str(), key.fFamilyName.size(), hash);
+                hash = SkOpts::hash_fn(key.fLanguages.c_str(), key.fLanguages.size(), hash);
+                return SkOpts::hash_fn(&key.fStyle, sizeof(key.fStyle), hash);
+            }
+        };
+
+        SkString    fFamilyName;
+        bool        fHasFamilyName;
+        SkString    fLanguages;
+        SkFontStyle fStyle;
+        SkUnichar   fBlock;
+    };
+
+    /** Every font, sorted by how well it matches a fallback query without its character, and
+     *  the query the chosen font is prepared against. Fontconfig scores a font having the
+     *  character ahead of everything else the query asks for, so the first font in the chain
+     *  with a character is the one FcFontMatch() would find for it. Only fonts which score the
+     *  same may come in another order than FcFontMatch() would try them.
+     */
+    struct FallbackChain : public SkNVRefCnt<FallbackChain> {
+        /** Takes ownership of the references. The last reference to a chain must be released
+         *  with the FCLocker held.
+         */
+        FallbackChain(FcPattern* pattern, FcFontSet* fonts) : fPattern(pattern), fFonts(fonts) {}
+
+        SkAutoFcPattern fPattern;
+        SkAutoFcFontSet fFonts;
+    };
+
+    /** The fallback font for each character of a block of characters. A block is filled all at
+     *  once from its chain, so that later characters of the block are found without fontconfig.
+     */
+    static constexpr int kFallbackBlockBits = 7;
+    static constexpr int kFallbackBlockSize = 1 << kFallbackBlockBits;
+    struct FallbackBlock {
+        static constexpr uint8_t kNone = 0xFF;
+
+        SkTypeface* refTypeface(int index) const {
+            return kNone == fFont[index] ? nullptr : SkRef(fTypefaces[fFont[index]].get());
+        }
+
+        SkTArray<sk_sp<SkTypeface>> fTypefaces;
+        // The index in fTypefaces of each character's font, or kNone.
+        uint8_t                     fFont[kFallbackBlockSize];
+    };
+    static constexpr int kMaxFallbackBlocks = 1024;
+    // Each chain holds every font, so only the most recently used are kept.
+    static constexpr int kMaxFallbackChains = 8;
+
+    mutable SkMutex fFallbackChainMutex;
+    mutable SkLRUCache<FallbackKey, sk_sp<FallbackChain>, FallbackKey::Hash> fFallbackChains;
+    // Read by every fallback query, written only when fontconfig had to be asked.
+    mutable SkSharedMutex fFallbackBlockMutex;
+    mutable SkTHashMap<FallbackKey, FallbackBlock, FallbackKey::Hash> fFallbackBlocks;
+
+    /** Returns the fallback chain for key, sorting it on first use. */
+    sk_sp<FallbackChain> fallbackChain(const FallbackKey& key, const char familyName[],
+                                       const SkFontStyle& style,
+                                       const char* bcp47[], int bcp47Count) const {
+        FCLocker::AssertHeld();
+        SkAutoMutexAcquire ama(fFallbackChainMutex);
+        if (sk_sp<FallbackChain>* chain = fFallbackChains.find(key)) {
+            return *chain;
+        }
+
+        SkAutoFcPattern pattern;
+        if (familyName) {
+            FcValue familyNameValue;
+            familyNameValue.type = FcTypeString;
+            familyNameValue.u.s = reinterpret_cast<const FcChar8*>(familyName);
+            FcPatternAddWeak(pattern, FC_FAMILY, familyNameValue, FcFalse);
+        }
+        fcpattern_from_skfontstyle(style, pattern);
+
+        if (bcp47Count > 0) {
+            SkASSERT(bcp47);
+            SkAutoFcLangSet langSet;
+            for (int i = bcp47Count; i --> 0;) {
+                FcLangSetAdd(langSet, (const FcChar8*)bcp47[i]);
+            }
+            FcPatternAddLangSet(pattern, FC_LANG, langSet);
+        }
+
+        FcConfigSubstitute(fFC, pattern, FcMatchPattern);
+        FcDefaultSubstitute(pattern);
+
+        FcResult result;
+        FcFontSet* fonts = FcFontSort(fFC, pattern, FcFalse, nullptr, &result);
+        if (nullptr == fonts) {
+            return nullptr;
+        }
+        return *fFallbackChains.insert(key, sk_make_sp<FallbackChain>(pattern.release(), fonts));
+    }
+
+    /** Fills block with the fonts for the characters from first on: the first font in the
+     *  chain with each character, if that font can be read.
+     */
+    void fillFallbackBlock(FallbackChain* chain, SkUnichar first, FallbackBlock* block) const {
+        FCLocker::AssertHeld();
+        memset(block->fFont, FallbackBlock::kNone, sizeof(block->fFont));
+        if (nullptr == chain) {
+            return;
+        }
+
+        bool found[kFallbackBlockSize] = { false };
+        int remaining = kFallbackBlockSize;
+        for (int f = 0; remaining > 0 && f < chain->fFonts->nfont; ++f) {
+            FcPattern* font = chain->fFonts->fonts[f];
+            int fontIndex = -1;
+            for (int i = 0; i < kFallbackBlockSize; ++i) {
+                if (found[i] || !FontContainsCharacter(font, first + i)) {
+                    continue;
+                }
+                found[i] = true;
+                --remaining;
+
+                if (fontIndex < 0) {
+                    fontIndex = FallbackBlock::kNone;
+                    if (FontAccessible(font)) {
+                        SkAutoFcPattern prepared(FcFontRenderPrepare(fFC, chain->fPattern, font));
+                        sk_sp<SkTypeface> typeface(this->createTypefaceFromFcPattern(prepared));
+                        if (typeface) {
+                            fontIndex = block->fTypefaces.count();
+                            block->fTypefaces.push_back(std::move(typeface));
+                        }
+                    }
+                }
+                block->fFont[i] = SkToU8(fontIndex);
+            }
+        }
+    }
+
 public:
     /** Takes control of the reference to 'config'. */
     explicit SkFontMgr_fontconfig(FcConfig* config)
         : fFC(config ? config : FcInitLoadConfigAndFonts())
-        , fFamilyNames(GetFamilyNames(fFC)) { }
+        , fFamilyNames(GetFamilyNames(fFC))
+        , fFallbackChains(kMaxFallbackChains) { }
 
     virtual ~SkFontMgr_fontconfig() {
-        // Hold the lock while unrefing the config.
+        // Hold the lock while unrefing the config and fallback chains.
         FCLocker lock;
+        fFallbackChains.reset();
         fFC.reset();
     }
 
@@ -833,40 +1001,33 @@ protected:
                                                     int bcp47Count,
                                                     SkUnichar character) const override
     {
-        FCLocker lock;
-
-        SkAutoFcPattern pattern;
-        if (familyName) {
-            FcValue familyNameValue;
-            familyNameValue.type = FcTypeString;
-            familyNameValue.u.s = reinterpret_cast<const FcChar8*>(familyName);
-            FcPatternAddWeak(pattern, FC_FAMILY, familyNameValue, FcFalse);
-        }
-        fcpattern_from_skfontstyle(style, pattern);
-
-        SkAutoFcCharSet charSet;
-        FcCharSetAddChar(charSet, character);
-        FcPatternAddCharSet(pattern, FC_CHARSET, charSet);
-
-        if (bcp47Count > 0) {
-            SkASSERT(bcp47);
-            SkAutoFcLangSet langSet;
-            for (int i = bcp47Count; i --> 0;) {
-                FcLangSetAdd(langSet, (const FcChar8*)bcp47[i]);
+        FallbackKey key(familyName, style, bcp47, bcp47Count, character >> kFallbackBlockBits);
+        const int index = character & (kFallbackBlockSize - 1);
+        {
+            SkAutoSharedMutexShared shared(fFallbackBlockMutex);
+            if (const FallbackBlock* block = fFallbackBlocks.find(key)) {
+                return block->refTypeface(index);
             }
-            FcPatternAddLangSet(pattern, FC_LANG, langSet);
         }
 
-        FcConfigSubstitute(fFC, pattern, FcMatchPattern);
-        FcDefaultSubstitute(pattern);
-
-        FcResult result;
-        SkAutoFcPattern font(FcFontMatch(fFC, pattern, &result));
-        if (nullptr == font || !FontAccessible(font) || !FontContainsCharacter(font, character)) {
-            return nullptr;
+        FallbackBlock filled;
+        {
+            FCLocker lock;
+            FallbackKey chainKey(familyName, style, bcp47, bcp47Count, -1);
+            sk_sp<FallbackChain> chain = this->fallbackChain(chainKey, familyName, style,
+                                                             bcp47, bcp47Count);
+            this->fillFallbackBlock(chain.get(), character - index, &filled);
         }
 
-        return createTypefaceFromFcPattern(font);
+        SkAutoExclusive exclusive(fFallbackBlockMutex);
+        const FallbackBlock* block = fFallbackBlocks.find(key);
+        if (nullptr == block) {
+            if (fFallbackBlocks.count() >= kMaxFallbackBlocks) {
+                fFallbackBlocks.reset();
+            }
+            block = fFallbackBlocks.set(key, std::move(filled));
+        }
+        return block->refTypeface(index);
     }
 
     virtual SkTypeface* onMatchFaceStyle(const SkTypeface* typeface,
@@ -30,6 +30,10 @@ bool sk_exists(const char *path, SkFILE_Flags flags) {
     return (0 == access(path, mode));
 }
 
+bool sk_rename(const char from[], const char to[]) {
+    return 0 == rename(from, to);
+}
+
 typedef struct {
     dev_t dev;
     ino_t ino;
@@ -27,6 +27,11 @@ bool sk_exists(const char *path, SkFILE_Flags flags) {
     return (0 == _access(path, mode));
 }
 
+bool sk_rename(const char from[], const char to[]) {
+    // Unlike rename(), this replaces the file at to if there is one.
+    return 0 != MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING);
+}
+
 typedef struct {
     ULONGLONG fVolume;
     ULONGLONG fLsbSize;
@@ -10,9 +10,14 @@
 #include "SkMakeUnique.h"
 
 std::unique_ptr<SkCanvas> SkSVGCanvas::Make(const SkRect& bounds, SkXMLWriter* writer) {
+    return Make(bounds, writer, kFullPrecision, 0);
+}
+
+std::unique_ptr<SkCanvas> SkSVGCanvas::Make(const SkRect& bounds, SkXMLWriter* writer,
+                                            int precision, uint32_t flags) {
     // TODO: pass full bounds to the device
     SkISize size = bounds.roundOut().size();
-    sk_sp<SkBaseDevice> device(SkSVGDevice::Create(size, writer));
+    sk_sp<SkBaseDevice> device(SkSVGDevice::Create(size, writer, precision, flags));
 
     return skstd::make_unique<SkCanvas>(device.get());
 }
@@ -13,11 +13,12 @@
 #include "SkClipStack.h"
 #include "SkData.h"
 #include "SkDraw.h"
+#include "SkGeometry.h"
 #include "SkImageEncoder.h"
 #include "SkPaint.h"
-#include "SkParsePath.h"
 #include "SkShader.h"
 #include "SkStream.h"
+#include "SkSVGCanvas.h"
 #include "SkTHash.h"
 #include "SkTypeface.h"
 #include "SkUtils.h"
@@ -37,6 +38,77 @@ static SkScalar svg_opacity(SkColor color) {
     return SkIntToScalar(SkColorGetA(color)) / SK_AlphaOPAQUE;
 }
 
+// Large enough for any value written by write_svg_scalar().
+static const int kMaxSVGScalarSize = 32;
+
+// Writes value with at most 'precision' digits after the decimal point, dropping trailing zeros
+// (and the decimal point when the value rounds to an integer). Path data for large documents
+// is dominated by this, so avoid printf. A negative precision writes value with %g.
+static char* write_svg_scalar(char buffer[], SkScalar value, int precision) {
+    static const int64_t kPow10[] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+    };
+    SkASSERT(precision < (int)SK_ARRAY_COUNT(kPow10));
+    if (precision < 0) {
+        return SkStrAppendScalar(buffer, value);
+    }
+
+    double scaled = (double)value * kPow10[precision];
+    if (!(SkTAbs(scaled) < 1e15)) {
+        // Huge or non-finite: fall back to %g.
+        return SkStrAppendScalar(buffer, value);
+    }
+
+    int64_t n = (int64_t)(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+    char* p = buffer;
+    if (n < 0) {
+        *p++ = '-';
+        n = -n;
+    }
+    p = SkStrAppendU64(p, (uint64_t)(n / kPow10[precision]), 0);
+
+    int64_t fraction = n % kPow10[precision];
+    if (fraction) {
+        int digits = precision;
+        while (0 == fraction % 10) {
+            fraction /= 10;
+            digits--;
+        }
+        *p++ = '.';
+        for (int i = digits - 1; i >= 0; --i) {
+            p[i] = '0' + (char)(fraction % 10);
+            fraction /= 10;
+        }
+        p += digits;
+    }
+    return p;
+}
+
+static SkString svg_scalar(SkScalar value, int precision) {
+    char buffer[kMaxSVGScalarSize];
+    return SkString(buffer, write_svg_scalar(buffer, value, precision) - buffer);
+}
+
+// Appends an SVG path command followed by its coordinates.  The separator before a coordinate
+// written with a minus sign is implied by the sign.  (Tiny negative values may round to "0".)
+static void append_svg_path_command(SkTDArray<char>* data, char verb, const SkScalar coords[],
+                                    int count, int precision) {
+    int start = data->count();
+    char* p = data->append(1 + count * (kMaxSVGScalarSize + 1));
+    *p++ = verb;
+    for (int i = 0; i < count; ++i) {
+        char buffer[kMaxSVGScalarSize];
+        char* stop = write_svg_scalar(buffer, coords[i], precision);
+        if (i > 0 && '-' != buffer[0]) {
+            *p++ = ' ';
+        }
+        memcpy(p, buffer, stop - buffer);
+        p += stop - buffer;
+    }
+    data->setCount(SkToInt(p - data->begin()));
+    SkASSERT(data->count() > start);
+}
+
 // Keep in sync with SkPaint::Cap
 static const char* cap_map[]  = {
     nullptr,    // kButt_Cap (default)
@@ -245,29 +317,100 @@ private:
 
 }
 
-// For now all this does is serve unique serial IDs, but it will eventually evolve to track
-// and deduplicate resources.
+// Serves unique serial IDs, and remembers definitions (clips, gradients, images and style
+// classes) that have already been written so that later elements can refer to them instead of
+// writing them again.
 class SkSVGDevice::ResourceBucket : ::SkNoncopyable {
 public:
-    ResourceBucket() : fGradientCount(0), fClipCount(0), fPathCount(0), fImageCount(0) {}
+    ResourceBucket(int precision, uint32_t flags)
+        : fPrecision(SkSVGCanvas::kFullPrecision == precision ? precision
+                                                              : SkTPin(precision, 0, 9))
+        , fFlags(flags)
+        , fGradientCount(0)
+        , fClipCount(0)
+        , fPathCount(0)
+        , fImageCount(0) {}
+
+    int precision() const { return fPrecision; }
+    bool useStyleClasses() const { return SkToBool(fFlags & SkSVGCanvas::kStyleClasses_Flag); }
+
+    // Scratch space for path data, reused across elements.
+    SkTDArray<char>* pathData() { return &fPathData; }
+
+    const SkString* findLinearGradient(const SkShader* shader) const {
+        return fGradients.find(shader);
+    }
 
-    SkString addLinearGradient() {
-        return SkStringPrintf("gradient_%d", fGradientCount++);
+    SkString addLinearGradient(const SkShader* shader) {
+        SkString id = SkStringPrintf("gradient_%d", fGradientCount++);
+        // Hold a ref so that the pointer can not be reused by a different shader.
+        fGradientShaders.push_back(sk_ref_sp(shader));
+        fGradients.set(shader, id);
+        return id;
     }
 
-    SkString addClip() {
-        return SkStringPrintf("clip_%d", fClipCount++);
+    // Clip stack gen IDs identify the whole stack, not just its topmost element.
+    const SkString* findClip(int32_t clipGenID) const {
+        return fClips.find(clipGenID);
+    }
+
+    SkString addClip(int32_t clipGenID) {
+        SkString id = SkStringPrintf("clip_%d", fClipCount++);
+        fClips.set(clipGenID, id);
+        return id;
     }
 
     SkString addPath() {
         return SkStringPrintf("path_%d", fPathCount++);
     }
 
-    SkString addImage() {
-        return SkStringPrintf("img_%d", fImageCount++);
+    const SkString* findImage(const SkBitmap& bitmap) const {
+        return fImages.find(ImageKey(bitmap));
+    }
+
+    SkString addImage(const SkBitmap& bitmap) {
+        SkString id = SkStringPrintf("img_%d", fImageCount++);
+        fImages.set(ImageKey(bitmap), id);
+        return id;
+    }
+
+    // Returns the class name for the given CSS declarations; *isNew is set if the class has
+    // not been written yet.
+    SkString addStyleClass(const SkString& declarations, bool* isNew) {
+        if (const SkString* name = fStyleClasses.find(declarations)) {
+            *isNew = false;
+            return *name;
+        }
+        SkString name = SkStringPrintf("s%d", fStyleClasses.count());
+        fStyleClasses.set(declarations, name);
+        *isNew = true;
+        return name;
     }
 
 private:
+    struct ImageKey {
+        ImageKey() : fGenID(0), fSubset(SkIRect::MakeEmpty()) {}
+        explicit ImageKey(const SkBitmap& bitmap)
+            : fGenID(bitmap.getGenerationID())
+            , fSubset(SkIRect::MakeXYWH(bitmap.pixelRefOrigin().x(), bitmap.pixelRefOrigin().y(),
+                                        bitmap.width(), bitmap.height())) {}
+        bool operator==(const ImageKey& other) const {
+            return fGenID == other.fGenID && fSubset == other.fSubset;
+        }
+        uint32_t fGenID;
+        SkIRect  fSubset;
+    };
+
+    const int      fPrecision;
+    const uint32_t fFlags;
+    SkTDArray<char> fPathData;
+
+    SkTHashMap<const SkShader*, SkString> fGradients;
+    SkTArray<sk_sp<const SkShader>>       fGradientShaders;
+    SkTHashMap<int32_t, SkString>         fClips;
+    SkTHashMap<ImageKey, SkString>        fImages;
+    SkTHashMap<SkString, SkString>        fStyleClasses;
+
     uint32_t fGradientCount;
     uint32_t fClipCount;
     uint32_t fPathCount;
@@ -276,9 +419,10 @@ private:
 
 class SkSVGDevice::AutoElement : ::SkNoncopyable {
 public:
-    AutoElement(const char name[], SkXMLWriter* writer)
+    AutoElement(const char name[], SkXMLWriter* writer, ResourceBucket* bucket)
         : fWriter(writer)
-        , fResourceBucket(nullptr) {
+        , fResourceBucket(bucket) {
+        SkASSERT(fResourceBucket);
         fWriter->startElement(name);
     }
 
@@ -286,18 +430,44 @@ public:
                 const SkDraw& draw, const SkPaint& paint)
         : fWriter(writer)
         , fResourceBucket(bucket) {
+        SkASSERT(fResourceBucket);
 
         Resources res = this->addResources(draw, paint);
         if (!res.fClip.isEmpty()) {
             // The clip is in device space. Apply it via a <g> wrapper to avoid local transform
             // interference.
-            fClipGroup.reset(new AutoElement("g", fWriter));
+            fClipGroup.reset(new AutoElement("g", fWriter, fResourceBucket));
             fClipGroup->addAttribute("clip-path",res.fClip);
         }
 
+        SkSTArray<8, Attribute> paintAttributes;
+        this->collectPaintAttributes(paint, res, &paintAttributes);
+
+        SkString styleClass;
+        if (fResourceBucket->useStyleClasses()) {
+            SkString declarations;
+            for (const Attribute& attribute : paintAttributes) {
+                declarations.appendf("%s:%s;", attribute.fName, attribute.fValue.c_str());
+            }
+            bool isNew;
+            styleClass = fResourceBucket->addStyleClass(declarations, &isNew);
+            if (isNew) {
+                AutoElement style("style", fWriter, fResourceBucket);
+                SkString rule = SkStringPrintf(".%s{%s}", styleClass.c_str(),
+                                               declarations.c_str());
+                style.addText(rule);
+            }
+        }
+
         fWriter->startElement(name);
 
-        this->addPaint(paint, res);
+        if (fResourceBucket->useStyleClasses()) {
+            this->addAttribute("class", styleClass);
+        } else {
+            for (const Attribute& attribute : paintAttributes) {
+                this->addAttribute(attribute.fName, attribute.fValue);
+            }
+        }
 
         if (!draw.fMatrix->isIdentity()) {
             this->addAttribute("transform", svg_transform(*draw.fMatrix));
@@ -313,7 +483,7 @@ public:
     }
 
     void addAttribute(const char name[], const SkString& val) {
-        fWriter->addAttribute(name, val.c_str());
+        fWriter->addAttributeLen(name, val.c_str(), val.size());
     }
 
     void addAttribute(const char name[], int32_t val) {
@@ -321,7 +491,9 @@ public:
     }
 
     void addAttribute(const char name[], SkScalar val) {
-        fWriter->addScalarAttribute(name, val);
+        char buffer[kMaxSVGScalarSize];
+        char* stop = write_svg_scalar(buffer, val, fResourceBucket->precision());
+        fWriter->addAttributeLen(name, buffer, stop - buffer);
     }
 
     void addText(const SkString& text) {
@@ -333,11 +505,19 @@ public:
     void addTextAttributes(const SkPaint&);
 
 private:
+    struct Attribute {
+        Attribute(const char name[], const char value[]) : fName(name), fValue(value) {}
+        Attribute(const char name[], SkString value) : fName(name), fValue(std::move(value)) {}
+        const char* fName;
+        SkString    fValue;
+    };
+
     Resources addResources(const SkDraw& draw, const SkPaint& paint);
     void addClipResources(const SkDraw& draw, Resources* resources);
     void addShaderResources(const SkPaint& paint, Resources* resources);
 
-    void addPaint(const SkPaint& paint, const Resources& resources);
+    void collectPaintAttributes(const SkPaint& paint, const Resources& resources,
+                                SkTArray<Attribute>* attributes) const;
 
     SkString addLinearGradientDef(const SkShader::GradientInfo& info, const SkShader* shader);
 
@@ -346,70 +526,96 @@ private:
     std::unique_ptr<AutoElement> fClipGroup;
 };
 
-void SkSVGDevice::AutoElement::addPaint(const SkPaint& paint, const Resources& resources) {
+void SkSVGDevice::AutoElement::collectPaintAttributes(const SkPaint& paint,
+                                                      const Resources& resources,
+                                                      SkTArray<Attribute>* attributes) const {
+    const int precision = fResourceBucket->precision();
     SkPaint::Style style = paint.getStyle();
     if (style == SkPaint::kFill_Style || style == SkPaint::kStrokeAndFill_Style) {
-        this->addAttribute("fill", resources.fPaintServer);
+        attributes->emplace_back("fill", resources.fPaintServer);
 
         if (SK_AlphaOPAQUE != SkColorGetA(paint.getColor())) {
-            this->addAttribute("fill-opacity", svg_opacity(paint.getColor()));
+            attributes->emplace_back("fill-opacity",
+                                     svg_scalar(svg_opacity(paint.getColor()), precision));
         }
     } else {
         SkASSERT(style == SkPaint::kStroke_Style);
-        this->addAttribute("fill", "none");
+        attributes->emplace_back("fill", "none");
     }
 
     if (style == SkPaint::kStroke_Style || style == SkPaint::kStrokeAndFill_Style) {
-        this->addAttribute("stroke", resources.fPaintServer);
+        attributes->emplace_back("stroke", resources.fPaintServer);
 
         SkScalar strokeWidth = paint.getStrokeWidth();
         if (strokeWidth == 0) {
             // Hairline stroke
             strokeWidth = 1;
-            this->addAttribute("vector-effect", "non-scaling-stroke");
+            attributes->emplace_back("vector-effect", "non-scaling-stroke");
         }
-        this->addAttribute("stroke-width", strokeWidth);
+        attributes->emplace_back("stroke-width", svg_scalar(strokeWidth, precision));
 
         if (const char* cap = svg_cap(paint.getStrokeCap())) {
-            this->addAttribute("stroke-linecap", cap);
+            attributes->emplace_back("stroke-linecap", cap);
         }
 
         if (const char* join = svg_join(paint.getStrokeJoin())) {
-            this->addAttribute("stroke-linejoin", join);
+            attributes->emplace_back("stroke-linejoin", join);
         }
 
         if (paint.getStrokeJoin() == SkPaint::kMiter_Join) {
-            this->addAttribute("stroke-miterlimit", paint.getStrokeMiter());
+            attributes->emplace_back("stroke-miterlimit",
+                                     svg_scalar(paint.getStrokeMiter(), precision));
         }
 
         if (SK_AlphaOPAQUE != SkColorGetA(paint.getColor())) {
-            this->addAttribute("stroke-opacity", svg_opacity(paint.getColor()));
+            attributes->emplace_back("stroke-opacity",
+                                     svg_scalar(svg_opacity(paint.getColor()), precision));
         }
     } else {
         SkASSERT(style == SkPaint::kFill_Style);
-        this->addAttribute("stroke", "none");
+        attributes->emplace_back("stroke", "none");
     }
 }
 
 Resources SkSVGDevice::AutoElement::addResources(const SkDraw& draw, const SkPaint& paint) {
     Resources resources(paint);
 
-    // FIXME: this is a weak heuristic and we end up with LOTS of redundant clips.
-    bool hasClip   = !draw.fClipStack->isWideOpen();
-    bool hasShader = SkToBool(paint.getShader());
+    // Clips and gradients are written to <defs> the first time they are used, and referred to
+    // by ID after that.
+    const SkString* clipID = nullptr;
+    bool needsClip = false;
+    if (!draw.fClipStack->isWideOpen()) {
+        clipID = fResourceBucket->findClip(draw.fClipStack->getTopmostGenID());
+        needsClip = !clipID;
+    }
+
+    const SkShader* shader = paint.getShader();
+    const SkString* gradientID = nullptr;
+    bool needsShader = false;
+    if (shader) {
+        gradientID = fResourceBucket->findLinearGradient(shader);
+        needsShader = !gradientID;
+    }
 
-    if (hasClip || hasShader) {
-        AutoElement defs("defs", fWriter);
+    if (needsClip || needsShader) {
+        AutoElement defs("defs", fWriter, fResourceBucket);
 
-        if (hasClip) {
+        if (needsClip) {
             this->addClipResources(draw, &resources);
         }
 
-        if (hasShader) {
+        if (needsShader) {
             this->addShaderResources(paint, &resources);
         }
     }
 
+    if (clipID) {
+        resources.fClip.printf("url(#%s)", clipID->c_str());
+    }
+    if (gradientID) {
+        resources.fPaintServer.printf("url(#%s)", gradientID->c_str());
+    }
+
     return resources;
 }
 
@@ -444,22 +650,22 @@ void SkSVGDevice::AutoElement::addClipResources(const SkDraw& draw, Resources* r
     SkPath clipPath;
     (void) draw.fClipStack->asPath(&clipPath);
 
-    SkString clipID = fResourceBucket->addClip();
+    SkString clipID = fResourceBucket->addClip(draw.fClipStack->getTopmostGenID());
     const char* clipRule = clipPath.getFillType() == SkPath::kEvenOdd_FillType ?
                            "evenodd" : "nonzero";
     {
         // clipPath is in device space, but since we're only pushing transform attributes
         // to the leaf nodes, so are all our elements => SVG userSpaceOnUse == device space.
-        AutoElement clipPathElement("clipPath", fWriter);
+        AutoElement clipPathElement("clipPath", fWriter, fResourceBucket);
         clipPathElement.addAttribute("id", clipID);
 
         SkRect clipRect = SkRect::MakeEmpty();
         if (clipPath.isEmpty() || clipPath.isRect(&clipRect)) {
-            AutoElement rectElement("rect", fWriter);
+            AutoElement rectElement("rect", fWriter, fResourceBucket);
             rectElement.addRectAttributes(clipRect);
             rectElement.addAttribute("clip-rule", clipRule);
         } else {
-            AutoElement pathElement("path", fWriter);
+            AutoElement pathElement("path", fWriter, fResourceBucket);
             pathElement.addPathAttributes(clipPath);
             pathElement.addAttribute("clip-rule", clipRule);
         }
@@ -471,10 +677,10 @@ void SkSVGDevice::AutoElement::addClipResources(const SkDraw& draw, Resources* r
 SkString SkSVGDevice::AutoElement::addLinearGradientDef(const SkShader::GradientInfo& info,
                                                         const SkShader* shader) {
     SkASSERT(fResourceBucket);
-    SkString id = fResourceBucket->addLinearGradient();
+    SkString id = fResourceBucket->addLinearGradient(shader);
 
     {
-        AutoElement gradient("linearGradient", fWriter);
+        AutoElement gradient("linearGradient", fWriter, fResourceBucket);
 
         gradient.addAttribute("id", id);
         gradient.addAttribute("gradientUnits", "userSpaceOnUse");
@@ -493,7 +699,7 @@ SkString SkSVGDevice::AutoElement::addLinearGradientDef(const SkShader::Gradient
             SkString colorStr(svg_color(color));
 
             {
-                AutoElement stop("stop", fWriter);
+                AutoElement stop("stop", fWriter, fResourceBucket);
                 stop.addAttribute("offset", info.fColorOffsets[i]);
                 stop.addAttribute("stop-color", colorStr.c_str());
 
@@ -521,9 +727,42 @@ void SkSVGDevice::AutoElement::addRectAttributes(const SkRect& rect) {
 }
 
 void SkSVGDevice::AutoElement::addPathAttributes(const SkPath& path) {
-    SkString pathData;
-    SkParsePath::ToSVGString(path, &pathData);
-    this->addAttribute("d", pathData);
+    const int precision = fResourceBucket->precision();
+    SkTDArray<char>* data = fResourceBucket->pathData();
+    data->rewind();
+
+    SkPath::Iter iter(path, false);
+    SkPoint pts[4];
+    for (;;) {
+        switch (iter.next(pts, false)) {
+            case SkPath::kMove_Verb:
+                append_svg_path_command(data, 'M', &pts[0].fX, 2, precision);
+                break;
+            case SkPath::kLine_Verb:
+                append_svg_path_command(data, 'L', &pts[1].fX, 2, precision);
+                break;
+            case SkPath::kQuad_Verb:
+                append_svg_path_command(data, 'Q', &pts[1].fX, 4, precision);
+                break;
+            case SkPath::kConic_Verb: {
+                const SkScalar tol = SK_Scalar1 / 1024; // how close to a quad
+                SkAutoConicToQuads quadder;
+                const SkPoint* quadPts = quadder.computeQuads(pts, iter.conicWeight(), tol);
+                for (int i = 0; i < quadder.countQuads(); ++i) {
+                    append_svg_path_command(data, 'Q', &quadPts[i*2 + 1].fX, 4, precision);
+                }
+            } break;
+            case SkPath::kCubic_Verb:
+                append_svg_path_command(data, 'C', &pts[1].fX, 6, precision);
+                break;
+            case SkPath::kClose_Verb:
+                *data->append() = 'Z';
+                break;
+            case SkPath::kDone_Verb:
+                fWriter->addAttributeLen("d", data->begin(), data->count());
+                return;
+        }
+    }
 }
 
 void SkSVGDevice::AutoElement::addTextAttributes(const SkPaint& paint) {
@@ -562,26 +801,28 @@ void SkSVGDevice::AutoElement::addTextAttributes(const SkPaint& paint) {
     }
 }
 
-SkBaseDevice* SkSVGDevice::Create(const SkISize& size, SkXMLWriter* writer) {
+SkBaseDevice* SkSVGDevice::Create(const SkISize& size, SkXMLWriter* writer, int precision,
+                                  uint32_t flags) {
     if (!writer) {
         return nullptr;
     }
 
-    return new SkSVGDevice(size, writer);
+    return new SkSVGDevice(size, writer, precision, flags);
 }
 
-SkSVGDevice::SkSVGDevice(const SkISize& size, SkXMLWriter* writer)
+SkSVGDevice::SkSVGDevice(const SkISize& size, SkXMLWriter* writer, int precision,
+                         uint32_t flags)
     : INHERITED(SkImageInfo::MakeUnknown(size.fWidth, size.fHeight),
                 SkSurfaceProps(0, kUnknown_SkPixelGeometry))
     , fWriter(writer)
-    , fResourceBucket(new ResourceBucket)
+    , fResourceBucket(new ResourceBucket(precision, flags))
 {
     SkASSERT(writer);
 
     fWriter->writeHeader();
 
     // The root <svg> tag gets closed by the destructor.
-    fRootElement.reset(new AutoElement("svg", fWriter));
+    fRootElement.reset(new AutoElement("svg", fWriter, fResourceBucket.get()));
 
     fRootElement->addAttribute("xmlns", "http://www.w3.org/2000/svg");
     fRootElement->addAttribute("xmlns:xlink", "http://www.w3.org/1999/xlink");
@@ -667,27 +908,33 @@ static sk_sp<SkData> encode(const SkBitmap& src) {
 
 void SkSVGDevice::drawBitmapCommon(const SkDraw& draw, const SkBitmap& bm,
                                    const SkPaint& paint) {
-    sk_sp<SkData> pngData = encode(bm);
-    if (!pngData) {
-        return;
-    }
+    // Each bitmap is encoded once, and <use>d as many times as it is drawn.
+    SkString imageID;
+    if (const SkString* id = fResourceBucket->findImage(bm)) {
+        imageID = *id;
+    } else {
+        sk_sp<SkData> pngData = encode(bm);
+        if (!pngData) {
+            return;
+        }
 
-    size_t b64Size = SkBase64::Encode(pngData->data(), pngData->size(), nullptr);
-    SkAutoTMalloc<char> b64Data(b64Size);
-    SkBase64::Encode(pngData->data(), pngData->size(), b64Data.get());
+        size_t b64Size = SkBase64::Encode(pngData->data(), pngData->size(), nullptr);
+        SkAutoTMalloc<char> b64Data(b64Size);
+        SkBase64::Encode(pngData->data(), pngData->size(), b64Data.get());
 
-    SkString svgImageData("data:image/png;base64,");
-    svgImageData.append(b64Data.get(), b64Size);
+        SkString svgImageData("data:image/png;base64,");
+        svgImageData.append(b64Data.get(), b64Size);
 
-    SkString imageID = fResourceBucket->addImage();
-    {
-        AutoElement defs("defs", fWriter);
+        imageID = fResourceBucket->addImage(bm);
         {
-            AutoElement image("image", fWriter);
-            image.addAttribute("id", imageID);
-            image.addAttribute("width", bm.width());
-            image.addAttribute("height", bm.height());
-            image.addAttribute("xlink:href", svgImageData);
+            AutoElement defs("defs", fWriter, fResourceBucket.get());
+            {
+                AutoElement image("image", fWriter, fResourceBucket.get());
+                image.addAttribute("id", imageID);
+                image.addAttribute("width", bm.width());
+                image.addAttribute("height", bm.height());
+                image.addAttribute("xlink:href", svgImageData);
+            }
         }
     }
 
@@ -770,15 +1017,15 @@ void SkSVGDevice::drawTextOnPath(const SkDraw&, const void* text, size_t len, co
     SkString pathID = fResourceBucket->addPath();
 
     {
-        AutoElement defs("defs", fWriter);
-        AutoElement pathElement("path", fWriter);
+        AutoElement defs("defs", fWriter, fResourceBucket.get());
+        AutoElement pathElement("path", fWriter, fResourceBucket.get());
         pathElement.addAttribute("id", pathID);
         pathElement.addPathAttributes(path);
 
     }
 
     {
-        AutoElement textElement("text", fWriter);
+        AutoElement textElement("text", fWriter, fResourceBucket.get());
         textElement.addTextAttributes(paint);
 
         if (matrix && !matrix->isIdentity()) {
@@ -786,7 +1033,7 @@ void SkSVGDevice::drawTextOnPath(const SkDraw&, const void* text, size_t len, co
         }
 
         {
-            AutoElement textPathElement("textPath", fWriter);
+            AutoElement textPathElement("textPath", fWriter, fResourceBucket.get());
             textPathElement.addAttribute("xlink:href", SkStringPrintf("#%s", pathID.c_str()));
 
             if (paint.getTextAlign() != SkPaint::kLeft_Align) {
@@ -15,7 +15,9 @@ class SkXMLWriter;
 
 class SkSVGDevice : public SkBaseDevice {
 public:
-    static SkBaseDevice* Create(const SkISize& size, SkXMLWriter* writer);
+    // See SkSVGCanvas::Make() for precision and flags.
+    static SkBaseDevice* Create(const SkISize& size, SkXMLWriter* writer, int precision,
+                                uint32_t flags);
 
 protected:
     void drawPaint(const SkDraw&, const SkPaint& paint) override;
@@ -55,7 +57,7 @@ protected:
                     const SkPaint&) override;
 
 private:
-    SkSVGDevice(const SkISize& size, SkXMLWriter* writer);
+    SkSVGDevice(const SkISize& size, SkXMLWriter* writer, int precision, uint32_t flags);
     virtual ~SkSVGDevice();
 
     void drawBitmapCommon(const SkDraw& draw, const SkBitmap& bm, const SkPaint& paint);
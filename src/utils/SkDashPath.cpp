@@ -214,34 +214,13 @@ private:
 };
 
 
-bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec,
-                                const SkRect* cullRect, const SkScalar aIntervals[],
-                                int32_t count, SkScalar initialDashLength, int32_t initialDashIndex,
-                                SkScalar intervalLength,
-                                StrokeRecApplication strokeRecApplication) {
-
-    // we do nothing if the src wants to be filled
-    SkStrokeRec::Style style = rec->getStyle();
-    if (SkStrokeRec::kFill_Style == style || SkStrokeRec::kStrokeAndFill_Style == style) {
-        return false;
-    }
-
-    const SkScalar* intervals = aIntervals;
-    SkScalar        dashCount = 0;
-    int             segCount = 0;
-
-    SkPath cullPathStorage;
-    const SkPath* srcPtr = &src;
-    if (cull_path(src, *rec, cullRect, intervalLength, &cullPathStorage)) {
-        srcPtr = &cullPathStorage;
-    }
-
-    SpecialLineRec lineRec;
-    bool specialLine = (StrokeRecApplication::kAllow == strokeRecApplication) &&
-                       lineRec.init(*srcPtr, dst, rec, count >> 1, intervalLength);
-
-    SkPathMeasure   meas(*srcPtr, false, rec->getResScale());
-
+// Calls addSegment(startD, stopD, startWithMoveTo) for every dash of every contour of meas'
+// path, in order. Returns false (part way through) if the path would produce too many dashes.
+template <typename AddSegmentProc>
+static bool walk_dashes(SkPathMeasure& meas, const SkScalar intervals[], int32_t count,
+                        SkScalar initialDashLength, int32_t initialDashIndex,
+                        SkScalar intervalLength, int* segCount, AddSegmentProc addSegment) {
+    SkScalar dashCount = 0;
     do {
         bool        skipFirstSegment = meas.isClosed();
         bool        addedSegment = false;
@@ -257,8 +236,7 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
         // segments seems reasonable: at 2 verbs per segment * 9 bytes per verb, this caps the
         // maximum dash memory overhead at roughly 17MB per path.
         dashCount += length * (count >> 1) / intervalLength;
-        if (dashCount > kMaxDashCount) {
-            dst->reset();
+        if (dashCount > SkDashPath::kMaxDashCount) {
             return false;
         }
 
@@ -272,17 +250,9 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
             addedSegment = false;
             if (is_even(index) && !skipFirstSegment) {
                 addedSegment = true;
-                ++segCount;
-
-                if (specialLine) {
-                    lineRec.addSegment(SkDoubleToScalar(distance),
-                                       SkDoubleToScalar(distance + dlen),
-                                       dst);
-                } else {
-                    meas.getSegment(SkDoubleToScalar(distance),
-                                    SkDoubleToScalar(distance + dlen),
-                                    dst, true);
-                }
+                ++*segCount;
+
+                addSegment(SkDoubleToScalar(distance), SkDoubleToScalar(distance + dlen), true);
             }
             distance += dlen;
 
@@ -303,10 +273,51 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
         // extend if we ended on a segment and we need to join up with the (skipped) initial segment
         if (meas.isClosed() && is_even(initialDashIndex) &&
             initialDashLength >= 0) {
-            meas.getSegment(0, initialDashLength, dst, !addedSegment);
-            ++segCount;
+            addSegment(0, initialDashLength, !addedSegment);
+            ++*segCount;
         }
     } while (meas.nextContour());
+    return true;
+}
+
+bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec,
+                                const SkRect* cullRect, const SkScalar aIntervals[],
+                                int32_t count, SkScalar initialDashLength, int32_t initialDashIndex,
+                                SkScalar intervalLength,
+                                StrokeRecApplication strokeRecApplication) {
+
+    // we do nothing if the src wants to be filled
+    SkStrokeRec::Style style = rec->getStyle();
+    if (SkStrokeRec::kFill_Style == style || SkStrokeRec::kStrokeAndFill_Style == style) {
+        return false;
+    }
+
+    int segCount = 0;
+
+    SkPath cullPathStorage;
+    const SkPath* srcPtr = &src;
+    if (cull_path(src, *rec, cullRect, intervalLength, &cullPathStorage)) {
+        srcPtr = &cullPathStorage;
+    }
+
+    SpecialLineRec lineRec;
+    bool specialLine = (StrokeRecApplication::kAllow == strokeRecApplication) &&
+                       lineRec.init(*srcPtr, dst, rec, count >> 1, intervalLength);
+
+    SkPathMeasure   meas(*srcPtr, false, rec->getResScale());
+
+    // A special line is never closed, so it never needs a segment that continues a dash.
+    if (!walk_dashes(meas, aIntervals, count, initialDashLength, initialDashIndex, intervalLength,
+                     &segCount, [&](SkScalar startD, SkScalar stopD, bool startWithMoveTo) {
+                         if (specialLine) {
+                             lineRec.addSegment(startD, stopD, dst);
+                         } else {
+                             meas.getSegment(startD, stopD, dst, startWithMoveTo);
+                         }
+                     })) {
+        dst->reset();
+        return false;
+    }
 
     if (segCount > 1) {
         dst->setConvexity(SkPath::kConcave_Convexity);
@@ -315,6 +326,103 @@ bool SkDashPath::InternalFilter(SkPath* dst, const SkPath& src, SkStrokeRec* rec
     return true;
 }
 
+// An upper bound on the length of every contour SkPathMeasure will find: the length of each
+// control polygon, closing segments included.
+static SkScalar control_polygon_length(const SkPath& path) {
+    SkPath::RawIter iter(path);
+    SkPoint pts[4];
+    SkPoint moveTo = { 0, 0 },
+            lastPt = { 0, 0 };
+    SkScalar length = 0;
+    for (;;) {
+        SkPath::Verb verb = iter.next(pts);
+        int ptCount = 0;
+        switch (verb) {
+            case SkPath::kMove_Verb:
+                moveTo = lastPt = pts[0];
+                break;
+            case SkPath::kLine_Verb:
+                ptCount = 2;
+                break;
+            case SkPath::kQuad_Verb:
+            case SkPath::kConic_Verb:
+                ptCount = 3;
+                break;
+            case SkPath::kCubic_Verb:
+                ptCount = 4;
+                break;
+            case SkPath::kClose_Verb:
+                length += SkPoint::Distance(lastPt, moveTo);
+                lastPt = moveTo;
+                break;
+            case SkPath::kDone_Verb:
+                return length;
+        }
+        for (int i = 1; i < ptCount; ++i) {
+            length += SkPoint::Distance(pts[i - 1], pts[i]);
+        }
+        if (ptCount) {
+            lastPt = pts[ptCount - 1];
+        }
+    }
+}
+
+bool SkDashPath::VisitHairlineDashes(const SkPath& src, const SkStrokeRec& rec,
+                                     const SkRect* cullRect, const SkPathEffect::DashInfo& info,
+                                     DashVisitor visitor, void* ctx) {
+    SkASSERT(rec.isHairlineStyle());
+    if (!ValidDashPath(info.fPhase, info.fIntervals, info.fCount)) {
+        return false;
+    }
+    SkScalar initialDashLength = 0;
+    int32_t initialDashIndex = 0;
+    SkScalar intervalLength = 0;
+    CalcDashParameters(info.fPhase, info.fIntervals, info.fCount,
+                       &initialDashLength, &initialDashIndex, &intervalLength);
+
+    SkPath cullPathStorage;
+    const SkPath* srcPtr = &src;
+    if (cull_path(src, rec, cullRect, intervalLength, &cullPathStorage)) {
+        srcPtr = &cullPathStorage;
+    }
+
+    // InternalFilter() gives up on paths with too many dashes after it has started producing
+    // them. We can't take back dashes we've already visited, so leave anything that might be
+    // too long to InternalFilter().
+    SkScalar maxLength = control_polygon_length(*srcPtr);
+    if (!SkScalarIsFinite(maxLength) ||
+        maxLength * (info.fCount >> 1) / intervalLength > kMaxDashCount) {
+        return false;
+    }
+
+    // Scan converting a path has some fixed cost, so hand the visitor a few dashes at a time.
+    static const int kDashesPerBatch = 64;
+
+    SkPathMeasure meas(*srcPtr, false, rec.getResScale());
+    SkPath dashes;
+    int segCount = 0;
+    int batchCount = 0;
+    SkAssertResult(walk_dashes(meas, info.fIntervals, info.fCount, initialDashLength,
+                               initialDashIndex, intervalLength, &segCount,
+                               [&](SkScalar startD, SkScalar stopD, bool startWithMoveTo) {
+                                   // A dash that continues the previous one (the one wrapping
+                                   // around a closed contour) must stay in the same contour, or
+                                   // capped hairlines get a cap where the two meet. So only
+                                   // hand off a batch where a new dash starts.
+                                   if (startWithMoveTo && batchCount >= kDashesPerBatch) {
+                                       visitor(&dashes, ctx);
+                                       dashes.rewind();
+                                       batchCount = 0;
+                                   }
+                                   meas.getSegment(startD, stopD, &dashes, startWithMoveTo);
+                                   ++batchCount;
+                               }));
+    if (batchCount) {
+        visitor(&dashes, ctx);
+    }
+    return true;
+}
+
 bool SkDashPath::FilterDashPath(SkPath* dst, const SkPath& src, SkStrokeRec* rec,
                                 const SkRect* cullRect, const SkPathEffect::DashInfo& info) {
     if (!ValidDashPath(info.fPhase, info.fIntervals, info.fCount)) {
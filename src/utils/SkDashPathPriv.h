@@ -47,6 +47,18 @@ namespace SkDashPath {
                         StrokeRecApplication = StrokeRecApplication::kAllow);
 
     bool ValidDashPath(SkScalar phase, const SkScalar intervals[], int32_t count);
+
+    /** Called with a path holding the next few dashes. The visitor may modify it. */
+    typedef void (*DashVisitor)(SkPath* dashes, void* ctx);
+
+    /**
+     * Streaming alternative to FilterDashPath() for hairlines: dashes are built into the same
+     * small scratch path and handed to visitor a batch at a time, so no path holding every dash
+     * is ever built. Returns false, having visited nothing, if the dash is invalid or the path
+     * might produce too many dashes; the caller should then fall back to FilterDashPath().
+     */
+    bool VisitHairlineDashes(const SkPath& src, const SkStrokeRec&, const SkRect* cullRect,
+                             const SkPathEffect::DashInfo& info, DashVisitor visitor, void* ctx);
 }
 
 #endif
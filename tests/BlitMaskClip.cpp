@@ -5,8 +5,14 @@
  * found in the LICENSE file.
  */
 
+#include "Sk4px.h"
+#include "SkBitmap.h"
+#include "SkBlitMask.h"
 #include "SkBlitter.h"
+#include "SkColorPriv.h"
 #include "SkMask.h"
+#include "SkOpts.h"
+#include "SkRandom.h"
 #include "Test.h"
 #include <string.h>
 
@@ -68,3 +74,142 @@ DEF_TEST(BlitAndClip, reporter) {
         delete [] bits;
     }
 }
+
+static const SkColor gMaskColors[] = {
+    SK_ColorBLACK, SK_ColorWHITE, 0xFFFF0000, 0x88FF0000, 0x0100FF00,
+};
+
+// SkOpts::blit_mask_d32_a8() must match the portable Sk4px math exactly, however many pixels
+// it works on at a time. (NEON has its own math.)
+#if !defined(SK_ARM_HAS_NEON)
+static void blit_mask_d32_a8_reference(SkPMColor* dst, const SkAlpha* mask, SkColor color, int w) {
+    auto s = Sk4px::DupPMColor(SkPreMultiplyColor(color));
+    if (SK_ColorBLACK == color) {
+        Sk4px::MapDstAlpha(w, dst, mask, [](const Sk4px& d, const Sk4px& aa) {
+            return aa.zeroColors() + d.approxMulDiv255(aa.inv());
+        });
+    } else if (0xFF == SkColorGetA(color)) {
+        Sk4px::MapDstAlpha(w, dst, mask, [&](const Sk4px& d, const Sk4px& aa) {
+            return s.approxMulDiv255(aa) + d.approxMulDiv255(aa.inv());
+        });
+    } else {
+        Sk4px::MapDstAlpha(w, dst, mask, [&](const Sk4px& d, const Sk4px& aa) {
+            auto left = s.approxMulDiv255(aa);
+            return left + d.approxMulDiv255(left.alphas().inv());
+        });
+    }
+}
+
+DEF_TEST(BlitMask_D32_A8, reporter) {
+    const int kMaxW = 37;
+    SkRandom rand;
+    SkAlpha mask[kMaxW];
+    SkPMColor dst[kMaxW], expected[kMaxW];
+    for (SkColor color : gMaskColors) {
+        for (int w = 1; w <= kMaxW; ++w) {
+            for (int x = 0; x < w; ++x) {
+                mask[x] = rand.nextU() & 0xFF;
+                // Favor the edges, where rounding goes wrong.
+                if (x % 3 == 0) {
+                    mask[x] = (x % 2) ? 0xFF : 0;
+                }
+                dst[x] = expected[x] = SkPreMultiplyColor(rand.nextU());
+            }
+            SkOpts::blit_mask_d32_a8(dst, sizeof(dst), mask, sizeof(mask), color, w, 1);
+            blit_mask_d32_a8_reference(expected, mask, color, w);
+            REPORTER_ASSERT(reporter, 0 == memcmp(dst, expected, w * sizeof(SkPMColor)));
+        }
+    }
+}
+#endif
+
+// The LCD16 row procs must match the portable ones.
+DEF_TEST(BlitMask_D32_LCD16, reporter) {
+    const int kMaxW = 37;
+    SkRandom rand;
+    uint16_t mask[kMaxW];
+    SkPMColor dst[kMaxW], expected[kMaxW];
+    for (SkColor color : gMaskColors) {
+        const bool isOpaque = 0xFF == SkColorGetA(color);
+        const SkPMColor opaqueDst = isOpaque ? SkPreMultiplyColor(color) : 0;
+        SkBlitMask::BlitLCD16RowProc proc = SkBlitMask::BlitLCD16RowFactory(isOpaque);
+        for (int w = 1; w <= kMaxW; ++w) {
+            for (int x = 0; x < w; ++x) {
+                mask[x] = rand.nextU() & 0xFFFF;
+                if (x % 3 == 0) {
+                    mask[x] = (x % 2) ? 0xFFFF : 0;
+                }
+                // LCD text is only drawn onto opaque pixels.
+                dst[x] = expected[x] = rand.nextU() | (SK_A32_MASK << SK_A32_SHIFT);
+            }
+            proc(dst, mask, color, w, opaqueDst);
+            if (isOpaque) {
+                SkBlitLCD16OpaqueRow(expected, mask, color, w, opaqueDst);
+            } else {
+                SkBlitLCD16Row(expected, mask, color, w, opaqueDst);
+            }
+            REPORTER_ASSERT(reporter, 0 == memcmp(dst, expected, w * sizeof(SkPMColor)));
+        }
+    }
+}
+
+// SkBlitter::blitMasks() must draw the same as blitMask() on each of its masks in turn.
+DEF_TEST(BlitMask_blitMasks, reporter) {
+    const int kW = 40, kH = 20;
+    SkRandom rand;
+    uint8_t a8[kH][kW];
+    uint16_t lcd16[kH][kW];
+    for (int y = 0; y < kH; ++y) {
+        for (int x = 0; x < kW; ++x) {
+            a8[y][x] = rand.nextU() & 0xFF;
+            lcd16[y][x] = rand.nextU() & 0xFFFF;
+        }
+    }
+
+    // Overlapping masks, like glyphs in a tight run.
+    SkMask masks[6];
+    SkIRect clips[6];
+    for (int i = 0; i < 6; ++i) {
+        masks[i].fBounds = SkIRect::MakeXYWH(3 * i, i, kW, kH);
+        masks[i].fFormat = (i % 3 == 2) ? SkMask::kLCD16_Format : SkMask::kA8_Format;
+        if (SkMask::kLCD16_Format == masks[i].fFormat) {
+            masks[i].fImage = (uint8_t*)lcd16;
+            masks[i].fRowBytes = sizeof(lcd16[0]);
+        } else {
+            masks[i].fImage = (uint8_t*)a8;
+            masks[i].fRowBytes = sizeof(a8[0]);
+        }
+        clips[i] = masks[i].fBounds;
+        clips[i].inset(i % 2, 0);
+    }
+
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(kW + 20, kH + 10);
+    for (SkColor color : gMaskColors) {
+        SkPaint paint;
+        paint.setColor(color);
+        SkBitmap expected, actual;
+        expected.allocPixels(info);
+        actual.allocPixels(info);
+        expected.eraseColor(SK_ColorWHITE);
+        actual.eraseColor(SK_ColorWHITE);
+
+        SkPixmap pixmap;
+        {
+            SkTBlitterAllocator allocator;
+            expected.peekPixels(&pixmap);
+            SkBlitter* blitter = SkBlitter::Choose(pixmap, SkMatrix::I(), paint, &allocator);
+            for (int i = 0; i < 6; ++i) {
+                blitter->blitMask(masks[i], clips[i]);
+            }
+        }
+        {
+            SkTBlitterAllocator allocator;
+            actual.peekPixels(&pixmap);
+            SkBlitter* blitter = SkBlitter::Choose(pixmap, SkMatrix::I(), paint, &allocator);
+            blitter->blitMasks(masks, clips, 6);
+        }
+
+        REPORTER_ASSERT(reporter, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                              expected.getSize()));
+    }
+}
@@ -115,3 +115,69 @@ DEF_TEST(DashPathEffectTest_asPoints_limit, r) {
     p.setPathEffect(SkDashPathEffect::Make(intervals, SK_ARRAY_COUNT(intervals), 0));
     canvas->drawLine(1, 1, 1, 5.0e10f, p);
 }
+
+// Dashed hairlines are drawn one dash at a time, without building the whole dashed path. Check
+// that this matches drawing the dashed path (as built by the path effect) as a plain hairline.
+DEF_TEST(DashPathEffectTest_hairline, r) {
+    SkPath polyline;
+    polyline.moveTo(3, 7);
+    polyline.lineTo(90, 20);
+    polyline.lineTo(40, 95);
+    polyline.lineTo(97, 60);
+    SkPath closed;
+    closed.addRect(SkRect::MakeLTRB(10.5f, 10.5f, 80.5f, 60.5f));
+    closed.addCircle(50, 50, 30);
+    // enough dashes to be drawn in several batches, with dashes wrapping around each ring
+    SkPath rings;
+    for (SkScalar radius = 45; radius > 20; radius -= 4.5f) {
+        rings.addCircle(50, 50, radius);
+    }
+    SkPath gridLine;
+    gridLine.moveTo(-1000, 50.5f);
+    gridLine.lineTo(1000, 50.5f);
+    const SkPath* paths[] = { &polyline, &closed, &rings, &gridLine };
+
+    const SkScalar intervals[] = { 5, 3, 1, 3 };
+    sk_sp<SkPathEffect> dash(SkDashPathEffect::Make(intervals, SK_ARRAY_COUNT(intervals), 2));
+
+    SkBitmap expected, actual;
+    expected.allocN32Pixels(100, 100);
+    actual.allocN32Pixels(100, 100);
+    SkCanvas expectedCanvas(expected), actualCanvas(actual);
+
+    for (const SkPath* path : paths) {
+        for (SkPaint::Cap cap : { SkPaint::kButt_Cap, SkPaint::kSquare_Cap, SkPaint::kRound_Cap }) {
+            for (bool aa : { false, true }) {
+                for (SkScalar width : { 0.f, 0.5f }) {
+                    for (SkScalar degrees : { 0.f, 30.f }) {
+                        SkPaint paint;
+                        paint.setStyle(SkPaint::kStroke_Style);
+                        paint.setStrokeWidth(width);
+                        paint.setStrokeCap(cap);
+                        paint.setAntiAlias(aa);
+                        paint.setColor(0x80FF0000);
+
+                        SkPaint dashPaint(paint);
+                        dashPaint.setPathEffect(dash);
+                        SkPath dashed;
+                        SkStrokeRec rec(SkStrokeRec::kHairline_InitStyle);
+                        REPORTER_ASSERT(r, dash->filterPath(&dashed, *path, &rec, nullptr));
+
+                        for (SkCanvas* canvas : { &expectedCanvas, &actualCanvas }) {
+                            canvas->clear(SK_ColorWHITE);
+                            canvas->save();
+                            canvas->rotate(degrees, 50, 50);
+                        }
+                        expectedCanvas.drawPath(dashed, paint);
+                        actualCanvas.drawPath(*path, dashPaint);
+                        expectedCanvas.restore();
+                        actualCanvas.restore();
+
+                        REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                                       expected.getSize()));
+                    }
+                }
+            }
+        }
+    }
+}
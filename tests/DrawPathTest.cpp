@@ -5,11 +5,17 @@
  * found in the LICENSE file.
  */
 
+#include "SkAutoPixmapStorage.h"
 #include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkDashPathEffect.h"
+#include "SkDraw.h"
+#include "SkMaskCache.h"
+#include "SkRasterClip.h"
+#include "SkScan.h"
 #include "SkStrokeRec.h"
 #include "SkSurface.h"
+#include "DrawTestingAccess.h"
 #include "Test.h"
 
 // test that we can draw an aa-rect at coordinates > 32K (bigger than fixedpoint)
@@ -362,3 +368,155 @@ DEF_TEST(DrawPath, reporter) {
     test_big_aa_rect(reporter);
     test_halfway();
 }
+
+static void draw_path_in_bands(const SkPath& path, const SkRasterClip& clip, int bands,
+                               SkAutoPixmapStorage* pixmap) {
+    pixmap->alloc(SkImageInfo::MakeA8(512, 512));
+    pixmap->erase(SK_ColorTRANSPARENT);
+    SkMatrix identity = SkMatrix::I();
+    SkDraw draw;
+    draw.fDst = *pixmap;
+    draw.fMatrix = &identity;
+    draw.fRC = &clip;
+    DrawTestingAccess::SetAAFillBands(&draw, bands);
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    draw.drawPath(path, paint);
+}
+
+// Filling in bands walks the same edges as a single pass, so every pixel must match.
+DEF_TEST(DrawPath_bands, reporter) {
+    SkPath paths[3];
+    paths[0].addCircle(256, 256, 200);
+    paths[0].addRect(SkRect::MakeLTRB(100, 20, 140, 500));
+    paths[0].setFillType(SkPath::kEvenOdd_FillType);
+    // A winding star of crossing lines, with a cubic lobe through it.
+    paths[1].moveTo(256, 10);
+    for (int i = 1; i < 11; ++i) {
+        SkScalar angle = i * 3 * SK_ScalarPI / 5.5f;
+        paths[1].lineTo(256 + 245 * SkScalarSin(angle), 256 - 245 * SkScalarCos(angle));
+    }
+    paths[1].close();
+    paths[1].moveTo(30, 480);
+    paths[1].cubicTo(500, 400, -200, 100, 470, 37.3f);
+    paths[1].quadTo(300, 500, 30, 480);
+    paths[2] = paths[1];
+    paths[2].setFillType(SkPath::kEvenOdd_FillType);
+
+    SkRasterClip clips[] = {
+        SkRasterClip(SkIRect::MakeWH(512, 512)),
+        SkRasterClip(SkIRect::MakeLTRB(3, 41, 497, 433)),
+        SkRasterClip(SkIRect::MakeLTRB(0, 0, 512, 300)),
+    };
+    clips[2].op(SkIRect::MakeLTRB(100, 200, 400, 470), SkRegion::kUnion_Op);
+    for (const SkPath& path : paths) {
+        for (const SkRasterClip& clip : clips) {
+            REPORTER_ASSERT(reporter, SkScan::CountAntiFillBands(path, clip, 5) > 1);
+            SkAutoPixmapStorage expected;
+            draw_path_in_bands(path, clip, 1, &expected);
+            for (int bands : { 2, 3, 5 }) {
+                SkAutoPixmapStorage actual;
+                draw_path_in_bands(path, clip, bands, &actual);
+                REPORTER_ASSERT(reporter, !memcmp(expected.addr(), actual.addr(),
+                                                  expected.getSafeSize()));
+            }
+        }
+    }
+}
+
+static void draw_small_path(const SkPath& path, const SkPaint& paint, SkScalar dx, SkScalar dy,
+                            SkAutoPixmapStorage* pixmap) {
+    pixmap->alloc(SkImageInfo::MakeN32Premul(64, 64));
+    pixmap->erase(0xFF336699);
+    SkBitmap bitmap;
+    bitmap.installPixels(*pixmap);
+    SkCanvas canvas(bitmap);
+    canvas.translate(dx, dy);
+    canvas.drawPath(path, paint);
+}
+
+static SkPath make_small_path(int index) {
+    SkPath path;
+    switch (index) {
+        case 0:
+            path.addCircle(10, 10, 8.3f);
+            break;
+        case 1:
+            path.moveTo(2, 3);
+            path.cubicTo(20, -4, 0, 22, 18.5f, 17);
+            break;
+        default:
+            path.addRect(SkRect::MakeLTRB(1.5f, 2.25f, 15, 13.75f));
+            break;
+    }
+    return path;
+}
+
+// Repeated small path draws are replayed from a cached mask, which must match scan converting.
+DEF_TEST(DrawPath_maskCache, reporter) {
+    SkPaint paints[3];
+    paints[0].setStyle(SkPaint::kFill_Style);
+    paints[1].setStyle(SkPaint::kStroke_Style);
+    paints[1].setStrokeWidth(3.5f);
+    paints[1].setStrokeCap(SkPaint::kRound_Cap);
+    paints[1].setStrokeJoin(SkPaint::kRound_Join);
+    paints[2].setStyle(SkPaint::kStrokeAndFill_Style);
+    paints[2].setStrokeWidth(2.25f);
+    paints[2].setStrokeJoin(SkPaint::kMiter_Join);
+    for (SkPaint& paint : paints) {
+        paint.setAntiAlias(true);
+        paint.setColor(0xC0E04020);
+    }
+
+    const SkPoint offsets[] = { { 10.25f, 3.5f }, { 10, 3 }, { 33.7f, 40.1f } };
+    for (int index = 0; index < 3; ++index) {
+        for (const SkPaint& paint : paints) {
+            for (const SkPoint& offset : offsets) {
+                SkPath volatilePath = make_small_path(index);
+                volatilePath.setIsVolatile(true);
+                SkAutoPixmapStorage expected;
+                draw_small_path(volatilePath, paint, offset.fX, offset.fY, &expected);
+
+                // The first draw is noted, the second keeps its mask, and the rest replay it.
+                SkPath path = make_small_path(index);
+                for (int i = 0; i < 4; ++i) {
+                    SkAutoPixmapStorage actual;
+                    draw_small_path(path, paint, offset.fX, offset.fY, &actual);
+                    REPORTER_ASSERT(reporter, !memcmp(expected.addr(), actual.addr(),
+                                                      expected.getSafeSize()));
+                }
+            }
+        }
+    }
+}
+
+// A path drawn again at a whole pixel offset from before reuses the mask kept for it.
+DEF_TEST(DrawPath_maskCacheIntegerOffsets, reporter) {
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(0xC0E04020);
+    const SkPoint offsets[] = { { 10.25f, 3.5f }, { 30.25f, 20.5f }, { 5.25f, 40.5f } };
+
+    SkPath path = make_small_path(0);
+    SkAutoPixmapStorage pixmap;
+    // The first draw is noted; the second, at another offset, repeats it and keeps its mask.
+    draw_small_path(path, paint, offsets[0].fX, offsets[0].fY, &pixmap);
+    draw_small_path(path, paint, offsets[1].fX, offsets[1].fY, &pixmap);
+
+    SkMask mask;
+    SkMatrix matrix = SkMatrix::MakeTrans(offsets[2].fX, offsets[2].fY);
+    SkCachedData* data = SkMaskCache::FindAndRef(path, matrix, paint, &mask);
+    REPORTER_ASSERT(reporter, data);
+    if (!data) {
+        return;
+    }
+    data->unref();
+
+    // Drawing at a third offset replays the mask, in the right place.
+    SkPath volatilePath = make_small_path(0);
+    volatilePath.setIsVolatile(true);
+    SkAutoPixmapStorage expected, actual;
+    draw_small_path(volatilePath, paint, offsets[2].fX, offsets[2].fY, &expected);
+    draw_small_path(path, paint, offsets[2].fX, offsets[2].fY, &actual);
+    REPORTER_ASSERT(reporter, !memcmp(expected.addr(), actual.addr(), expected.getSafeSize()));
+}
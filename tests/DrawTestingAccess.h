@@ -0,0 +1,26 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef DrawTestingAccess_DEFINED
+#define DrawTestingAccess_DEFINED
+
+#include "SkDraw.h"
+
+// Sets what an SkDraw would otherwise read from process-wide settings, so that tests don't
+// change how other tests running at the same time draw.
+class DrawTestingAccess {
+public:
+    static void SetAAFillBands(SkDraw* draw, int bands) {
+        draw->fAAFillBands = bands;
+    }
+
+    static void SetTextSizeTolerance(SkDraw* draw, const SkScalar* tolerance) {
+        draw->fTextSizeTolerance = tolerance;
+    }
+};
+
+#endif
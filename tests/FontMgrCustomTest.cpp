@@ -0,0 +1,180 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Resources.h"
+#include "SkData.h"
+#include "SkFontMgr.h"
+#include "SkFontMgr_custom.h"
+#include "SkOSFile.h"
+#include "SkOSPath.h"
+#include "SkStream.h"
+#include "SkTArray.h"
+#include "SkTemplates.h"
+#include "SkTypeface.h"
+#include "Test.h"
+
+#include <cstdio>
+#include <cstring>
+#include <utime.h>
+
+static bool copy_resource(const char resource[], const SkString& path) {
+    sk_sp<SkData> data = SkData::MakeFromFileName(GetResourcePath(resource).c_str());
+    SkFILEWStream file(path.c_str());
+    return data && file.isValid() && file.write(data->data(), data->size());
+}
+
+// Returns the name of the only family of a font manager, or "" if it doesn't have just one.
+static SkString only_family(const char fontDir[], const char cachePath[]) {
+    sk_sp<SkFontMgr> fontMgr(SkFontMgr_New_Custom_Directory(fontDir, cachePath));
+    SkString name;
+    if (1 == fontMgr->countFamilies()) {
+        fontMgr->getFamilyName(0, &name);
+    }
+    return name;
+}
+
+// Renames the family of every face in the cache, so a manager using it shows the new name.
+static bool rename_cached_family(const char cachePath[], const SkString& from, const char to[]) {
+    SkASSERT(strlen(to) == from.size());
+    sk_sp<SkData> data = SkData::MakeFromFileName(cachePath);
+    if (!data) {
+        return false;
+    }
+    SkAutoTMalloc<char> bytes(data->size());
+    memcpy(bytes.get(), data->data(), data->size());
+    // Each name is stored as its length then its characters.
+    uint32_t length = SkToU32(from.size());
+    int renamed = 0;
+    for (size_t i = 0; i + sizeof(length) + from.size() <= data->size(); ++i) {
+        if (!memcmp(bytes.get() + i, &length, sizeof(length)) &&
+            !memcmp(bytes.get() + i + sizeof(length), from.c_str(), from.size())) {
+            memcpy(bytes.get() + i + sizeof(length), to, from.size());
+            ++renamed;
+        }
+    }
+    SkFILEWStream file(cachePath);
+    return renamed > 0 && file.isValid() && file.write(bytes.get(), data->size());
+}
+
+DEF_TEST(FontMgrCustom_scanCache, reporter) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+    SkString fontDir = SkOSPath::Join(tmpDir.c_str(), "font_scan_cache_fonts");
+    SkString cacheDir = SkOSPath::Join(tmpDir.c_str(), "font_scan_cache");
+    SkString fontPath = SkOSPath::Join(fontDir.c_str(), "font.ttf");
+    SkString cachePath = SkOSPath::Join(cacheDir.c_str(), "cache");
+    REPORTER_ASSERT(reporter, sk_mkdir(fontDir.c_str()) && sk_mkdir(cacheDir.c_str()));
+    remove(cachePath.c_str());
+    if (!copy_resource("fonts/Em.ttf", fontPath)) {
+        INFOF(reporter, "Could not copy fonts/Em.ttf, skipping.\n");
+        return;
+    }
+
+    // The first manager scans the font and writes what it found.
+    SkString family = only_family(fontDir.c_str(), cachePath.c_str());
+    REPORTER_ASSERT(reporter, !family.isEmpty());
+    if (family.isEmpty()) {
+        return;
+    }
+    SkString renamed(family);
+    renamed[0] = 'A' == family[0] ? 'B' : 'A';
+
+    // A manager trusts the cache while the font is unchanged.
+    REPORTER_ASSERT(reporter, rename_cached_family(cachePath.c_str(), family, renamed.c_str()));
+    REPORTER_ASSERT(reporter, renamed == only_family(fontDir.c_str(), cachePath.c_str()));
+    REPORTER_ASSERT(reporter, renamed == only_family(fontDir.c_str(), cachePath.c_str()));
+
+    // A truncated cache is ignored, and replaced by a good one.
+    sk_sp<SkData> cache = SkData::MakeFromFileName(cachePath.c_str());
+    REPORTER_ASSERT(reporter, cache);
+    if (!cache) {
+        return;
+    }
+    // Copy the cache out of its mapping before truncating the file.
+    cache = SkData::MakeWithCopy(cache->data(), cache->size());
+    {
+        SkFILEWStream file(cachePath.c_str());
+        file.write(cache->data(), cache->size() / 2);
+    }
+    REPORTER_ASSERT(reporter, family == only_family(fontDir.c_str(), cachePath.c_str()));
+    REPORTER_ASSERT(reporter, rename_cached_family(cachePath.c_str(), family, renamed.c_str()));
+    REPORTER_ASSERT(reporter, renamed == only_family(fontDir.c_str(), cachePath.c_str()));
+
+    // A font with the same size and first bytes is scanned again once it has been modified.
+    struct utimbuf times = { 1000000000, 1000000000 };
+    REPORTER_ASSERT(reporter, 0 == utime(fontPath.c_str(), &times));
+    REPORTER_ASSERT(reporter, family == only_family(fontDir.c_str(), cachePath.c_str()));
+
+    // So is a font that changed size.
+    REPORTER_ASSERT(reporter, rename_cached_family(cachePath.c_str(), family, renamed.c_str()));
+    {
+        SkFILEWStream file(fontPath.c_str());
+        sk_sp<SkData> data = SkData::MakeFromFileName(GetResourcePath("fonts/Em.ttf").c_str());
+        REPORTER_ASSERT(reporter, data && file.write(data->data(), data->size()) &&
+                                  file.write("\0\0\0\0", 4));
+    }
+    REPORTER_ASSERT(reporter, family == only_family(fontDir.c_str(), cachePath.c_str()));
+
+    // A removed font is dropped from the cache.
+    remove(fontPath.c_str());
+    REPORTER_ASSERT(reporter, only_family(fontDir.c_str(), cachePath.c_str()).isEmpty());
+    REPORTER_ASSERT(reporter, copy_resource("fonts/Em.ttf", fontPath));
+    REPORTER_ASSERT(reporter, family == only_family(fontDir.c_str(), cachePath.c_str()));
+
+    // Writing the cache leaves no temporary files behind.
+    SkOSFile::Iter iter(cacheDir.c_str());
+    SkString name;
+    while (iter.next(&name)) {
+        REPORTER_ASSERT(reporter, name.equals("cache"));
+    }
+    remove(cachePath.c_str());
+    remove(fontPath.c_str());
+}
+
+// The faces of a collection read the file through one mapping.
+DEF_TEST(FontMgrCustom_sharesFileMapping, reporter) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+    SkString fontDir = SkOSPath::Join(tmpDir.c_str(), "font_mapping_fonts");
+    SkString fontPath = SkOSPath::Join(fontDir.c_str(), "test.ttc");
+    REPORTER_ASSERT(reporter, sk_mkdir(fontDir.c_str()));
+    if (!copy_resource("fonts/test.ttc", fontPath)) {
+        INFOF(reporter, "Could not copy fonts/test.ttc, skipping.\n");
+        return;
+    }
+    sk_sp<SkFontMgr> fontMgr(SkFontMgr_New_Custom_Directory(fontDir.c_str()));
+    SkTArray<sk_sp<SkTypeface>> faces;
+    for (int i = 0; i < fontMgr->countFamilies(); ++i) {
+        sk_sp<SkFontStyleSet> set(fontMgr->createStyleSet(i));
+        for (int j = 0; j < set->count(); ++j) {
+            faces.emplace_back(set->createTypeface(j));
+        }
+    }
+    REPORTER_ASSERT(reporter, faces.count() > 1);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        SkTArray<std::unique_ptr<SkStreamAsset>> streams;
+        for (const sk_sp<SkTypeface>& face : faces) {
+            int index;
+            streams.emplace_back(face->openStream(&index));
+            REPORTER_ASSERT(reporter, streams.back() && streams.back()->getMemoryBase());
+            if (!streams.back()) {
+                return;
+            }
+        }
+        for (const std::unique_ptr<SkStreamAsset>& stream : streams) {
+            REPORTER_ASSERT(reporter, stream->getMemoryBase() == streams[0]->getMemoryBase());
+            REPORTER_ASSERT(reporter, stream->getLength() == streams[0]->getLength());
+        }
+        // Once every stream is closed the file is mapped again by the next one.
+    }
+    remove(fontPath.c_str());
+}
@@ -701,6 +701,29 @@ static void test_matchStyleCSS3(skiatest::Reporter* reporter) {
     }
 }
 
+// Fallback fonts may be remembered between queries, but must have the character asked for and
+// be the same font when asked again.
+static void test_matchCharacter(skiatest::Reporter* reporter) {
+    sk_sp<SkFontMgr> fm(SkFontMgr::RefDefault());
+    const char* languages[] = { "en-US", "ja-JP" };
+    for (SkUnichar character : { 0x0041, 0x0042, 0x00E9, 0x0416, 0x05D0, 0x4E00, 0x4E01, 0x2603 }) {
+        for (int languageCount : { 0, 2 }) {
+            sk_sp<SkTypeface> first(fm->matchFamilyStyleCharacter(
+                    nullptr, SkFontStyle(), languages, languageCount, character));
+            sk_sp<SkTypeface> again(fm->matchFamilyStyleCharacter(
+                    nullptr, SkFontStyle(), languages, languageCount, character));
+            REPORTER_ASSERT(reporter, SkToBool(first) == SkToBool(again));
+            if (!first || !again) {
+                continue;
+            }
+            REPORTER_ASSERT(reporter, first->uniqueID() == again->uniqueID());
+            uint16_t glyph = 0;
+            first->charsToGlyphs(&character, SkTypeface::kUTF32_Encoding, &glyph, 1);
+            REPORTER_ASSERT(reporter, glyph != 0);
+        }
+    }
+}
+
 DEFINE_bool(verboseFontMgr, false, "run verbose fontmgr tests.");
 
 DEF_TEST(FontMgr, reporter) {
@@ -708,4 +731,5 @@ DEF_TEST(FontMgr, reporter) {
     test_fontiter(reporter, FLAGS_verboseFontMgr);
     test_alias_names(reporter);
     test_font(reporter);
+    test_matchCharacter(reporter);
 }
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBitmapDevice.h"
+#include "SkDraw.h"
+#include "SkGlyphCache.h"
+#include "SkGraphics.h"
+#include "SkRasterClip.h"
+#include "SkTypeface.h"
+#include "DrawTestingAccess.h"
+#include "Resources.h"
+#include "Test.h"
+
+static const char kFont[] = "fonts/Roboto2-Regular_NoEmbed.ttf";
+
+// Draws positioned text at the scale with the size tolerance, and returns the sum of the pixels'
+// coverage. The tolerance is given to SkDraw directly, so that other text in the process isn't
+// drawn with it.
+static int draw_text(SkTypeface* typeface, SkScalar scale, SkScalar tolerance, SkBitmap* bitmap) {
+    bitmap->allocN32Pixels(200, 60);
+    bitmap->eraseColor(SK_ColorWHITE);
+    SkBitmapDevice device(*bitmap);
+    SkMatrix matrix = SkMatrix::MakeScale(scale);
+    SkRasterClip clip(SkIRect::MakeWH(bitmap->width(), bitmap->height()));
+    SkDraw draw;
+    SkAssertResult(bitmap->peekPixels(&draw.fDst));
+    draw.fMatrix = &matrix;
+    draw.fRC = &clip;
+    draw.fDevice = &device;
+    DrawTestingAccess::SetTextSizeTolerance(&draw, &tolerance);
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setSubpixelText(true);
+    paint.setTextSize(13);
+    paint.setTypeface(sk_ref_sp(typeface));
+    const char text[] = "Zoom, zoom!";
+    const int count = sizeof(text) - 1;
+    SkPoint pos[count];
+    for (int i = 0; i < count; ++i) {
+        pos[i].set(5 + 8.25f * i, 20);
+    }
+    draw.drawPosText(text, count, &pos[0].fX, 2, SkPoint::Make(0, 0), paint);
+
+    int coverage = 0;
+    for (int y = 0; y < bitmap->height(); ++y) {
+        for (int x = 0; x < bitmap->width(); ++x) {
+            coverage += 255 - SkColorGetG(bitmap->getColor(x, y));
+        }
+    }
+    return coverage;
+}
+
+DEF_TEST(GlyphCache_sizeTolerance, reporter) {
+    // Typefaces of our own, so that strikes of the shared one are only ever made by this test
+    // and each scale is first drawn here.
+    sk_sp<SkTypeface> sharedTypeface(SkTypeface::MakeFromFile(GetResourcePath(kFont).c_str()));
+    sk_sp<SkTypeface> unsharedTypeface(SkTypeface::MakeFromFile(GetResourcePath(kFont).c_str()));
+    if (!sharedTypeface || !unsharedTypeface) {
+        INFOF(reporter, "Could not load %s, skipping.\n", kFont);
+        return;
+    }
+    const SkScalar scales[] = { 1.0f, 1.01f, 1.02f, 1.03f, 1.04f, 1.05f };
+
+    // Sizes 13 to 13.65 are on a grid of whole pixel sizes, so they share the strikes of 13
+    // and 14. Strikes may be purged by other tests at any time, so the sizes each draw asks for
+    // are checked rather than the strikes in the cache.
+    const SkScalar sharedSizes[] = { 13, 13, 13, 13, 14, 14 };
+    for (size_t i = 0; i < SK_ARRAY_COUNT(scales); ++i) {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setTextSize(13);
+        SkMatrix matrix = SkMatrix::MakeScale(scales[i]);
+        SkPaint sharedPaint;
+        SkScalar glyphScale;
+        REPORTER_ASSERT(reporter, SkGlyphCache::ShouldShareStrike(paint, matrix, 0.1f,
+                                                                  &sharedPaint, &glyphScale));
+        REPORTER_ASSERT(reporter, sharedSizes[i] == sharedPaint.getTextSize());
+        REPORTER_ASSERT(reporter, 13 * scales[i] / sharedSizes[i] == glyphScale);
+        REPORTER_ASSERT(reporter, !SkGlyphCache::ShouldShareStrike(paint, matrix, 0,
+                                                                   &sharedPaint, &glyphScale));
+    }
+
+    // Every draw at a scale but 1 avoids a strike of its own. Other tests may avoid strikes too,
+    // but never take them back.
+    int avoidedBefore = SkGraphics::GetFontCacheStrikesAvoided();
+    SkBitmap shared[SK_ARRAY_COUNT(scales)];
+    int sharedCoverage[SK_ARRAY_COUNT(scales)];
+    for (size_t i = 0; i < SK_ARRAY_COUNT(scales); ++i) {
+        sharedCoverage[i] = draw_text(sharedTypeface.get(), scales[i], 0.1f, &shared[i]);
+    }
+    REPORTER_ASSERT(reporter, SkGraphics::GetFontCacheStrikesAvoided() - avoidedBefore >=
+                              (int)SK_ARRAY_COUNT(scales) - 1);
+
+    SkBitmap unshared[SK_ARRAY_COUNT(scales)];
+    int unsharedCoverage[SK_ARRAY_COUNT(scales)];
+    for (size_t i = 0; i < SK_ARRAY_COUNT(scales); ++i) {
+        unsharedCoverage[i] = draw_text(unsharedTypeface.get(), scales[i], 0, &unshared[i]);
+    }
+
+    // Unscaled glyphs are drawn just as they would be from a strike of their own.
+    REPORTER_ASSERT(reporter, !memcmp(shared[0].getPixels(), unshared[0].getPixels(),
+                                      shared[0].getSafeSize()));
+    // Scaled ones cover about as much.
+    for (size_t i = 1; i < SK_ARRAY_COUNT(scales); ++i) {
+        REPORTER_ASSERT(reporter, sharedCoverage[i] > 0);
+        REPORTER_ASSERT(reporter,
+                        SkTAbs(sharedCoverage[i] - unsharedCoverage[i]) < unsharedCoverage[i] / 10);
+    }
+}
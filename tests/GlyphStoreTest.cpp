@@ -0,0 +1,273 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkData.h"
+#include "SkFontDescriptor.h"
+#include "SkGlyphCache.h"
+#include "SkGlyphStore.h"
+#include "SkGraphics.h"
+#include "SkMakeUnique.h"
+#include "SkOSPath.h"
+#include "SkPath.h"
+#include "SkStream.h"
+#include "SkTArray.h"
+#include "SkTypeface.h"
+#include "Resources.h"
+#include "Test.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+static const char kFont[] = "fonts/Roboto2-Regular_NoEmbed.ttf";
+static const char kText[] = "Glyphs, saved!";
+
+// Strikes of small text, which is drawn from glyph masks, and big text, which is drawn from
+// paths. The strikes are held detached, so nothing else using the global font cache can
+// purge or change them.
+struct TestStrikes {
+    explicit TestStrikes(sk_sp<SkTypeface> typeface) {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setTypeface(std::move(typeface));
+        // A strike holds each glyph once.
+        int count = paint.textToGlyphs(kText, sizeof(kText) - 1, fGlyphIDs);
+        std::sort(fGlyphIDs, fGlyphIDs + count);
+        fGlyphCount = SkToInt(std::unique(fGlyphIDs, fGlyphIDs + count) - fGlyphIDs);
+        for (SkScalar size : { 9.0f, 13.0f, 24.0f, 300.0f }) {
+            paint.setTextSize(size);
+            fCaches.emplace_back(paint, nullptr, nullptr);
+            SkGlyphCache* cache = fCaches.back().get();
+            for (int i = 0; i < fGlyphCount; ++i) {
+                const SkGlyph& glyph = cache->getGlyphIDMetrics(fGlyphIDs[i]);
+                if (size > 256) {
+                    cache->findPath(glyph);
+                } else {
+                    cache->findImage(glyph);
+                }
+            }
+        }
+    }
+
+    bool write(SkTypeface* typeface, SkWStream* stream) const {
+        SkGlyphStore::Writer writer;
+        for (const SkAutoGlyphCache& cache : fCaches) {
+            std::unique_ptr<SkDescriptor> key =
+                    SkGlyphStore::MakeKey(typeface, cache->getDescriptor());
+            if (!key) {
+                return false;
+            }
+            SkTArray<const SkGlyph*> glyphs;
+            for (int i = 0; i < fGlyphCount; ++i) {
+                glyphs.push_back(&cache->getGlyphIDMetrics(fGlyphIDs[i]));
+            }
+            writer.addStrike(*key, cache->getFontMetrics(), glyphs.begin(), glyphs.count());
+        }
+        return writer.write(stream);
+    }
+
+    std::vector<SkAutoGlyphCache> fCaches;
+    SkGlyphID                     fGlyphIDs[sizeof(kText)];
+    int                           fGlyphCount;
+};
+
+DEF_TEST(GlyphStore_roundTrip, reporter) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+    SkString path = SkOSPath::Join(tmpDir.c_str(), "glyph_store_test");
+
+    sk_sp<SkTypeface> typeface(SkTypeface::MakeFromFile(GetResourcePath(kFont).c_str()));
+    if (!typeface) {
+        INFOF(reporter, "Could not load %s, skipping.\n", kFont);
+        return;
+    }
+    TestStrikes strikes(typeface);
+    {
+        SkFILEWStream file(path.c_str());
+        REPORTER_ASSERT(reporter, strikes.write(typeface.get(), &file));
+    }
+    sk_sp<SkGlyphStore> store = SkGlyphStore::Make(SkData::MakeFromFileName(path.c_str()));
+    REPORTER_ASSERT(reporter, store);
+    if (!store) {
+        return;
+    }
+
+    // A second typeface from the same file has its own font ID, like the font would in
+    // another process, so its strikes can only be found in the file by the font's identity.
+    sk_sp<SkTypeface> reloaded(SkTypeface::MakeFromFile(GetResourcePath(kFont).c_str()));
+    REPORTER_ASSERT(reporter, reloaded->uniqueID() != typeface->uniqueID());
+
+    for (const SkAutoGlyphCache& cache : strikes.fCaches) {
+        std::unique_ptr<SkDescriptor> key =
+                SkGlyphStore::MakeKey(reloaded.get(), cache->getDescriptor());
+        const SkGlyphStore::Strike* strike = store->findStrike(*key);
+        REPORTER_ASSERT(reporter, strike);
+        if (!strike) {
+            continue;
+        }
+        REPORTER_ASSERT(reporter, !memcmp(&strike->getFontMetrics(), &cache->getFontMetrics(),
+                                          sizeof(SkPaint::FontMetrics)));
+        for (int i = 0; i < strikes.fGlyphCount; ++i) {
+            const SkGlyph& expected = cache->getGlyphIDMetrics(strikes.fGlyphIDs[i]);
+            SkGlyph actual;
+            actual.initWithGlyphID(expected.getPackedID());
+            REPORTER_ASSERT(reporter, strike->initGlyph(&actual));
+            REPORTER_ASSERT(reporter, actual.fAdvanceX == expected.fAdvanceX &&
+                                      actual.fAdvanceY == expected.fAdvanceY &&
+                                      actual.fWidth == expected.fWidth &&
+                                      actual.fHeight == expected.fHeight &&
+                                      actual.fTop == expected.fTop &&
+                                      actual.fLeft == expected.fLeft &&
+                                      actual.fMaskFormat == expected.fMaskFormat);
+            REPORTER_ASSERT(reporter, !expected.fImage == !actual.fImage);
+            if (expected.fImage && actual.fImage) {
+                REPORTER_ASSERT(reporter, !memcmp(expected.fImage, actual.fImage,
+                                                  expected.computeImageSize()));
+            }
+            SkPath actualPath;
+            bool hasPath = strike->readPath(expected.getPackedID(), &actualPath);
+            const SkPath* expectedPath = expected.fPathData ? expected.fPathData->fPath : nullptr;
+            REPORTER_ASSERT(reporter, hasPath == SkToBool(expectedPath));
+            if (hasPath && expectedPath) {
+                REPORTER_ASSERT(reporter, actualPath == *expectedPath);
+            }
+        }
+    }
+    store.reset();
+
+    // Writing the global cache replaces the file, even while it exists.
+    REPORTER_ASSERT(reporter, SkGraphics::WriteFontCacheFile(path.c_str()));
+    REPORTER_ASSERT(reporter, SkGraphics::WriteFontCacheFile(path.c_str()));
+    REPORTER_ASSERT(reporter, SkGlyphStore::Make(SkData::MakeFromFileName(path.c_str())));
+    remove(path.c_str());
+}
+
+// Draws kText small, from glyph masks, and big, from paths, and returns the path of the big
+// text.
+static SkPath draw_text(SkTypeface* typeface, SkBitmap* bitmap) {
+    bitmap->allocN32Pixels(400, 300);
+    bitmap->eraseColor(SK_ColorWHITE);
+    SkCanvas canvas(*bitmap);
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setTypeface(sk_ref_sp(typeface));
+    paint.setTextSize(13);
+    canvas.drawText(kText, sizeof(kText) - 1, 10, 20, paint);
+    paint.setTextSize(300);
+    canvas.drawText(kText, sizeof(kText) - 1, 10, 280, paint);
+    SkPath path;
+    paint.getTextPath(kText, sizeof(kText) - 1, 10, 280, &path);
+    return path;
+}
+
+// Text drawn once the cache file is in use comes out as it did when the file was written.
+DEF_TEST(GlyphStore_drawsFromFontCacheFile, reporter) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+    SkString path = SkOSPath::Join(tmpDir.c_str(), "glyph_store_draw_test");
+
+    sk_sp<SkTypeface> typeface(SkTypeface::MakeFromFile(GetResourcePath(kFont).c_str()));
+    if (!typeface) {
+        INFOF(reporter, "Could not load %s, skipping.\n", kFont);
+        return;
+    }
+    SkBitmap expected;
+    SkPath expectedPath;
+    // Another test may purge the cache between drawing and writing it; if so, try again.
+    bool stored = false;
+    for (int attempt = 0; attempt < 5 && !stored; ++attempt) {
+        expectedPath = draw_text(typeface.get(), &expected);
+        REPORTER_ASSERT(reporter, SkGraphics::WriteFontCacheFile(path.c_str()));
+        sk_sp<SkGlyphStore> store = SkGlyphStore::Make(SkData::MakeFromFileName(path.c_str()));
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        paint.setTypeface(typeface);
+        paint.setTextSize(13);
+        SkAutoGlyphCache cache(paint, nullptr, nullptr);
+        std::unique_ptr<SkDescriptor> key =
+                SkGlyphStore::MakeKey(typeface.get(), cache->getDescriptor());
+        stored = store && key && store->findStrike(*key);
+    }
+    REPORTER_ASSERT(reporter, stored);
+
+    REPORTER_ASSERT(reporter, SkGraphics::SetFontCacheFile(path.c_str()));
+    SkGraphics::PurgeFontCache();
+    // A typeface of its own has no strikes yet, so they are all made with the file in use.
+    sk_sp<SkTypeface> reloaded(SkTypeface::MakeFromFile(GetResourcePath(kFont).c_str()));
+    SkBitmap actual;
+    SkPath actualPath = draw_text(reloaded.get(), &actual);
+    SkGraphics::SetFontCacheFile(nullptr);
+
+    REPORTER_ASSERT(reporter, !memcmp(expected.getPixels(), actual.getPixels(),
+                                      expected.getSafeSize()));
+    REPORTER_ASSERT(reporter, expectedPath == actualPath);
+    remove(path.c_str());
+}
+
+static sk_sp<SkTypeface> make_distortable(SkFixed axis) {
+    std::unique_ptr<SkStreamAsset> stream(GetResourceAsStream("/fonts/Distortable.ttf"));
+    if (!stream) {
+        return nullptr;
+    }
+    return SkTypeface::MakeFromFontData(
+            skstd::make_unique<SkFontData>(std::move(stream), 0, &axis, 1));
+}
+
+// The faces of one file have the same 'head' table, so they must be told apart by more.
+DEF_TEST(GlyphStore_keysTellFacesApart, reporter) {
+    SkString ttc = GetResourcePath("fonts/test.ttc");
+    sk_sp<SkTypeface> faces[] = { SkTypeface::MakeFromFile(ttc.c_str(), 0),
+                                  SkTypeface::MakeFromFile(ttc.c_str(), 1),
+                                  make_distortable(SK_Fixed1),
+                                  make_distortable(SK_FixedSqrt2) };
+    for (const sk_sp<SkTypeface>& face : faces) {
+        if (!face) {
+            INFOF(reporter, "Could not load test.ttc or Distortable.ttf, skipping.\n");
+            return;
+        }
+    }
+    SkPaint paint;
+    paint.setTypeface(faces[0]);
+    SkAutoGlyphCache cache(paint, nullptr, nullptr);
+    std::unique_ptr<SkDescriptor> keys[SK_ARRAY_COUNT(faces)];
+    for (size_t i = 0; i < SK_ARRAY_COUNT(faces); ++i) {
+        keys[i] = SkGlyphStore::MakeKey(faces[i].get(), cache->getDescriptor());
+        REPORTER_ASSERT(reporter, keys[i]);
+        if (!keys[i]) {
+            return;
+        }
+    }
+    REPORTER_ASSERT(reporter, *keys[0] != *keys[1]);
+    REPORTER_ASSERT(reporter, *keys[2] != *keys[3]);
+}
+
+DEF_TEST(GlyphStore_rejectsBadData, reporter) {
+    REPORTER_ASSERT(reporter, !SkGlyphStore::Make(SkData::MakeEmpty()));
+    const char garbage[] = "this is not a glyph store, though it is long enough to be one.";
+    REPORTER_ASSERT(reporter, !SkGlyphStore::Make(SkData::MakeWithCopy(garbage, sizeof(garbage))));
+
+    sk_sp<SkTypeface> typeface(SkTypeface::MakeFromFile(GetResourcePath(kFont).c_str()));
+    if (!typeface) {
+        return;
+    }
+    TestStrikes strikes(typeface);
+    SkDynamicMemoryWStream stream;
+    REPORTER_ASSERT(reporter, strikes.write(typeface.get(), &stream));
+    sk_sp<SkData> data = stream.detachAsData();
+    REPORTER_ASSERT(reporter, SkGlyphStore::Make(data));
+
+    // Every truncation of a valid store must be rejected rather than read past its end.
+    for (size_t length = 0; length < data->size(); length += 7) {
+        REPORTER_ASSERT(reporter, !SkGlyphStore::Make(SkData::MakeSubset(data.get(), 0, length)));
+    }
+}
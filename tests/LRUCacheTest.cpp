@@ -68,3 +68,23 @@ DEF_TEST(LRUCacheRandom, r) {
     }
     REPORTER_ASSERT(r, 0 == instances);
 }
+
+DEF_TEST(LRUCacheReset, r) {
+    int instances = 0;
+    {
+        static const int kSize = 5;
+        SkLRUCache<int, std::unique_ptr<Value>> test(kSize);
+        for (int i = 0; i < kSize; i++) {
+            test.insert(i, std::unique_ptr<Value>(new Value(i, &instances)));
+        }
+        test.reset();
+        REPORTER_ASSERT(r, 0 == instances);
+        REPORTER_ASSERT(r, 0 == test.count());
+        REPORTER_ASSERT(r, !test.find(0));
+
+        test.insert(0, std::unique_ptr<Value>(new Value(0, &instances)));
+        REPORTER_ASSERT(r, test.find(0));
+        REPORTER_ASSERT(r, 1 == instances);
+    }
+    REPORTER_ASSERT(r, 0 == instances);
+}
@@ -104,3 +104,70 @@ DEF_TEST(RectsMaskCache, reporter) {
     check_data(reporter, data, 1, kNotInCache, kLocked);
     data->unref();
 }
+
+DEF_TEST(PathMaskCache, reporter) {
+    SkResourceCache cache(1024);
+
+    SkPath path;
+    path.addCircle(10, 10, 8);
+    SkMatrix matrix = SkMatrix::MakeTrans(20.25f, 7);
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    SkMask mask;
+
+    SkCachedData* data = SkMaskCache::FindAndRef(path, matrix, paint, &mask, &cache);
+    REPORTER_ASSERT(reporter, nullptr == data);
+
+    size_t size = 256;
+    data = cache.newCachedData(size);
+    memset(data->writable_data(), 0xff, size);
+    mask.fBounds.setXYWH(0, 0, 16, 16);
+    mask.fRowBytes = 16;
+    mask.fFormat = SkMask::kA8_Format;
+    SkMaskCache::Add(path, matrix, paint, mask, data, &cache);
+    check_data(reporter, data, 2, kInCache, kLocked);
+
+    data->unref();
+    check_data(reporter, data, 1, kInCache, kUnlocked);
+
+    // Only the fractional part of the translate is part of the key, so the mask is found for
+    // draws that differ by whole pixels.
+    SkMask missMask;
+    matrix.postTranslate(-3, 5);
+    sk_bzero(&mask, sizeof(mask));
+    data = SkMaskCache::FindAndRef(path, matrix, paint, &mask, &cache);
+    REPORTER_ASSERT(reporter, data);
+    REPORTER_ASSERT(reporter, data->size() == size);
+    REPORTER_ASSERT(reporter, mask.fBounds.width() == 16);
+    REPORTER_ASSERT(reporter, data->data() == (const void*)mask.fImage);
+    check_data(reporter, data, 2, kInCache, kLocked);
+    data->unref();
+    matrix.postTranslate(3, -5);
+    data = SkMaskCache::FindAndRef(path, matrix, paint, &mask, &cache);
+    REPORTER_ASSERT(reporter, data);
+    check_data(reporter, data, 2, kInCache, kLocked);
+
+    matrix.postTranslate(0.5f, 0);
+    REPORTER_ASSERT(reporter, !SkMaskCache::FindAndRef(path, matrix, paint, &missMask, &cache));
+    matrix.postTranslate(-0.5f, 0);
+    paint.setStyle(SkPaint::kStroke_Style);
+    REPORTER_ASSERT(reporter, !SkMaskCache::FindAndRef(path, matrix, paint, &missMask, &cache));
+    paint.setStyle(SkPaint::kFill_Style);
+
+    // Draws are noted apart from masks, and report a repeat only the second time.
+    REPORTER_ASSERT(reporter, !SkMaskCache::NotePathDraw(path, matrix, paint, &cache));
+    REPORTER_ASSERT(reporter, SkMaskCache::NotePathDraw(path, matrix, paint, &cache));
+    matrix.postTranslate(1, 0);
+    REPORTER_ASSERT(reporter, SkMaskCache::NotePathDraw(path, matrix, paint, &cache));
+    matrix.postTranslate(0.25f, 0);
+    REPORTER_ASSERT(reporter, !SkMaskCache::NotePathDraw(path, matrix, paint, &cache));
+    matrix.postTranslate(-1.25f, 0);
+
+    path.lineTo(0, 0);
+    REPORTER_ASSERT(reporter, !SkMaskCache::FindAndRef(path, matrix, paint, &missMask, &cache));
+    REPORTER_ASSERT(reporter, !SkMaskCache::NotePathDraw(path, matrix, paint, &cache));
+
+    cache.purgeAll();
+    check_data(reporter, data, 1, kNotInCache, kLocked);
+    data->unref();
+}
@@ -222,3 +222,75 @@ DEF_TEST(SkPDF_pdfa_document, r) {
         }
     }
 }
+
+// Returns the cross-reference section that startxref points at, or nullptr.
+static const char* find_xref(const SkData& data) {
+    const char* bytes = (const char*)data.bytes();
+    static const char kStartXRef[] = "startxref\n";
+    const char* startXRef = nullptr;
+    for (size_t i = 0; i + strlen(kStartXRef) <= data.size(); ++i) {
+        if (0 == memcmp(bytes + i, kStartXRef, strlen(kStartXRef))) {
+            startXRef = bytes + i + strlen(kStartXRef);
+        }
+    }
+    if (!startXRef) {
+        return nullptr;
+    }
+    size_t xRefOffset = (size_t)atol(startXRef);
+    return xRefOffset < data.size() ? bytes + xRefOffset : nullptr;
+}
+
+DEF_TEST(SkPDF_object_streams, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_object_streams, r);
+
+    SkDocument::PDFMetadata pdfMetadata;
+    pdfMetadata.fObjectStreams = true;
+    SkDynamicMemoryWStream buffer;
+    auto doc = SkDocument::MakePDF(&buffer, SK_ScalarDefaultRasterDPI,
+                                   pdfMetadata, nullptr, false);
+    for (int i = 0; i < 3; ++i) {
+        SkPaint paint;
+        paint.setAlpha(0x40 * (i + 1));
+        doc->beginPage(64, 64)->drawText("Hello", 5, 10, 32, paint);
+        doc->endPage();
+    }
+    doc->close();
+    sk_sp<SkData> data(buffer.detachAsData());
+    const char* bytes = (const char*)data->bytes();
+
+    REPORTER_ASSERT(r, 0 == strncmp(bytes, "%PDF-1.5\n", 9));
+    REPORTER_ASSERT(r, contains(data->bytes(), data->size(), "/Type /ObjStm"));
+    REPORTER_ASSERT(r, !contains(data->bytes(), data->size(), "\ntrailer\n"));
+
+    // startxref must point at the cross-reference stream.
+    const char* xRef = find_xref(*data);
+    REPORTER_ASSERT(r, xRef);
+    if (xRef) {
+        size_t xRefSize = data->size() - (size_t)(xRef - bytes);
+        REPORTER_ASSERT(r, contains((const uint8_t*)xRef, xRefSize, "/Type /XRef"));
+    }
+}
+
+// PDF/A-1 forbids object streams, so a PDF/A document is written without them.
+DEF_TEST(SkPDF_pdfa_object_streams, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_pdfa_object_streams, r);
+
+    SkDocument::PDFMetadata pdfMetadata;
+    pdfMetadata.fObjectStreams = true;
+    SkDynamicMemoryWStream buffer;
+    auto doc = SkDocument::MakePDF(&buffer, SK_ScalarDefaultRasterDPI,
+                                   pdfMetadata, nullptr, /* pdfa = */ true);
+    doc->beginPage(64, 64)->drawText("Hello", 5, 10, 32, SkPaint());
+    doc->close();
+    sk_sp<SkData> data(buffer.detachAsData());
+    const char* bytes = (const char*)data->bytes();
+
+    REPORTER_ASSERT(r, 0 == strncmp(bytes, "%PDF-1.4\n", 9));
+    REPORTER_ASSERT(r, !contains(data->bytes(), data->size(), "/Type /ObjStm"));
+    REPORTER_ASSERT(r, !contains(data->bytes(), data->size(), "/Type /XRef"));
+    REPORTER_ASSERT(r, contains(data->bytes(), data->size(), "\ntrailer\n"));
+
+    // startxref must point at a classic cross-reference table.
+    const char* xRef = find_xref(*data);
+    REPORTER_ASSERT(r, xRef && 0 == strncmp(xRef, "xref\n", 5));
+}
@@ -11,15 +11,18 @@
 #include "SkData.h"
 #include "SkDocument.h"
 #include "SkDeflate.h"
+#include "SkGradientShader.h"
 #include "SkImageEncoder.h"
 #include "SkMakeUnique.h"
 #include "SkMatrix.h"
+#include "SkOnce.h"
 #include "SkPDFCanon.h"
 #include "SkPDFDevice.h"
 #include "SkPDFFont.h"
 #include "SkPDFTypes.h"
 #include "SkPDFUtils.h"
 #include "SkReadBuffer.h"
+#include "SkResourceCache.h"
 #include "SkScalar.h"
 #include "SkSpecialImage.h"
 #include "SkStream.h"
@@ -114,6 +117,24 @@ static void TestPDFStream(skiatest::Reporter* reporter) {
                    (const char*)expectedResultData2->data(),
                    expectedResultData2->size());
         #endif
+
+        // Streams made from pre-encoded data must match.
+        bool deflated;
+        sk_sp<SkData> encoded = SkPDFStream::EncodeData(
+                SkData::MakeWithCopy(streamBytes2, strlen(streamBytes2)), &deflated);
+        auto encodedStream = SkPDFStream::MakeWithEncodedData(std::move(encoded), deflated);
+        assert_eql(reporter, emit_to_string(*encodedStream), result.c_str(), result.size());
+    }
+    {
+        // Short data is stored as is.
+        bool deflated;
+        sk_sp<SkData> encoded = SkPDFStream::EncodeData(
+                SkData::MakeWithCopy(streamBytes, strlen(streamBytes)), &deflated);
+        REPORTER_ASSERT(reporter, !deflated);
+        auto encodedStream = SkPDFStream::MakeWithEncodedData(std::move(encoded), deflated);
+        assert_emit_eq(reporter,
+                       *encodedStream,
+                       "<</Length 12>> stream\nTest\nFoo\tBar\nendstream");
     }
 }
 
@@ -355,19 +376,23 @@ public:
     SK_TO_STRING_OVERRIDE()
     SK_DECLARE_PUBLIC_FLATTENABLE_DESERIALIZATION_PROCS(DummyImageFilter)
     bool visited() const { return fVisited; }
+    int visitCount() const { return fVisitCount; }
 
 protected:
     sk_sp<SkSpecialImage> onFilterImage(SkSpecialImage* source, const Context&,
                                         SkIPoint* offset) const override {
         fVisited = true;
+        ++fVisitCount;
         offset->fX = offset->fY = 0;
         return sk_ref_sp<SkSpecialImage>(source);
     }
 
 private:
-    DummyImageFilter(bool visited) : INHERITED(nullptr, 0, nullptr), fVisited(visited) {}
+    DummyImageFilter(bool visited)
+        : INHERITED(nullptr, 0, nullptr), fVisited(visited), fVisitCount(0) {}
 
     mutable bool fVisited;
+    mutable int fVisitCount;
 
     typedef SkImageFilter INHERITED;
 };
@@ -408,6 +433,108 @@ DEF_TEST(SkPDF_ImageFilter, reporter) {
     REPORTER_ASSERT(reporter, filter->visited());
 }
 
+// Check that the same filtered content on several pages is only filtered once.
+DEF_TEST(SkPDF_ImageFilter_Reuse, reporter) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_ImageFilter_Reuse, reporter);
+    SkDynamicMemoryWStream stream;
+    sk_sp<SkDocument> doc(SkDocument::MakePDF(&stream));
+    sk_sp<DummyImageFilter> filter(DummyImageFilter::Make());
+    // Only filters that can be flattened are recognized when repeated.
+    static SkOnce once;
+    once([&] {
+        SkFlattenable::Register("DummyImageFilter", filter->getFactory(),
+                                SkFlattenable::kSkImageFilter_Type);
+    });
+    SkPaint paint;
+    paint.setImageFilter(filter);
+    for (int page = 0; page < 3; ++page) {
+        SkCanvas* canvas = doc->beginPage(100.0f, 100.0f);
+        canvas->drawRect(SkRect::MakeWH(100, 100), paint);
+        doc->endPage();
+    }
+    REPORTER_ASSERT(reporter, 1 == filter->visitCount());
+
+    // Different content must be filtered again.
+    SkCanvas* canvas = doc->beginPage(100.0f, 100.0f);
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect(SkRect::MakeWH(100, 100), paint);
+    doc->close();
+    REPORTER_ASSERT(reporter, 2 == filter->visitCount());
+}
+
+// Filter results are only reused for the very same source pixels, whatever
+// the key says.
+DEF_TEST(SkPDF_FilteredImage_ComparesSource, reporter) {
+    SkBitmap source, other, result;
+    source.allocN32Pixels(16, 16);
+    source.eraseColor(SK_ColorBLUE);
+    other.allocN32Pixels(16, 16);
+    other.eraseColor(SK_ColorBLUE);
+    other.erase(SK_ColorRED, SkIRect::MakeXYWH(15, 15, 1, 1));
+    result.allocN32Pixels(16, 16);
+    result.eraseColor(SK_ColorGREEN);
+    result.setImmutable();
+    const char keyBytes[] = "colliding key";
+    sk_sp<SkData> key = SkData::MakeWithCopy(keyBytes, sizeof(keyBytes));
+
+    SkPDFCanon canon;
+    canon.addFilteredImage(key, source, result, SkIPoint::Make(1, 2));
+    SkBitmap found;
+    SkIPoint offset = SkIPoint::Make(0, 0);
+    REPORTER_ASSERT(reporter, !canon.findFilteredImage(*key, other, &found, &offset));
+    REPORTER_ASSERT(reporter, canon.findFilteredImage(*key, source, &found, &offset));
+    REPORTER_ASSERT(reporter, found.pixelRef() == result.pixelRef());
+    REPORTER_ASSERT(reporter, SkIPoint::Make(1, 2) == offset);
+
+    // The canon keeps its own copy of a source that may be drawn into again.
+    source.eraseColor(SK_ColorRED);
+    REPORTER_ASSERT(reporter, !canon.findFilteredImage(*key, source, &found, &offset));
+}
+
+static void count_pdf_functions(const SkResourceCache::Rec& rec, void* context) {
+    if (0 == strcmp(rec.getCategory(), "pdf-function")) {
+        ++*(int*)context;
+    }
+}
+
+static int pdf_function_count() {
+    int count = 0;
+    SkResourceCache::VisitAll(count_pdf_functions, &count);
+    return count;
+}
+
+static void draw_gradient_pdf(SkShader* shader) {
+    SkDynamicMemoryWStream stream;
+    sk_sp<SkDocument> doc(SkDocument::MakePDF(&stream));
+    SkPaint paint;
+    paint.setShader(sk_ref_sp(shader));
+    doc->beginPage(100.0f, 100.0f)->drawRect(SkRect::MakeWH(100, 100), paint);
+    doc->close();
+}
+
+// Check that each kind of gradient drawn with a PostScript function is
+// found in the cache when a later document draws it again.
+DEF_TEST(SkPDF_GradientFunction_Reuse, reporter) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_GradientFunction_Reuse, reporter);
+    // Colors no other test uses, so that only these gradients have these keys.
+    const SkColor colors[] = { 0xFF123456, 0xFF654321, 0xFF0F1E2D };
+    const SkPoint pts[] = { {10, 20}, {80, 70} };
+    // Repeating tiles are drawn with a PostScript function, like sweeps always are.
+    const SkShader::TileMode mode = SkShader::kRepeat_TileMode;
+    const sk_sp<SkShader> shaders[] = {
+        SkGradientShader::MakeLinear(pts, colors, nullptr, 3, mode),
+        SkGradientShader::MakeRadial(pts[0], 30, colors, nullptr, 3, mode),
+        SkGradientShader::MakeTwoPointConical(pts[0], 5, pts[1], 30, colors, nullptr, 3, mode),
+        SkGradientShader::MakeSweep(50, 50, colors, nullptr, 3),
+    };
+    for (const sk_sp<SkShader>& shader : shaders) {
+        draw_gradient_pdf(shader.get());
+        int count = pdf_function_count();
+        draw_gradient_pdf(shader.get());
+        REPORTER_ASSERT(reporter, pdf_function_count() == count);
+    }
+}
+
 // Check that PDF rendering of image filters successfully falls back to
 // CPU rasterization.
 DEF_TEST(SkPDF_FontCanEmbedTypeface, reporter) {
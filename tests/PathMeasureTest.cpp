@@ -217,3 +217,72 @@ DEF_TEST(PathMeasureConic, reporter) {
     REPORTER_ASSERT(reporter, 19.5f < stdP.fX && stdP.fX < 20.5f);
     REPORTER_ASSERT(reporter, 19.5f < hiP.fX && hiP.fX < 20.5f);
 }
+
+// Compares every query of SkPathMeasureSnapshot against SkPathMeasure.
+DEF_TEST(PathMeasureSnapshot, reporter) {
+    SkPath path;
+    path.moveTo(10, 10);
+    path.lineTo(110, 10);
+    path.quadTo(160, 60, 110, 110);
+    path.cubicTo(80, 140, 40, 80, 10, 110);
+    path.close();
+    path.moveTo(200, 200);      // zero-length contour, skipped by the snapshot
+    path.moveTo(300, 300);
+    path.conicTo(400, 300, 400, 400, 0.5f);
+    path.lineTo(300, 400);
+
+    auto near = [](const SkPoint& a, const SkPoint& b) {
+        return SkScalarNearlyEqual(a.fX, b.fX, 0.01f) && SkScalarNearlyEqual(a.fY, b.fY, 0.01f);
+    };
+
+    sk_sp<SkPathMeasureSnapshot> snapshot = SkPathMeasureSnapshot::Make(path, false);
+    REPORTER_ASSERT(reporter, 2 == snapshot->contourCount());
+
+    SkPathMeasure meas(path, false);
+    for (int contour = 0; contour < snapshot->contourCount(); ++contour) {
+        if (contour > 0) {
+            while (meas.nextContour() && 0 == meas.getLength()) {}
+        }
+        const SkScalar length = meas.getLength();
+        REPORTER_ASSERT(reporter, length == snapshot->getLength(contour));
+        REPORTER_ASSERT(reporter, meas.isClosed() == snapshot->isClosed(contour));
+
+        const int kCount = 50;
+        SkScalar distances[kCount];
+        SkPoint positions[kCount];
+        SkVector tangents[kCount];
+        for (int i = 0; i < kCount; ++i) {
+            distances[i] = (i - 2) * length / (kCount - 5);   // includes out-of-range distances
+        }
+        distances[kCount - 1] = length / 3;                    // and one going backwards
+        snapshot->getPosTan(contour, distances, kCount, positions, tangents);
+
+        for (int i = 0; i < kCount; ++i) {
+            SkPoint pos, snapPos;
+            SkVector tan, snapTan;
+            REPORTER_ASSERT(reporter, meas.getPosTan(distances[i], &pos, &tan));
+            snapshot->getPosTan(contour, distances[i], &snapPos, &snapTan);
+            REPORTER_ASSERT(reporter, near(pos, snapPos));
+            REPORTER_ASSERT(reporter, near(tan, snapTan));
+            REPORTER_ASSERT(reporter, near(pos, positions[i]));
+            REPORTER_ASSERT(reporter, near(tan, tangents[i]));
+        }
+
+        SkPath seg, snapSeg;
+        REPORTER_ASSERT(reporter, meas.getSegment(length / 5, length * 4 / 5, &seg, true));
+        REPORTER_ASSERT(reporter,
+                        snapshot->getSegment(contour, length / 5, length * 4 / 5, &snapSeg, true));
+        REPORTER_ASSERT(reporter, seg.countPoints() == snapSeg.countPoints());
+        for (int i = 0; i < seg.countPoints(); ++i) {
+            REPORTER_ASSERT(reporter, near(seg.getPoint(i), snapSeg.getPoint(i)));
+        }
+        REPORTER_ASSERT(reporter, !snapshot->getSegment(contour, 20, 10, &snapSeg, true));
+    }
+
+    // Snapshots of the same path are shared; volatile paths are not cached.
+    REPORTER_ASSERT(reporter, SkPathMeasureSnapshot::Make(path, false).get() == snapshot.get());
+    REPORTER_ASSERT(reporter, SkPathMeasureSnapshot::Make(path, true).get() != snapshot.get());
+    SkPath copy(path);
+    copy.setIsVolatile(true);
+    REPORTER_ASSERT(reporter, SkPathMeasureSnapshot::Make(copy, false).get() != snapshot.get());
+}
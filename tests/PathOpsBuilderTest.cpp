@@ -361,3 +361,48 @@ SkOpBuilder builder;
     builder.add(path1, SkPathOp::kUnion_SkPathOp);
     builder.resolve(&path);
 }
+
+static void add_batch_shapes(SkOpBuilder* builder) {
+    // Three separate clusters: overlapping circles, edge-adjacent rects, and a lone oval.
+    SkPath path;
+    path.addCircle(10, 10, 8);
+    builder->add(path, kUnion_SkPathOp);
+    path.reset();
+    path.addCircle(18, 12, 6, SkPath::kCCW_Direction);
+    builder->add(path, kUnion_SkPathOp);
+    path.reset();
+    path.addRect(40, 0, 50, 10);
+    builder->add(path, kUnion_SkPathOp);
+    path.reset();
+    path.addRect(50, 0, 60, 10, SkPath::kCCW_Direction);
+    builder->add(path, kUnion_SkPathOp);
+    path.reset();
+    path.addOval(SkRect::MakeLTRB(0, 40, 30, 55));
+    builder->add(path, kUnion_SkPathOp);
+    builder->add(SkPath(), kUnion_SkPathOp);
+}
+
+DEF_TEST(PathOpsBuilderBatch, reporter) {
+    SkOpBuilder builder;
+    SkPath expected, result;
+    add_batch_shapes(&builder);
+    REPORTER_ASSERT(reporter, builder.resolve(&expected));
+    for (bool inParallel : { false, true }) {
+        add_batch_shapes(&builder);
+        REPORTER_ASSERT(reporter, builder.resolveBatch(&result, inParallel));
+        REPORTER_ASSERT(reporter, result.getBounds() == expected.getBounds());
+        int pixelDiff = comparePaths(reporter, __FUNCTION__, expected, result);
+        REPORTER_ASSERT(reporter, pixelDiff == 0);
+    }
+
+    // Any operator other than union falls back to resolve().
+    SkPath rect;
+    rect.addRect(0, 0, 10, 10);
+    builder.add(rect, kUnion_SkPathOp);
+    rect.reset();
+    rect.addRect(5, 5, 10, 10);
+    builder.add(rect, kDifference_SkPathOp);
+    REPORTER_ASSERT(reporter, builder.resolveBatch(&result));
+    REPORTER_ASSERT(reporter, result.getBounds() == SkRect::MakeLTRB(0, 0, 10, 10));
+    REPORTER_ASSERT(reporter, !result.contains(7, 7));
+}
@@ -6,6 +6,7 @@
  */
 #include "PathOpsExtendedTest.h"
 #include "PathOpsTestCommon.h"
+#include "SkRandom.h"
 
 class PathTest_Private {
 public:
@@ -8471,3 +8472,113 @@ DEF_TEST(PathOpsRepOp, reporter) {
   for (int index = 0; index < 1; ++index)
     RunTestSet(reporter, repTests, SK_ARRAY_COUNT(repTests), nullptr, nullptr, nullptr, false);
 }
+
+bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
+             SkDEBUGPARAMS(bool skipAssert)
+             SkDEBUGPARAMS(const char* testName));
+
+bool SimplifyDebug(const SkPath& one, SkPath* result
+                   SkDEBUGPARAMS(bool skipAssert)
+                   SkDEBUGPARAMS(const char* testName));
+
+static void test_rectilinear_op(skiatest::Reporter* reporter, const SkPath& one,
+                                const SkPath& two, SkPathOp op) {
+    SkPath fast, general;
+    REPORTER_ASSERT(reporter, Op(one, two, op, &fast));
+    REPORTER_ASSERT(reporter, OpDebug(one, two, op, &general  SkDEBUGPARAMS(true)
+                                      SkDEBUGPARAMS(__FUNCTION__)));
+    REPORTER_ASSERT(reporter, fast.getFillType() == general.getFillType());
+    REPORTER_ASSERT(reporter, !comparePaths(reporter, __FUNCTION__, fast, general));
+}
+
+static void test_rectilinear_simplify(skiatest::Reporter* reporter, const SkPath& path) {
+    SkPath fast, general;
+    REPORTER_ASSERT(reporter, Simplify(path, &fast));
+    REPORTER_ASSERT(reporter, SimplifyDebug(path, &general  SkDEBUGPARAMS(true)
+                                            SkDEBUGPARAMS(__FUNCTION__)));
+    REPORTER_ASSERT(reporter, fast.getFillType() == general.getFillType());
+    REPORTER_ASSERT(reporter, !comparePaths(reporter, __FUNCTION__, fast, general));
+}
+
+// OpDebug and SimplifyDebug always run the general algorithm; the public entry points must
+// cover exactly the same pixels when they take the region based fast path instead.
+DEF_TEST(PathOpsRectilinear_debug, reporter) {
+    SkPath one, two;
+    one.moveTo(0, 0);
+    one.lineTo(6, 0);
+    one.lineTo(6, 2);
+    one.lineTo(2, 2);
+    one.lineTo(2, 6);
+    one.lineTo(0, 6);
+    one.close();
+    one.addRect(1, 1, 4, 4, SkPath::kCCW_Direction);
+    two.addRect(3, 1, 8, 5);
+    two.addRect(4, 4, 5, 8);
+    two.addRect(5, 0, 6, 2);
+    for (int fill = 0; fill < 4; ++fill) {
+        one.setFillType((SkPath::FillType) fill);
+        two.setFillType((SkPath::FillType) (fill ^ 1));
+        for (int op = 0; op <= kReverseDifference_SkPathOp; ++op) {
+            test_rectilinear_op(reporter, one, two, (SkPathOp) op);
+        }
+        test_rectilinear_simplify(reporter, one);
+    }
+
+    SkRandom rand;
+    for (int i = 0; i < 200; ++i) {
+        SkPath paths[2];
+        for (SkPath& path : paths) {
+            for (int r = 0; r < 3; ++r) {
+                int left = rand.nextULessThan(12), top = rand.nextULessThan(12);
+                path.addRect(SkIntToScalar(left), SkIntToScalar(top),
+                             SkIntToScalar(left + 1 + rand.nextULessThan(8)),
+                             SkIntToScalar(top + 1 + rand.nextULessThan(8)),
+                             rand.nextBool() ? SkPath::kCW_Direction : SkPath::kCCW_Direction);
+            }
+            path.setFillType((SkPath::FillType) rand.nextULessThan(4));
+        }
+        test_rectilinear_op(reporter, paths[0], paths[1],
+                            (SkPathOp) rand.nextULessThan(kReverseDifference_SkPathOp + 1));
+        test_rectilinear_simplify(reporter, paths[0]);
+    }
+}
+
+// Axis-aligned integer polygons take the region based fast path. Offsetting them by half a unit
+// forces the general algorithm, which must produce the same coverage.
+DEF_TEST(PathOpsRectilinear, reporter) {
+    SkPath one, two;
+    one.moveTo(0, 0);
+    one.lineTo(6, 0);
+    one.lineTo(6, 2);
+    one.lineTo(2, 2);
+    one.lineTo(2, 6);
+    one.lineTo(0, 6);
+    one.close();
+    one.addRect(1, 1, 4, 4, SkPath::kCCW_Direction);
+    two.addRect(3, 1, 8, 5);
+    two.addRect(4, 4, 5, 8);
+    two.addRect(5, 0, 6, 2);
+    for (int fill = 0; fill < 4; ++fill) {
+        one.setFillType((SkPath::FillType) fill);
+        two.setFillType((SkPath::FillType) (fill ^ 1));
+        for (int op = 0; op <= kReverseDifference_SkPathOp; ++op) {
+            SkPath fast, general, offsetOne, offsetTwo;
+            REPORTER_ASSERT(reporter, Op(one, two, (SkPathOp) op, &fast));
+            one.offset(SK_ScalarHalf, SK_ScalarHalf, &offsetOne);
+            two.offset(SK_ScalarHalf, SK_ScalarHalf, &offsetTwo);
+            REPORTER_ASSERT(reporter, Op(offsetOne, offsetTwo, (SkPathOp) op, &general));
+            general.offset(-SK_ScalarHalf, -SK_ScalarHalf);
+            REPORTER_ASSERT(reporter, fast.getFillType() == general.getFillType());
+            int pixelDiff = comparePaths(reporter, __FUNCTION__, fast, general);
+            REPORTER_ASSERT(reporter, pixelDiff == 0);
+        }
+        SkPath fast, general, offsetOne;
+        REPORTER_ASSERT(reporter, Simplify(one, &fast));
+        one.offset(SK_ScalarHalf, SK_ScalarHalf, &offsetOne);
+        REPORTER_ASSERT(reporter, Simplify(offsetOne, &general));
+        general.offset(-SK_ScalarHalf, -SK_ScalarHalf);
+        REPORTER_ASSERT(reporter, fast.getFillType() == general.getFillType());
+        int pixelDiff = comparePaths(reporter, __FUNCTION__, fast, general);
+        REPORTER_ASSERT(reporter, pixelDiff == 0);
+    }
+}
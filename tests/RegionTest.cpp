@@ -290,3 +290,51 @@ DEF_TEST(Region_writeToMemory, r) {
     REPORTER_ASSERT(r, region.isComplex());
     test_write(region, r);
 }
+
+static void rand_xor_rgn(SkRandom& rand, SkRegion* rgn, int n) {
+    rgn->setEmpty();
+    for (int i = 0; i < n; ++i) {
+        rgn->op(randRect(rand), SkRegion::kXOR_Op);
+    }
+}
+
+// setRegions() should give exactly what applying the op pairwise does.
+DEF_TEST(Region_setRegions, r) {
+    const SkRegion::Op ops[] = {
+        SkRegion::kUnion_Op, SkRegion::kIntersect_Op, SkRegion::kXOR_Op,
+    };
+    SkRandom rand;
+    for (int i = 0; i < 500; ++i) {
+        const int count = 1 + rand.nextU() % 6;
+        SkRegion regions[6];
+        const SkRegion* regionPtrs[6];
+        for (int j = 0; j < count; ++j) {
+            // A few empty and rectangular regions, mostly complex ones.
+            rand_xor_rgn(rand, &regions[j], rand.nextU() % 8);
+            regionPtrs[j] = &regions[j];
+        }
+        for (SkRegion::Op op : ops) {
+            SkRegion expected(regions[0]);
+            for (int j = 1; j < count; ++j) {
+                expected.op(regions[j], op);
+            }
+            SkRegion actual;
+            REPORTER_ASSERT(r, actual.setRegions(regionPtrs, count, op) == !expected.isEmpty());
+            REPORTER_ASSERT(r, actual == expected);
+        }
+    }
+
+    // The result may be one of the inputs.
+    SkRegion a, b;
+    rand_xor_rgn(rand, &a, 8);
+    rand_xor_rgn(rand, &b, 8);
+    SkRegion expected;
+    expected.op(a, b, SkRegion::kIntersect_Op);
+    const SkRegion* both[] = { &a, &b, &a };
+    a.setRegions(both, SK_ARRAY_COUNT(both), SkRegion::kIntersect_Op);
+    REPORTER_ASSERT(r, a == expected);
+
+    SkRegion empty;
+    REPORTER_ASSERT(r, !empty.setRegions(nullptr, 0, SkRegion::kUnion_Op));
+    REPORTER_ASSERT(r, empty.isEmpty());
+}
@@ -9,6 +9,8 @@
 #include "SkData.h"
 #include "SkDOM.h"
 #include "SkParse.h"
+#include "SkParsePath.h"
+#include "SkPath.h"
 #include "SkStream.h"
 #include "SkSVGCanvas.h"
 #include "SkXMLWriter.h"
@@ -144,3 +146,102 @@ DEF_TEST(SVGDevice_whitespace_pos, reporter) {
         test_whitespace_pos(reporter, tests[i].tst_in, tests[i].tst_out);
     }
 }
+
+DEF_TEST(SVGDevice_path_data, reporter) {
+    SkPath path;
+    path.moveTo(10.5f, -3.25f);
+    path.lineTo(1.0f / 3, 7);
+    path.lineTo(-0.004f, 1000000);
+    path.close();
+
+    SkDOM dom;
+    {
+        SkXMLParserWriter writer(dom.beginParsing());
+        std::unique_ptr<SkCanvas> svgCanvas =
+                SkSVGCanvas::Make(SkRect::MakeWH(100, 100), &writer, 2, 0);
+        svgCanvas->drawPath(path, SkPaint());
+    }
+    const SkDOM::Node* root = dom.finishParsing();
+    const SkDOM::Node* pathElem = root ? dom.getFirstChild(root, "path") : nullptr;
+    REPORTER_ASSERT(reporter, pathElem);
+    if (pathElem) {
+        const char* d = dom.findAttr(pathElem, "d");
+        REPORTER_ASSERT(reporter, d && 0 == strcmp(d, "M10.5-3.25L0.33 7L0 1000000L10.5-3.25Z"));
+    }
+}
+
+// A tiny negative coordinate is written without its sign, so it needs a separator.
+DEF_TEST(SVGDevice_path_data_tiny_negative, reporter) {
+    SkPath path;
+    path.moveTo(1, -0.00001f);
+    path.lineTo(-0.00001f, -2);
+
+    for (int precision : { 4, SkSVGCanvas::kFullPrecision }) {
+        SkDOM dom;
+        {
+            SkXMLParserWriter writer(dom.beginParsing());
+            std::unique_ptr<SkCanvas> svgCanvas =
+                    SkSVGCanvas::Make(SkRect::MakeWH(100, 100), &writer, precision, 0);
+            SkPaint paint;
+            paint.setStyle(SkPaint::kStroke_Style);
+            svgCanvas->drawPath(path, paint);
+        }
+        const SkDOM::Node* root = dom.finishParsing();
+        const SkDOM::Node* pathElem = root ? dom.getFirstChild(root, "path") : nullptr;
+        REPORTER_ASSERT(reporter, pathElem);
+        if (!pathElem) {
+            continue;
+        }
+        const char* d = dom.findAttr(pathElem, "d");
+        SkPath parsed;
+        REPORTER_ASSERT(reporter, d && SkParsePath::FromSVGString(d, &parsed));
+        REPORTER_ASSERT(reporter, 2 == parsed.countPoints());
+        if (4 == precision) {
+            REPORTER_ASSERT(reporter, d && 0 == strcmp(d, "M1 0L0-2"));
+        }
+        SkPoint pts[2];
+        parsed.getPoints(pts, 2);
+        REPORTER_ASSERT(reporter, SkScalarNearlyEqual(pts[0].fX, 1) &&
+                                  SkScalarNearlyZero(pts[0].fY) &&
+                                  SkScalarNearlyZero(pts[1].fX) &&
+                                  SkScalarNearlyEqual(pts[1].fY, -2));
+    }
+}
+
+DEF_TEST(SVGDevice_style_classes, reporter) {
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+
+    SkDOM dom;
+    {
+        SkXMLParserWriter writer(dom.beginParsing());
+        std::unique_ptr<SkCanvas> svgCanvas =
+                SkSVGCanvas::Make(SkRect::MakeWH(100, 100), &writer,
+                                  SkSVGCanvas::kFullPrecision,
+                                  SkSVGCanvas::kStyleClasses_Flag);
+        svgCanvas->drawRect(SkRect::MakeWH(10, 10), paint);
+        svgCanvas->drawRect(SkRect::MakeXYWH(20, 20, 10, 10), paint);
+    }
+    const SkDOM::Node* root = dom.finishParsing();
+    REPORTER_ASSERT(reporter, root);
+    if (!root) {
+        return;
+    }
+
+    int styleCount = 0;
+    for (const SkDOM::Node* node = dom.getFirstChild(root, "style"); node;
+         node = dom.getNextSibling(node, "style")) {
+        styleCount++;
+    }
+    REPORTER_ASSERT(reporter, 1 == styleCount);
+
+    int rectCount = 0;
+    for (const SkDOM::Node* node = dom.getFirstChild(root, "rect"); node;
+         node = dom.getNextSibling(node, "rect")) {
+        const char* styleClass = dom.findAttr(node, "class");
+        REPORTER_ASSERT(reporter, styleClass && 0 == strcmp(styleClass, "s0"));
+        REPORTER_ASSERT(reporter, !dom.findAttr(node, "fill"));
+        rectCount++;
+    }
+    REPORTER_ASSERT(reporter, 2 == rectCount);
+}
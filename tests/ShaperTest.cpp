@@ -0,0 +1,141 @@
+/*
+ * Copyright 2017 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include <hb-ot.h>
+
+#include "Resources.h"
+#include "SkData.h"
+#include "SkPaint.h"
+#include "SkShaper.h"
+#include "SkStream.h"
+#include "SkStreamPriv.h"
+#include "SkTDArray.h"
+#include "SkTextBlob.h"
+#include "SkTextBlobRunIterator.h"
+#include "SkTypeface.h"
+#include "Test.h"
+
+#include <cstring>
+
+struct ShapedText {
+    SkTDArray<uint16_t> fGlyphs;
+    SkTDArray<uint32_t> fClusters;
+    SkTDArray<SkPoint>  fPositions;
+};
+
+// Shapes all of the text at once with HarfBuzz, at the scale SkShaper shapes at, and places the
+// glyphs as SkShaper does.
+static bool shape_whole(SkTypeface* typeface, const char* text, const SkPaint& paint,
+                        SkPoint point, ShapedText* shaped) {
+    static const int kScale = 512;
+    int index;
+    std::unique_ptr<SkStreamAsset> stream(typeface->openStream(&index));
+    sk_sp<SkData> data = stream ? SkCopyStreamToData(stream.get()) : nullptr;
+    if (!data) {
+        return false;
+    }
+    hb_blob_t* blob = hb_blob_create((const char*)data->data(), SkToUInt(data->size()),
+                                     HB_MEMORY_MODE_READONLY, SkRef(data.get()),
+                                     [](void* d) { ((SkData*)d)->unref(); });
+    hb_face_t* face = hb_face_create(blob, (unsigned)index);
+    hb_face_set_upem(face, typeface->getUnitsPerEm());
+    hb_font_t* font = hb_font_create(face);
+    hb_font_set_scale(font, kScale, kScale);
+    hb_ot_font_set_funcs(font);
+
+    hb_buffer_t* buffer = hb_buffer_create();
+    hb_buffer_add_utf8(buffer, text, -1, 0, -1);
+    hb_buffer_guess_segment_properties(buffer);
+    hb_shape(font, buffer, nullptr, 0);
+    unsigned count = hb_buffer_get_length(buffer);
+    const hb_glyph_info_t* info = hb_buffer_get_glyph_infos(buffer, nullptr);
+    const hb_glyph_position_t* pos = hb_buffer_get_glyph_positions(buffer, nullptr);
+
+    double x = point.x();
+    double y = point.y();
+    double textSizeY = paint.getTextSize() / (double)kScale;
+    double textSizeX = textSizeY * paint.getTextScaleX();
+    for (unsigned i = 0; i < count; ++i) {
+        *shaped->fGlyphs.append() = SkToU16(info[i].codepoint);
+        *shaped->fClusters.append() = info[i].cluster;
+        *shaped->fPositions.append() =
+                SkPoint::Make(SkDoubleToScalar(x + pos[i].x_offset * textSizeX),
+                              SkDoubleToScalar(y - pos[i].y_offset * textSizeY));
+        x += pos[i].x_advance * textSizeX;
+        y += pos[i].y_advance * textSizeY;
+    }
+
+    hb_buffer_destroy(buffer);
+    hb_font_destroy(font);
+    hb_face_destroy(face);
+    hb_blob_destroy(blob);
+    return true;
+}
+
+static void shape(const SkShaper& shaper, const char* text, const SkPaint& paint, SkPoint point,
+                  ShapedText* shaped) {
+    SkTextBlobBuilder builder;
+    shaper.shape(&builder, paint, text, strlen(text), point);
+    sk_sp<SkTextBlob> blob = builder.make();
+    if (!blob) {
+        return;
+    }
+    for (SkTextBlobRunIterator it(blob.get()); !it.done(); it.next()) {
+        SkASSERT(SkTextBlob::kFull_Positioning == it.positioning());
+        shaped->fGlyphs.append(it.glyphCount(), it.glyphs());
+        shaped->fClusters.append(it.glyphCount(), it.clusters());
+        shaped->fPositions.append(it.glyphCount(), (const SkPoint*)it.pos());
+    }
+}
+
+template <typename T>
+static bool equal(const SkTDArray<T>& a, const SkTDArray<T>& b) {
+    return a.count() == b.count() && !memcmp(a.begin(), b.begin(), a.count() * sizeof(T));
+}
+
+// SkShaper may shape and cache text a word at a time, and its cache leaves out the text size.
+// Neither may change what the text shapes to.
+DEF_TEST(Shaper_matchesShapingAtOnce, reporter) {
+    static const char* kTexts[] = {
+        "The quick brown fox jumps over the lazy dog.",
+        "The lazy dog jumps over the quick brown fox.",
+        "  Leading,  doubled and trailing spaces  ",
+        "Office affairs: fi fl ffi AVAWAY To. \xC3\xA9t\xC3\xA9 na\xC3\xAF" "ve",
+        "\xD7\xA9\xD7\x9C\xD7\x95\xD7\x9D 123 \xD7\xA2\xD7\x95\xD7\x9C\xD7\x9D 45",
+        "",
+    };
+    // Roboto2 leaves spaces unshaped, so it is shaped a word at a time. HangingS has a 'kern'
+    // table, so it is shaped a run at a time.
+    for (const char* font : { "/fonts/Roboto2-Regular_NoEmbed.ttf", "/fonts/HangingS.ttf" }) {
+        sk_sp<SkTypeface> typeface = MakeResourceAsTypeface(font);
+        if (!typeface) {
+            INFOF(reporter, "Could not load %s, skipping.\n", font);
+            continue;
+        }
+        SkShaper shaper(typeface);
+        REPORTER_ASSERT(reporter, shaper.good());
+        // The first pass shapes every word; later ones find some or all of them cached.
+        for (int pass = 0; pass < 2; ++pass) {
+            for (SkScalar textSize : { 12.0f, 31.5f }) {
+                for (const char* text : kTexts) {
+                    SkPaint paint;
+                    paint.setTextSize(textSize);
+                    paint.setTextScaleX(textSize > 20 ? 0.75f : 1);
+                    SkPoint point = SkPoint::Make(3.5f, 20);
+
+                    ShapedText expected, actual;
+                    REPORTER_ASSERT(reporter,
+                                    shape_whole(typeface.get(), text, paint, point, &expected));
+                    shape(shaper, text, paint, point, &actual);
+                    REPORTER_ASSERT(reporter, equal(expected.fGlyphs, actual.fGlyphs));
+                    REPORTER_ASSERT(reporter, equal(expected.fClusters, actual.fClusters));
+                    REPORTER_ASSERT(reporter, equal(expected.fPositions, actual.fPositions));
+                }
+            }
+        }
+    }
+}
@@ -7,6 +7,7 @@
 
 #include "SkPaint.h"
 #include "SkPath.h"
+#include "SkRandom.h"
 #include "SkRect.h"
 #include "SkStroke.h"
 #include "SkStrokeRec.h"
@@ -160,8 +161,70 @@ static void test_strokerec_equality(skiatest::Reporter* reporter) {
     }
 }
 
+// Line-only paths are stroked a run of lines at a time. Adding a curve contour after them sends
+// them down the line-at-a-time path instead, which must produce the same outline. (The last
+// line contour is closed and not zero length, so that both paths finish it the same way.)
+static void test_strokepolyline(skiatest::Reporter* reporter) {
+    SkRandom rand;
+    for (int index = 0; index < 300; ++index) {
+        SkPath path;
+        int contours = rand.nextRangeU(1, 2);
+        for (int c = 0; c < contours; ++c) {
+            const SkPoint start = { rand.nextRangeF(0, 100), rand.nextRangeF(0, 100) };
+            SkPoint pt = start;
+            path.moveTo(pt);
+            int lines = rand.nextRangeU(0, 12);
+            for (int i = 0; i < lines; ++i) {
+                switch (rand.nextULessThan(4)) {
+                    case 0:
+                        pt.set(rand.nextRangeF(0, 100), rand.nextRangeF(0, 100));
+                        break;
+                    case 1:
+                        // teeny, near the tolerance has_valid_tangent() uses
+                        pt.offset(rand.nextSScalar1() * 0.0004f, rand.nextSScalar1() * 0.0004f);
+                        break;
+                    case 2:
+                        // back to the start, or nearly
+                        pt = start;
+                        if (rand.nextBool()) {
+                            pt.offset(0.00005f, -0.00003f);
+                        }
+                        break;
+                    default:
+                        break;
+                }
+                path.lineTo(pt);
+            }
+            if (c == contours - 1) {
+                path.lineTo(start.fX + 10, start.fY);
+                path.close();
+            } else if (rand.nextBool()) {
+                path.close();
+            }
+        }
+        SkPath curve, withCurve;
+        curve.moveTo(200, 200);
+        curve.quadTo(250, 200, 250, 250);
+        withCurve.addPath(path);
+        withCurve.addPath(curve);
+
+        SkStroke stroke;
+        stroke.setWidth(rand.nextRangeF(0.5f, 8));
+        stroke.setCap((SkPaint::Cap)rand.nextULessThan(SkPaint::kCapCount));
+        stroke.setJoin((SkPaint::Join)rand.nextULessThan(SkPaint::kJoinCount));
+        stroke.setResScale(rand.nextBool() ? 1 : 9.5f);
+        SkPath curveStroke, polylineStroke, lineStroke;
+        stroke.strokePath(curve, &curveStroke);
+        stroke.strokePath(path, &polylineStroke);
+        stroke.strokePath(withCurve, &lineStroke);
+        polylineStroke.addPath(curveStroke);
+        REPORTER_ASSERT(reporter, polylineStroke == lineStroke);
+    }
+}
+
 DEF_TEST(Stroke, reporter) {
     test_strokecubic(reporter);
     test_strokerect(reporter);
     test_strokerec_equality(reporter);
+    test_strokepolyline(reporter);
 }
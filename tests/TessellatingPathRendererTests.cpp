@@ -9,7 +9,9 @@
 
 #if SK_SUPPORT_GPU
 #include "GrContext.h"
+#include "GrTessellator.h"
 #include "GrTest.h"
+#include "SkChunkAlloc.h"
 #include "Test.h"
 #include "ops/GrTessellatingPathRenderer.h"
 
@@ -305,4 +307,40 @@ DEF_GPUTEST_FOR_ALL_CONTEXTS(TessellatingPathRendererTests, reporter, ctxInfo) {
     test_path(rtc.get(), rp, create_path_15());
     test_path(rtc.get(), rp, create_path_16());
 }
+
+// The batched and scratch-reusing entry points must produce exactly what PathToVertices() does.
+DEF_TEST(TessellatorBatch, reporter) {
+    const SkPath paths[] = {
+        create_path_0(),  create_path_1(),  create_path_2(),  create_path_3(),
+        create_path_4(),  create_path_5(),  create_path_6(),  create_path_7(),
+        create_path_8(),  create_path_9(),  create_path_10(), create_path_11(),
+        create_path_12(), create_path_13(), create_path_14(), create_path_15(),
+        create_path_16(),
+    };
+    const int pathCount = SK_ARRAY_COUNT(paths);
+    const SkRect clipBounds = SkRect::MakeWH(800, 800);
+
+    SkTDArray<GrTessellator::WindingVertex> batchVerts[pathCount];
+    GrTessellator::PathsToVertices(paths, pathCount, 0.25f, clipBounds, batchVerts);
+
+    SkChunkAlloc scratch(1024);
+    SkTDArray<GrTessellator::WindingVertex> scratchVerts;
+    for (int i = 0; i < pathCount; ++i) {
+        GrTessellator::WindingVertex* verts = nullptr;
+        int count = GrTessellator::PathToVertices(paths[i], 0.25f, clipBounds, &verts);
+        std::unique_ptr<GrTessellator::WindingVertex[]> deleteVerts(verts);
+
+        REPORTER_ASSERT(reporter, count == GrTessellator::PathToVertices(paths[i], 0.25f,
+                                                                         clipBounds, &scratch,
+                                                                         &scratchVerts));
+        REPORTER_ASSERT(reporter, count == batchVerts[i].count());
+        REPORTER_ASSERT(reporter, count == scratchVerts.count());
+        for (int j = 0; j < count && j < batchVerts[i].count(); ++j) {
+            REPORTER_ASSERT(reporter, verts[j].fPos == batchVerts[i][j].fPos);
+            REPORTER_ASSERT(reporter, verts[j].fWinding == batchVerts[i][j].fWinding);
+            REPORTER_ASSERT(reporter, verts[j].fPos == scratchVerts[j].fPos);
+            REPORTER_ASSERT(reporter, verts[j].fWinding == scratchVerts[j].fWinding);
+        }
+    }
+}
 #endif
@@ -5,10 +5,18 @@
  * found in the LICENSE file.
  */
 
+#include "Resources.h"
+#include "SkCanvas.h"
+#include "SkGlyphCache.h"
+#include "SkGraphics.h"
 #include "SkPaint.h"
 #include "SkPoint.h"
+#include "SkRandom.h"
+#include "SkReadBuffer.h"
+#include "SkSurface.h"
 #include "SkTextBlobRunIterator.h"
 #include "SkTypeface.h"
+#include "SkWriteBuffer.h"
 
 #include "Test.h"
 
@@ -386,3 +394,207 @@ DEF_TEST(TextBlob_extended, reporter) {
         REPORTER_ASSERT(reporter, 0 == strncmp(text2, it.text(), it.textSize()));
     }
 }
+
+namespace {
+struct StrikeUsage {
+    uint32_t fFontID;
+    int      fStrikes;
+    int      fGlyphs;
+    size_t   fBytes;
+};
+}  // namespace
+
+// Only the strikes of the test's own typeface are counted, so other tests sharing the global
+// font cache don't matter.
+static StrikeUsage strike_usage(const SkTypeface* typeface) {
+    StrikeUsage usage = { typeface->uniqueID(), 0, 0, 0 };
+    SkGlyphCache::VisitAll([](const SkGlyphCache& cache, void* context) {
+        StrikeUsage* usage = static_cast<StrikeUsage*>(context);
+        if (cache.getScalerContext()->getTypeface()->uniqueID() == usage->fFontID) {
+            usage->fStrikes++;
+            usage->fGlyphs += cache.countCachedGlyphs();
+            usage->fBytes += cache.getMemoryUsed();
+        }
+    }, &usage);
+    return usage;
+}
+
+// Default, subpixel horizontal and full positioning, then text too big for masks.
+static sk_sp<SkTextBlob> make_prewarm_blob(sk_sp<SkTypeface> typeface) {
+    const char text[] = "Prewarm";
+    SkPaint font;
+    font.setTypeface(std::move(typeface));
+    font.setAntiAlias(true);
+    int count = font.textToGlyphs(text, strlen(text), nullptr);
+    SkAutoTMalloc<uint16_t> glyphs(count);
+    font.textToGlyphs(text, strlen(text), glyphs.get());
+    font.setTextEncoding(SkPaint::kGlyphID_TextEncoding);
+
+    SkTextBlobBuilder builder;
+    auto run = builder.allocRun(font, count, 10, 20);
+    memcpy(run.glyphs, glyphs.get(), count * sizeof(uint16_t));
+    font.setSubpixelText(true);
+    run = builder.allocRunPosH(font, count, 40.5f);
+    memcpy(run.glyphs, glyphs.get(), count * sizeof(uint16_t));
+    for (int i = 0; i < count; ++i) {
+        run.pos[i] = 10.25f + 9.3f * i;
+    }
+    font.setTextSize(20);
+    run = builder.allocRunPos(font, count);
+    memcpy(run.glyphs, glyphs.get(), count * sizeof(uint16_t));
+    for (int i = 0; i < count; ++i) {
+        run.pos[2 * i] = 10 + 14.7f * i;
+        run.pos[2 * i + 1] = 70 + 0.5f * i;
+    }
+    // Both of these are drawn as paths from the same strike.
+    font.setTextSize(300);
+    run = builder.allocRun(font, 1, 10, 300);
+    run.glyphs[0] = glyphs[0];
+    run = builder.allocRunPosH(font, 1, 300);
+    run.glyphs[0] = glyphs[1];
+    run.pos[0] = 150;
+    return builder.make();
+}
+
+// Drawing a prewarmed blob should find every glyph it needs in the font cache.
+DEF_TEST(TextBlob_prewarm, reporter) {
+    // Typefaces of our own, so that their strikes are only ever made by this test.
+    sk_sp<SkTypeface> typeface = MakeResourceAsTypeface("/fonts/Roboto2-Regular_NoEmbed.ttf");
+    sk_sp<SkTypeface> coldTypeface =
+            MakeResourceAsTypeface("/fonts/Roboto2-Regular_NoEmbed.ttf");
+    if (!typeface || !coldTypeface) {
+        INFOF(reporter, "Could not load Roboto2-Regular_NoEmbed.ttf; skipping test\n");
+        return;
+    }
+    sk_sp<SkTextBlob> blob = make_prewarm_blob(typeface);
+    sk_sp<SkTextBlob> coldBlob = make_prewarm_blob(coldTypeface);
+
+    SkImageInfo info = SkImageInfo::MakeN32Premul(320, 320);
+    SkBitmap expected, actual;
+    expected.allocPixels(info);
+    actual.allocPixels(info);
+
+    sk_sp<SkSurface> surface(SkSurface::MakeRaster(info));
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->translate(3, 2.5f);
+    SkPaint paint;
+
+    canvas->clear(SK_ColorWHITE);
+    canvas->drawTextBlob(coldBlob, 0, 0, paint);
+    canvas->readPixels(&expected, 0, 0);
+
+    // Prewarming uses the test runner's thread pool, or runs inline if there is none.
+    const SkTextBlob* blobs[] = { blob.get() };
+    const SkPoint origins[] = { { 0, 0 } };
+    SkGraphics::PrewarmTextBlobs(canvas, blobs, origins, 1, paint);
+    StrikeUsage prewarmed = strike_usage(typeface.get());
+    REPORTER_ASSERT(reporter, prewarmed.fStrikes > 0);
+    // Every strike is made once, even when runs of different kinds share it.
+    REPORTER_ASSERT(reporter, prewarmed.fStrikes == strike_usage(coldTypeface.get()).fStrikes);
+
+    canvas->clear(SK_ColorWHITE);
+    canvas->drawTextBlob(blob, 0, 0, paint);
+    canvas->readPixels(&actual, 0, 0);
+    StrikeUsage drawn = strike_usage(typeface.get());
+    REPORTER_ASSERT(reporter, prewarmed.fStrikes == drawn.fStrikes);
+    REPORTER_ASSERT(reporter, prewarmed.fGlyphs == drawn.fGlyphs);
+    REPORTER_ASSERT(reporter, prewarmed.fBytes == drawn.fBytes);
+    REPORTER_ASSERT(reporter, !memcmp(expected.getPixels(), actual.getPixels(),
+                                      expected.getSafeSize()));
+}
+
+static sk_sp<SkTextBlob> flatten_and_read(const SkTextBlob* blob, size_t* size) {
+    SkBinaryWriteBuffer writer;
+    blob->flatten(writer);
+    *size = writer.bytesWritten();
+    SkAutoMalloc storage(*size);
+    writer.writeToMemory(storage.get());
+    SkReadBuffer reader(storage.get(), *size);
+    return SkTextBlob::MakeFromBuffer(reader);
+}
+
+static bool equal_runs(const SkTextBlob* a, const SkTextBlob* b) {
+    SkTextBlobRunIterator itA(a), itB(b);
+    for (; !itA.done() && !itB.done(); itA.next(), itB.next()) {
+        if (itA.glyphCount() != itB.glyphCount() || itA.positioning() != itB.positioning() ||
+            itA.offset() != itB.offset()) {
+            return false;
+        }
+        size_t posSize = itA.glyphCount() * sizeof(SkScalar) * (int)itA.positioning();
+        // Bitwise, so -0 and 0 are told apart.
+        if (memcmp(itA.glyphs(), itB.glyphs(), itA.glyphCount() * sizeof(uint16_t)) ||
+            memcmp(itA.pos(), itB.pos(), posSize)) {
+            return false;
+        }
+    }
+    return itA.done() && itB.done();
+}
+
+DEF_TEST(TextBlob_serializePositions, reporter) {
+    SkPaint font;
+    font.setTextEncoding(SkPaint::kGlyphID_TextEncoding);
+    const int kCount = 200;
+    SkRandom rand;
+
+    // Positions laid out on a 1/64 grid with one baseline, as shapers produce them.
+    SkTextBlobBuilder gridBuilder;
+    auto run = gridBuilder.allocRunPos(font, kCount);
+    for (int i = 0; i < kCount; ++i) {
+        run.glyphs[i] = i;
+        run.pos[2 * i] = 12.5f + i * 7.015625f;
+        run.pos[2 * i + 1] = 40.25f;
+    }
+    run = gridBuilder.allocRunPos(font, kCount);
+    for (int i = 0; i < kCount; ++i) {
+        run.glyphs[i] = i;
+        run.pos[2 * i] = -0.0f + (kCount - i) * 9;
+        run.pos[2 * i + 1] = 80 + (i % 3) * 0.25f;
+    }
+    run = gridBuilder.allocRunPosH(font, kCount, 120);
+    for (int i = 0; i < kCount; ++i) {
+        run.glyphs[i] = i;
+        run.pos[i] = i * 8.5f;
+    }
+    sk_sp<SkTextBlob> grid(gridBuilder.make());
+
+    // Positions that can't be quantized, which must still be read back as they were.
+    SkTextBlobBuilder floatBuilder;
+    run = floatBuilder.allocRunPos(font, kCount);
+    for (int i = 0; i < kCount; ++i) {
+        run.glyphs[i] = i;
+        run.pos[2 * i] = rand.nextRangeF(-1000, 1000);
+        run.pos[2 * i + 1] = rand.nextRangeF(-1000, 1000);
+    }
+    run = floatBuilder.allocRunPos(font, 2);
+    run.glyphs[0] = run.glyphs[1] = 1;
+    run.pos[0] = 0.0f;
+    run.pos[1] = -0.0f;
+    run.pos[2] = 1e30f;
+    run.pos[3] = 0.0f;
+    run = floatBuilder.allocRunPosH(font, kCount, 7.1f);
+    for (int i = 0; i < kCount; ++i) {
+        run.glyphs[i] = i;
+        run.pos[i] = i * 0.1f;
+    }
+    sk_sp<SkTextBlob> floats(floatBuilder.make());
+
+    // Glyphs and positions as the runs store them, besides run headers and the paint.
+    const size_t gridPositionsSize = 3 * kCount * sizeof(uint16_t) +
+                                     (2 * kCount + 2 * kCount + kCount) * sizeof(SkScalar);
+    size_t gridSize, floatsSize;
+    sk_sp<SkTextBlob> gridRead(flatten_and_read(grid.get(), &gridSize));
+    sk_sp<SkTextBlob> floatsRead(flatten_and_read(floats.get(), &floatsSize));
+    REPORTER_ASSERT(reporter, gridRead && equal_runs(grid.get(), gridRead.get()));
+    REPORTER_ASSERT(reporter, floatsRead && equal_runs(floats.get(), floatsRead.get()));
+    // Written as they are stored, the positions alone would take more than the whole blob.
+    REPORTER_ASSERT(reporter, gridSize < gridPositionsSize);
+
+    // A blob written with compact positions must not be read by an older picture version.
+    SkBinaryWriteBuffer writer;
+    grid->flatten(writer);
+    SkAutoMalloc storage(writer.bytesWritten());
+    writer.writeToMemory(storage.get());
+    SkReadBuffer reader(storage.get(), writer.bytesWritten());
+    reader.setVersion(SkReadBuffer::kXfermodeToBlendMode2_Version);
+    REPORTER_ASSERT(reporter, !SkTextBlob::MakeFromBuffer(reader));
+}
@@ -21,6 +21,11 @@ class SkTextBlobBuilder;
    TextBlob.
 
    If compiled without HarfBuzz, fall back on SkPaint::textToGlyphs.
+
+   With HarfBuzz, each shaper keeps the runs it has shaped most recently,
+   so text that is laid out again is not shaped again. When the font
+   doesn't shape spaces, text is shaped and kept a word at a time, so an
+   edit only reshapes the words it touched. A shaper is not thread safe.
  */
 class SkShaper {
 public:
@@ -7,13 +7,20 @@
 
 #include <hb-ot.h>
 
+#include "SkChecksum.h"
+#include "SkLRUCache.h"
 #include "SkShaper.h"
 #include "SkStream.h"
+#include "SkTArray.h"
+#include "SkTDArray.h"
 #include "SkTextBlob.h"
 #include "SkTypeface.h"
 
 static const int FONT_SIZE_SCALE = 512;
 
+// How many shaped runs each SkShaper keeps.
+static const int kMaxCachedRuns = 2048;
+
 namespace {
 struct HBFBlobDel {
     void operator()(hb_blob_t* b) { hb_blob_destroy(b); }
@@ -38,6 +45,79 @@ std::unique_ptr<hb_blob_t, HBFBlobDel> stream_to_blob(std::unique_ptr<SkStreamAs
     hb_blob_make_immutable(blob.get());
     return blob;
 }
+
+// Text shaped at FONT_SIZE_SCALE, so it can be drawn at any text size. Clusters are relative
+// to the start of the text.
+struct ShapedRun : public SkNVRefCnt<ShapedRun> {
+    SkTDArray<hb_glyph_info_t>     fInfos;
+    SkTDArray<hb_glyph_position_t> fPositions;
+};
+
+struct RunKey {
+    RunKey(const char* utf8, size_t bytes, const hb_segment_properties_t& props)
+        : fText(utf8, bytes)
+        , fDirection(props.direction)
+        , fScript(props.script)
+        , fLanguage(props.language) {}
+
+    bool operator==(const RunKey& that) const {
+        return fDirection == that.fDirection &&
+               fScript == that.fScript &&
+               fLanguage == that.fLanguage &&
+               fText.equals(that.fText);
+    }
+
+    SkString       fText;
+    hb_direction_t fDirection;
+    hb_script_t    fScript;
+    hb_language_t  fLanguage;
+};
+
+struct RunKeyHash {
+    uint32_t operator()(const RunKey& key) const {
+        return SkOpts::hash_fn(key.fText.c_str(), key.fText.size(),
+                               SkChecksum::Mix((uint32_t)key.fScript) ^ (uint32_t)key.fDirection);
+    }
+};
+
+// Returns true if the space glyph takes part in none of the font's substitutions or
+// positionings, so that text split after its spaces shapes to the same glyphs as all of it.
+bool space_is_unshaped(hb_font_t* font) {
+    hb_face_t* face = hb_font_get_face(font);
+    hb_codepoint_t space;
+    if (!hb_font_get_glyph(font, ' ', 0, &space)) {
+        return false;
+    }
+    // Legacy kerning pairs aren't exposed as lookups, so don't try to tell if they have spaces.
+    hb_blob_t* kern = hb_face_reference_table(face, HB_TAG('k','e','r','n'));
+    bool hasKern = hb_blob_get_length(kern) > 0;
+    hb_blob_destroy(kern);
+    if (hasKern) {
+        return false;
+    }
+
+    hb_set_t* glyphs = hb_set_create();
+    for (hb_tag_t table : { HB_OT_TAG_GSUB, HB_OT_TAG_GPOS }) {
+        unsigned count = hb_ot_layout_table_get_lookup_count(face, table);
+        for (unsigned i = 0; i < count; ++i) {
+            hb_ot_layout_lookup_collect_glyphs(face, table, i, glyphs, glyphs, glyphs, glyphs);
+        }
+    }
+    bool unshaped = !hb_set_has(glyphs, space);
+    hb_set_destroy(glyphs);
+    return unshaped;
+}
+
+// Returns the end of the word that starts at start: just past the next spaces that are followed
+// by an ASCII character, which can't combine with or join across them, or the end of the text.
+size_t word_end(const char* utf8text, size_t start, size_t textBytes) {
+    for (size_t i = start; i + 1 < textBytes; ++i) {
+        if (utf8text[i] == ' ' && utf8text[i + 1] != ' ' && (uint8_t)utf8text[i + 1] < 0x80) {
+            return i + 1;
+        }
+    }
+    return textBytes;
+}
 }  // namespace
 
 struct SkShaper::Impl {
@@ -50,6 +130,31 @@ struct SkShaper::Impl {
     };
     std::unique_ptr<hb_buffer_t, HBBufDel> fBuffer;
     sk_sp<SkTypeface> fTypeface;
+    // Whether text may be shaped, and cached, a word at a time.
+    bool fShapeWords = false;
+    // Runs are shaped at FONT_SIZE_SCALE with no features, so the text and its segment
+    // properties are all that set them apart.
+    SkLRUCache<RunKey, sk_sp<ShapedRun>, RunKeyHash> fRuns{kMaxCachedRuns};
+
+    sk_sp<ShapedRun> shapeRun(const char* utf8, size_t bytes,
+                              const hb_segment_properties_t& props) {
+        RunKey key(utf8, bytes, props);
+        if (sk_sp<ShapedRun>* cached = fRuns.find(key)) {
+            return *cached;
+        }
+        hb_buffer_t* buffer = fBuffer.get();
+        hb_buffer_add_utf8(buffer, utf8, SkToInt(bytes), 0, SkToInt(bytes));
+        hb_buffer_set_segment_properties(buffer, &props);
+        hb_shape(fHarfBuzzFont.get(), buffer, nullptr, 0);
+        unsigned len = hb_buffer_get_length(buffer);
+
+        sk_sp<ShapedRun> run(new ShapedRun);
+        run->fInfos.append(SkToInt(len), hb_buffer_get_glyph_infos(buffer, nullptr));
+        run->fPositions.append(SkToInt(len), hb_buffer_get_glyph_positions(buffer, nullptr));
+        hb_buffer_clear_contents(buffer);
+        fRuns.insert(key, run);
+        return run;
+    }
 };
 
 SkShaper::SkShaper(sk_sp<SkTypeface> tf) : fImpl(new Impl) {
@@ -74,6 +179,7 @@ SkShaper::SkShaper(sk_sp<SkTypeface> tf) : fImpl(new Impl) {
     SkASSERT(fImpl->fHarfBuzzFont);
     hb_font_set_scale(fImpl->fHarfBuzzFont.get(), FONT_SIZE_SCALE, FONT_SIZE_SCALE);
     hb_ot_font_set_funcs(fImpl->fHarfBuzzFont.get());
+    fImpl->fShapeWords = space_is_unshaped(fImpl->fHarfBuzzFont.get());
 
     fImpl->fBuffer.reset(hb_buffer_create());
 }
@@ -93,20 +199,32 @@ SkScalar SkShaper::shape(SkTextBlobBuilder* builder,
 
     SkASSERT(builder);
     hb_buffer_t* buffer = fImpl->fBuffer.get();
-    hb_buffer_add_utf8(buffer, utf8text, -1, 0, -1);
+    // Every word is shaped with the properties guessed for the whole text, as it would be if
+    // the text were shaped at once.
+    hb_buffer_add_utf8(buffer, utf8text, SkToInt(textBytes), 0, SkToInt(textBytes));
     hb_buffer_guess_segment_properties(buffer);
-    hb_shape(fImpl->fHarfBuzzFont.get(), buffer, nullptr, 0);
-    unsigned len = hb_buffer_get_length(buffer);
+    hb_segment_properties_t props;
+    hb_buffer_get_segment_properties(buffer, &props);
+    hb_buffer_clear_contents(buffer);
+
+    struct Piece {
+        sk_sp<ShapedRun> fRun;
+        size_t           fOffset;
+    };
+    SkSTArray<32, Piece> pieces;
+    bool byWords = fImpl->fShapeWords && HB_DIRECTION_IS_HORIZONTAL(props.direction);
+    int len = 0;
+    for (size_t start = 0; start < textBytes;) {
+        size_t end = byWords ? word_end(utf8text, start, textBytes) : textBytes;
+        pieces.push_back({ fImpl->shapeRun(utf8text + start, end - start, props), start });
+        len += pieces.back().fRun->fInfos.count();
+        start = end;
+    }
     if (len == 0) {
-        hb_buffer_clear_contents(buffer);
         return 0;
     }
 
-    hb_glyph_info_t* info = hb_buffer_get_glyph_infos(buffer, NULL);
-    hb_glyph_position_t* pos =
-            hb_buffer_get_glyph_positions(buffer, NULL);
-    auto runBuffer = builder->allocRunTextPos(
-            paint, SkToInt(len), SkToInt(textBytes), SkString());
+    auto runBuffer = builder->allocRunTextPos(paint, len, SkToInt(textBytes), SkString());
     memcpy(runBuffer.utf8text, utf8text, textBytes);
 
     double x = point.x();
@@ -115,16 +233,22 @@ SkScalar SkShaper::shape(SkTextBlobBuilder* builder,
     double textSizeY = paint.getTextSize() / (double)FONT_SIZE_SCALE;
     double textSizeX = textSizeY * paint.getTextScaleX();
 
-    for (unsigned i = 0; i < len; i++) {
-        runBuffer.glyphs[i] = info[i].codepoint;
-        runBuffer.clusters[i] = info[i].cluster;
-        reinterpret_cast<SkPoint*>(runBuffer.pos)[i] =
-                SkPoint::Make(SkDoubleToScalar(x + pos[i].x_offset * textSizeX),
-                              SkDoubleToScalar(y - pos[i].y_offset * textSizeY));
-        x += pos[i].x_advance * textSizeX;
-        y += pos[i].y_advance * textSizeY;
+    // Right-to-left words are each in visual order, but come last to first.
+    bool backward = HB_DIRECTION_IS_BACKWARD(props.direction);
+    int i = 0;
+    for (int p = 0; p < pieces.count(); ++p) {
+        const Piece& piece = pieces[backward ? pieces.count() - 1 - p : p];
+        const hb_glyph_info_t* info = piece.fRun->fInfos.begin();
+        const hb_glyph_position_t* pos = piece.fRun->fPositions.begin();
+        for (int g = 0; g < piece.fRun->fInfos.count(); ++g, ++i) {
+            runBuffer.glyphs[i] = info[g].codepoint;
+            runBuffer.clusters[i] = SkToU32(piece.fOffset + info[g].cluster);
+            reinterpret_cast<SkPoint*>(runBuffer.pos)[i] =
+                    SkPoint::Make(SkDoubleToScalar(x + pos[g].x_offset * textSizeX),
+                                  SkDoubleToScalar(y - pos[g].y_offset * textSizeY));
+            x += pos[g].x_advance * textSizeX;
+            y += pos[g].y_advance * textSizeY;
+        }
     }
-
-    hb_buffer_clear_contents(buffer);
     return (SkScalar)x;
 }